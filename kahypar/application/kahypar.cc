@@ -250,7 +250,23 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
     ("vcycles",
     po::value<int>(&config.partition.global_search_iterations)->value_name("<int>"),
     "# V-cycle iterations for direct k-way partitioning \n"
-    "(default: 0)");
+    "(default: 0)")
+    ("time-limit",
+    po::value<double>(&config.partition.time_limit)->value_name("<double>"),
+    "Time limit in seconds. Local search is scheduled such that the best partition \n"
+    "found is returned by the deadline. Coarsening and initial partitioning are not \n"
+    "bounded by the deadline, so a limit shorter than these phases is exceeded. \n"
+    "(default: 0, disabled)")
+    ("rb-threads",
+    po::value<unsigned int>(&config.partition.rb_num_threads)->value_name("<int>")->notifier(
+      [&](const unsigned int) {
+    if (config.partition.rb_num_threads == 0) {
+      config.partition.rb_num_threads = 1;
+    }
+  }),
+    "# threads for recursive bisection. With more than one thread, the two subproblems \n"
+    "of each bisection are partitioned concurrently. \n"
+    "(default: 1)");
 
   po::options_description preprocessing_options("Preprocessing Options", num_columns);
   preprocessing_options.add_options()
@@ -360,6 +376,8 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
     " - ml_style\n"
     " - heavy_full\n"
     " - heavy_lazy \n"
+    " - heavy_full_bucket\n"
+    " - heavy_lazy_bucket\n"
     "(default: ml_style)")
     ("c-s",
     po::value<double>(&config.coarsening.max_allowed_weight_multiplier)->value_name("<double>"),
@@ -369,7 +387,32 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
     ("c-t",
     po::value<HypernodeID>(&config.coarsening.contraction_limit_multiplier)->value_name("<int>"),
     "Coarsening stops when there are no more than t * k hypernodes left\n"
-    "(default: 160)");
+    "(default: 160)")
+    ("c-batch-parallel-net-detection",
+    po::value<bool>(&config.coarsening.batch_parallel_net_detection)->value_name("<bool>"),
+    "Detect parallel nets once per coarsening pass instead of after each contraction\n"
+    "(default: false)")
+    ("c-two-hop-contraction",
+    po::value<bool>(&config.coarsening.two_hop_contraction)->value_name("<bool>"),
+    "ML coarsening: If a pass does not halve the number of hypernodes, contract unmatched\n"
+    "hypernodes that share the same heaviest neighbor\n"
+    "(default: false)")
+    ("c-community-cluster-contraction",
+    po::value<bool>(&config.coarsening.community_cluster_contraction)->value_name("<bool>"),
+    "ML coarsening: If a pass does not halve the number of hypernodes, contract the unmatched\n"
+    "hypernodes of each Louvain community into as few hypernodes as the max. allowed\n"
+    "node weight permits (requires Louvain preprocessing)\n"
+    "(default: false)")
+    ("c-rating-sample-size",
+    po::value<HypernodeID>(&config.coarsening.rating_sample_size)->value_name("<int>"),
+    "Hyperedges with more pins are rated by sampling this many pins (0 = disabled)\n"
+    "(default: 0)")
+    ("c-snapshot",
+    po::value<std::string>(&config.coarsening.snapshot_filename)->value_name("<string>"),
+    "Binary file used to cache the coarsening result (direct k-way only).\n"
+    "If the file contains a snapshot for the same hypergraph and coarsening configuration,\n"
+    "coarsening is skipped. Otherwise the hypergraph is coarsened and the snapshot is written.\n"
+    "(default: none)");
 
 
   po::options_description ip_options("Initial Partitioning Options", num_columns);
@@ -410,6 +453,8 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
     " - ml_style\n"
     " - heavy_full\n"
     " - heavy_lazy \n"
+    " - heavy_full_bucket\n"
+    " - heavy_lazy_bucket\n"
     "(default: ml_style)")
     ("i-c-s",
     po::value<double>(&config.initial_partitioning.coarsening.max_allowed_weight_multiplier)->value_name("<double>"),
@@ -424,6 +469,38 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
     po::value<int>(&config.initial_partitioning.nruns)->value_name("<int>"),
     "# initial partition trials \n"
     "(default: 20)")
+    ("i-pool-threads",
+    po::value<unsigned int>(&config.initial_partitioning.pool_num_threads)->value_name("<int>")->notifier(
+      [&](const unsigned int) {
+    if (config.initial_partitioning.pool_num_threads == 0) {
+      config.initial_partitioning.pool_num_threads = 1;
+    }
+  }),
+    "# threads used to run the algorithms of the pool initial partitioner in parallel\n"
+    "(default: 1)")
+    ("i-pool-adaptive",
+    po::value<bool>(&config.initial_partitioning.pool_adaptive)->value_name("<bool>"),
+    "Pool initial partitioner: Prune badly performing algorithms after a warm-up phase\n"
+    "and spend the remaining runs on the best ones (successive halving)\n"
+    "(default: false)")
+    ("i-pool-warmup-runs",
+    po::value<int>(&config.initial_partitioning.pool_warmup_runs)->value_name("<int>"),
+    "# runs of each algorithm before the adaptive pool starts pruning\n"
+    "(default: 2)")
+    ("i-greedy-rebalancing",
+    po::value<bool>(&config.initial_partitioning.greedy_rebalancing)->value_name("<bool>"),
+    "Repair an imbalanced initial partition by greedily moving hypernodes out of overloaded\n"
+    "blocks before restarting initial partitioning with a tighter balance constraint\n"
+    "(default: false)")
+    ("i-gain-queue",
+    po::value<std::string>()->value_name("<string>")->notifier(
+      [&](const std::string& ip_gain_queue) {
+    config.initial_partitioning.gain_queue = kahypar::gainQueueTypeFromString(ip_gain_queue);
+  }),
+    "Priority queue used by the greedy hypergraph growing algorithms:\n"
+    " - heap   : binary heaps\n"
+    " - bucket : bucket queues\n"
+    "(default: heap)")
     ("i-r-type",
     po::value<std::string>()->value_name("<string>")->notifier(
       [&](const std::string& ip_rtype) {
@@ -450,6 +527,16 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
     po::value<int>(&config.initial_partitioning.local_search.fm.max_number_of_fruitless_moves)->value_name("<int>"),
     "Max. # fruitless moves before stopping local search \n"
     "(default: 50)")
+    ("i-r-fm-gain-queue",
+    po::value<std::string>()->value_name("<string>")->notifier(
+      [&](const std::string& ip_gain_queue) {
+    config.initial_partitioning.local_search.fm.gain_queue =
+      kahypar::gainQueueTypeFromString(ip_gain_queue);
+  }),
+    "Priority queue used by IP Local Search:\n"
+    " - heap   : binary heaps\n"
+    " - bucket : bucket queues\n"
+    "(default: heap)")
     ("i-r-runs",
     po::value<int>(&config.initial_partitioning.local_search.iterations_per_level)->value_name("<int>")->notifier(
       [&](const int) {
@@ -472,7 +559,9 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
     " - twoway_fm   : 2-way FM algorithm\n"
     " - kway_fm     : k-way FM algorithm (cut) \n"
     " - kway_fm_km1 : k-way FM algorithm (km1)\n"
+    " - kway_fm_km1_parallel : parallel localized k-way FM algorithm (km1)\n"
     " - sclap       : Size-constrained Label Propagation \n"
+    " - sclap_parallel : parallel synchronous Size-constrained Label Propagation \n"
     "(default: twoway_fm)")
     ("r-runs",
     po::value<int>(&config.local_search.iterations_per_level)->value_name("<int>")->notifier(
@@ -483,10 +572,33 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
   }),
     "Max. # local search repetitions on each level\n"
     "(default:1, no limit:-1)")
+    ("r-uncontraction-batch-size",
+    po::value<HypernodeID>(&config.local_search.uncontraction_batch_size)->value_name("<int>")->notifier(
+      [&](const HypernodeID) {
+    if (config.local_search.uncontraction_batch_size == 0) {
+      config.local_search.uncontraction_batch_size = 1;
+    }
+  }),
+    "# contractions that are undone before each local search round\n"
+    "(default: 1, kway_fm_km1_parallel with r-threads > 1: 16 * r-threads)")
+    ("r-threads",
+    po::value<unsigned int>(&config.local_search.num_threads)->value_name("<int>")->notifier(
+      [&](const unsigned int) {
+    if (config.local_search.num_threads == 0) {
+      config.local_search.num_threads = 1;
+    }
+  }),
+    "# threads used by parallel local search algorithms (kway_fm_km1_parallel, sclap_parallel)\n"
+    "and to initialize the gain caches of kway_fm, kway_fm_km1 and sclap\n"
+    "(default: 1)")
     ("r-sclap-runs",
     po::value<int>(&config.local_search.sclap.max_number_iterations)->value_name("<int>"),
     "Maximum # iterations for ScLaP-based refinement \n"
     "(default: -1 infinite)")
+    ("r-sclap-deterministic",
+    po::value<bool>(&config.local_search.sclap.deterministic)->value_name("<bool>"),
+    "Make sclap_parallel independent of the number of threads and their scheduling \n"
+    "(default: false)")
     ("r-fm-stop",
     po::value<std::string>()->value_name("<string>")->notifier(
       [&](const std::string& stopfm) {
@@ -516,7 +628,20 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
     }
   }),
     "Use global rebalancing PQs in twoway_fm \n"
-    "(default: false)");
+    "(default: false)")
+    ("r-fm-sparse-gain-cache-min-k",
+    po::value<PartitionID>(&config.local_search.fm.sparse_gain_cache_min_k)->value_name("<int>"),
+    "Minimum k for which kway_fm and kway_fm_km1 store gains only for adjacent blocks \n"
+    "(default: 128)")
+    ("r-fm-gain-queue",
+    po::value<std::string>()->value_name("<string>")->notifier(
+      [&](const std::string& gain_queue) {
+    config.local_search.fm.gain_queue = kahypar::gainQueueTypeFromString(gain_queue);
+  }),
+    "Priority queue used by the FM refiners:\n"
+    " - heap   : binary heaps\n"
+    " - bucket : bucket queues\n"
+    "(default: heap)");
 
   po::options_description cmd_line_options;
   cmd_line_options.add(generic_options)
@@ -555,6 +680,15 @@ void processCommandLineInput(Configuration& config, int argc, char* argv[]) {
 
   po::store(po::parse_config_file(file, ini_line_options, true), cmd_vm);
   po::notify(cmd_vm);
+
+  // Single uncontractions only restore about two hypernodes, which are refined by a
+  // single search. The parallel k-way FM refiner needs larger batches to use all threads.
+  if (config.local_search.algorithm == kahypar::RefinementAlgorithm::kway_fm_km1_parallel &&
+      config.local_search.num_threads > 1 && !cmd_vm.count("r-uncontraction-batch-size")) {
+    config.local_search.uncontraction_batch_size =
+      kahypar::KWayParallelKMinusOneRefiner<>::kMinSeedsPerSearch *
+      config.local_search.num_threads;
+  }
 }
 
 int main(int argc, char* argv[]) {
@@ -20,160 +20,290 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "kahypar/macros.h"
 #include "kahypar/meta/mandatory.h"
 
 namespace kahypar {
 namespace ds {
+/*!
+ * Stores the blocks connected by each hyperedge.
+ *
+ * Block IDs are stored with 16 bits if k <= 65536 and with sizeof(PartitionID) bytes
+ * otherwise. Each hyperedge has a 16 byte header that stores up to kInlineBytes bytes
+ * of block IDs inline, i.e., 4 blocks with 16-bit IDs. If a connectivity set outgrows
+ * its storage, it is moved to a region of twice the capacity that is allocated from a
+ * pool of chunks. Since chunks are never reallocated, growing a connectivity set does
+ * not invalidate iterators of other connectivity sets. Regions that are left behind
+ * are reused by other hyperedges that grow to the same capacity.
+ *
+ * As before, add() appends a block and remove() replaces the block by the last block
+ * of the set. Both contains() and remove() scan the set linearly.
+ */
 template <typename PartitionID = Mandatory,
           typename HyperedgeID = Mandatory>
 class ConnectivitySets final {
  private:
   using Byte = char;
 
- public:
-  // Internal structure for connectivity sets.
-  // Each contains the size of the connectivity set as  the header
-  // and afterwards the _dense and sparse arrays and the partition pin counts.
-  // This memory is allocated outside the structure using a memory arena.
-  struct ConnectivitySet {
-    const PartitionID _k;
-    PartitionID _size;
-    // After _size are the _dense and _sparse arrays.
+  static constexpr size_t kInlineBytes = 8;
+  static constexpr size_t kChunkBytes = 1 << 20;
 
-    explicit ConnectivitySet(const PartitionID k) :
-      _k(k),
-      _size(0) {
-      for (PartitionID i = 0; i < 2 * _k; ++i) {
-        new(&_size + i + 1)PartitionID(std::numeric_limits<PartitionID>::max());
-      }
-    }
+  struct Header {
+    PartitionID size;
+    PartitionID capacity;
+    union {
+      Byte inline_blocks[kInlineBytes];
+      Byte* blocks;
+    };
+  };
 
-    ConnectivitySet(const ConnectivitySet&) = delete;
-    ConnectivitySet& operator= (const ConnectivitySet&) = delete;
+ public:
+  class ConnectivitySet {
+ public:
+    class Iterator {
+ public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = PartitionID;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const PartitionID*;
+      using reference = PartitionID;
+
+      Iterator(const Byte* pos, const size_t width) :
+        _pos(pos),
+        _width(width) { }
+
+      PartitionID operator* () const {
+        return load(_pos, _width);
+      }
 
-    ConnectivitySet(ConnectivitySet&& other) = delete;
-    ConnectivitySet& operator= (ConnectivitySet&&) = delete;
+      Iterator& operator++ () {
+        _pos += _width;
+        return *this;
+      }
 
-    PartitionID* dense() {
-      return &_size + 1;
-    }
+      Iterator operator++ (int) {
+        Iterator copy = *this;
+        ++(*this);
+        return copy;
+      }
 
-    PartitionID* sparse() {
-      return &_size + 1 + _k;
-    }
+      bool operator== (const Iterator& other) const {
+        return _pos == other._pos;
+      }
 
-    const PartitionID* begin()  const {
-      return &_size + 1;
-    }
+      bool operator!= (const Iterator& other) const {
+        return _pos != other._pos;
+      }
 
-    const PartitionID* end() const {
-      return &_size + 1 + _size;
-    }
+ private:
+      const Byte* _pos;
+      size_t _width;
+    };
 
-    bool contains(const PartitionID value) const {
-      const PartitionID index = sparse()[value];
-      return index < _size && dense()[index] == value;
-    }
+    ConnectivitySet(const Byte* blocks, const PartitionID size, const size_t width) :
+      _blocks(blocks),
+      _size(size),
+      _width(width) { }
 
-    void add(const PartitionID value) {
-      ASSERT((sparse()[value] >= _size || dense()[sparse()[value]] != value), V(value));
-      sparse()[value] = _size;
-      dense()[_size++] = value;
+    Iterator begin() const {
+      return Iterator(_blocks, _width);
     }
 
-    void remove(const PartitionID value) {
-      const PartitionID index = sparse()[value];
-      ASSERT(index < _size && dense()[index] == value, V(value));
-      const PartitionID e = dense()[--_size];
-      dense()[index] = e;
-      sparse()[e] = index;
+    Iterator end() const {
+      return Iterator(_blocks + _size * _width, _width);
     }
 
-    void clear() {
-      _size = 0;
+    bool contains(const PartitionID value) const {
+      return std::find(begin(), end(), value) != end();
     }
 
     PartitionID size() const {
       return _size;
     }
-  };
 
+ private:
+    const Byte* _blocks;
+    PartitionID _size;
+    size_t _width;
+  };
 
   explicit ConnectivitySets(const HyperedgeID num_hyperedges, const PartitionID k) :
-    _k(k),
-    _connectivity_sets(nullptr) {
-    initialize(num_hyperedges, _k);
+    ConnectivitySets() {
+    initialize(num_hyperedges, k);
   }
 
   ConnectivitySets() :
     _k(0),
-    _connectivity_sets(nullptr) { }
+    _width(0),
+    _inline_capacity(0),
+    _headers(),
+    _chunks(),
+    _chunk_pos(nullptr),
+    _chunk_end(nullptr),
+    _pool_bytes(0),
+    _free_regions() { }
+
+  ConnectivitySets(const ConnectivitySets&) = delete;
+  ConnectivitySets& operator= (const ConnectivitySets&) = delete;
 
+  ConnectivitySets(ConnectivitySets&&) = default;
+  ConnectivitySets& operator= (ConnectivitySets&&) = default;
 
-  ~ConnectivitySets() {
-    // Since ConnectivitySet only contains PartitionIDs and these are PODs,
-    // we do not need to call destructors of ConnectivitySet get(i)->~ConnectivitySet();
-    static_assert(std::is_pod<PartitionID>::value, "PartitionID is not a POD");
-    free(_connectivity_sets);
+  void initialize(const HyperedgeID num_hyperedges, const PartitionID k) {
+    _k = k;
+    _width = k - 1 <= std::numeric_limits<uint16_t>::max() ?
+             sizeof(uint16_t) : sizeof(PartitionID);
+    _inline_capacity = kInlineBytes / _width;
+    Header header;
+    header.size = 0;
+    header.capacity = _inline_capacity;
+    header.blocks = nullptr;
+    _headers.assign(num_hyperedges, header);
+    _chunks.clear();
+    _chunk_pos = nullptr;
+    _chunk_end = nullptr;
+    _pool_bytes = 0;
+    _free_regions.clear();
   }
 
-  ConnectivitySets(const ConnectivitySets&) = delete;
-  ConnectivitySets& operator= (const ConnectivitySets&) = delete;
+  ConnectivitySet operator[] (const HyperedgeID he) const {
+    return ConnectivitySet(blocks(_headers[he]), _headers[he].size, _width);
+  }
 
-  ConnectivitySets(ConnectivitySets&& other) :
-    _k(other._k),
-    _connectivity_sets(other._connectivity_sets) {
-    other._k = 0;
-    other._connectivity_sets = nullptr;
+  bool contains(const HyperedgeID he, const PartitionID value) const {
+    return operator[] (he).contains(value);
   }
 
-  ConnectivitySets& operator= (ConnectivitySets&& other) {
-    _k = other._k;
-    _connectivity_sets = other._connectivity_sets;
-    other._k = 0;
-    other._connectivity_sets = nullptr;
-    return *this;
-  };
+  void add(const HyperedgeID he, const PartitionID value) {
+    ASSERT(value < _k && !contains(he, value), V(he) << V(value));
+    Header& header = _headers[he];
+    if (header.size == header.capacity) {
+      grow(header);
+    }
+    store(blocks(header) + header.size * _width, _width, value);
+    ++header.size;
+  }
 
-  void initialize(const HyperedgeID num_hyperedges, const PartitionID k) {
-    _k = k;
-    _connectivity_sets = static_cast<Byte*>(malloc(num_hyperedges * sizeOfConnectivitySet()));
-    for (HyperedgeID i = 0; i < num_hyperedges; ++i) {
-      new(get(i))ConnectivitySet(_k);
+  void remove(const HyperedgeID he, const PartitionID value) {
+    Header& header = _headers[he];
+    Byte* begin = blocks(header);
+    Byte* pos = begin;
+    while (load(pos, _width) != value) {
+      pos += _width;
+      ASSERT(pos < begin + header.size * _width, V(he) << V(value));
     }
+    --header.size;
+    std::memmove(pos, begin + header.size * _width, _width);
   }
 
+  void clear(const HyperedgeID he) {
+    _headers[he].size = 0;
+  }
 
-  const ConnectivitySet& operator[] (const HyperedgeID he) const {
-    return *get(he);
+  //! Exchanges the connectivity sets of hyperedges he and other.
+  void swap(const HyperedgeID he, const HyperedgeID other) {
+    std::swap(_headers[he], _headers[other]);
   }
 
-  // To avoid code duplication we implement non-const version in terms of const version
-  ConnectivitySet& operator[] (const HyperedgeID he) {
-    return const_cast<ConnectivitySet&>(static_cast<const ConnectivitySets&>(*this).operator[] (he));
+  size_t sizeInBytes() const {
+    return _headers.size() * sizeof(Header) + _pool_bytes;
   }
 
  private:
-  const ConnectivitySet* get(const HyperedgeID he) const {
-    return reinterpret_cast<ConnectivitySet*>(_connectivity_sets + he * sizeOfConnectivitySet());
+  static PartitionID load(const Byte* pos, const size_t width) {
+    if (width == sizeof(uint16_t)) {
+      uint16_t value;
+      std::memcpy(&value, pos, sizeof(uint16_t));
+      return value;
+    }
+    PartitionID value;
+    std::memcpy(&value, pos, sizeof(PartitionID));
+    return value;
   }
 
-  // To avoid code duplication we implement non-const version in terms of const version
-  ConnectivitySet* get(const HyperedgeID he) {
-    return const_cast<ConnectivitySet*>(static_cast<const ConnectivitySets&>(*this).get(he));
+  static void store(Byte* pos, const size_t width, const PartitionID value) {
+    if (width == sizeof(uint16_t)) {
+      const uint16_t narrow_value = static_cast<uint16_t>(value);
+      std::memcpy(pos, &narrow_value, sizeof(uint16_t));
+    } else {
+      std::memcpy(pos, &value, sizeof(PartitionID));
+    }
+  }
+
+  const Byte* blocks(const Header& header) const {
+    return header.capacity > _inline_capacity ? header.blocks : header.inline_blocks;
+  }
+
+  Byte* blocks(Header& header) {
+    return header.capacity > _inline_capacity ? header.blocks : header.inline_blocks;
+  }
+
+  void grow(Header& header) {
+    ASSERT(header.capacity < _k, V(header.capacity));
+    const PartitionID capacity = std::min(_k, 2 * header.capacity);
+    Byte* region = allocate(capacity);
+    std::memcpy(region, blocks(header), header.size * _width);
+    if (header.capacity > _inline_capacity) {
+      _free_regions[freeListIndex(header.capacity)].push_back(header.blocks);
+    }
+    header.blocks = region;
+    header.capacity = capacity;
   }
 
-  constexpr size_t sizeOfConnectivitySet() const {
-    return (sizeof(ConnectivitySet) + 2 * _k * sizeof(PartitionID));
+  Byte* allocate(const PartitionID capacity) {
+    const size_t index = freeListIndex(capacity);
+    if (index < _free_regions.size() && !_free_regions[index].empty()) {
+      Byte* region = _free_regions[index].back();
+      _free_regions[index].pop_back();
+      return region;
+    }
+    if (index >= _free_regions.size()) {
+      _free_regions.resize(index + 1);
+    }
+    const size_t bytes = capacity * _width;
+    if (_chunk_pos == nullptr || static_cast<size_t>(_chunk_end - _chunk_pos) < bytes) {
+      // Small hypergraphs (e.g. during initial partitioning) get small chunks.
+      const size_t headers_bytes = _headers.size() * kInlineBytes;
+      const size_t default_bytes = headers_bytes < kChunkBytes ? headers_bytes : kChunkBytes;
+      const size_t chunk_bytes = bytes > default_bytes ? bytes : default_bytes;
+      _chunks.emplace_back(new Byte[chunk_bytes]);
+      _chunk_pos = _chunks.back().get();
+      _chunk_end = _chunk_pos + chunk_bytes;
+      _pool_bytes += chunk_bytes;
+    }
+    Byte* region = _chunk_pos;
+    _chunk_pos += bytes;
+    return region;
+  }
+
+  // Capacities are powers of two times the inline capacity, except for k.
+  // Thus, ceil(log2(capacity)) identifies the capacity.
+  static size_t freeListIndex(const PartitionID capacity) {
+    size_t index = 0;
+    while ((static_cast<PartitionID>(1) << index) < capacity) {
+      ++index;
+    }
+    return index;
   }
 
   PartitionID _k;
-  Byte* _connectivity_sets;
+  size_t _width;
+  PartitionID _inline_capacity;
+  std::vector<Header> _headers;
+  std::vector<std::unique_ptr<Byte[]> > _chunks;
+  Byte* _chunk_pos;
+  Byte* _chunk_end;
+  size_t _pool_bytes;
+  std::vector<std::vector<Byte*> > _free_regions;
 };
 }  // namespace ds
 }  // namespace kahypar
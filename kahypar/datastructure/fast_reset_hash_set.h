@@ -0,0 +1,156 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest_prod.h"
+
+#include "kahypar/macros.h"
+
+namespace kahypar {
+namespace ds {
+// Open addressing hash set with linear probing that can be cleared in constant time.
+// A slot is occupied iff its timestamp equals the current timestamp. In contrast to
+// FastResetFlagArray, the memory consumption is proportional to the maximum number of
+// elements that were contained in the set at the same time and not to the size of the
+// key universe. The set doubles its capacity whenever it becomes half full.
+template <typename Key = std::uint64_t, typename Timestamp = std::uint32_t>
+class FastResetHashSet {
+  static constexpr size_t kMinCapacity = 16;
+
+  struct Slot {
+    Key key;
+    Timestamp timestamp;
+  };
+
+ public:
+  explicit FastResetHashSet(const size_t initial_capacity = kMinCapacity) :
+    _slots(),
+    _timestamp(1),
+    _size(0),
+    _shift(0) {
+    size_t capacity = kMinCapacity;
+    while (capacity < initial_capacity) {
+      capacity *= 2;
+    }
+    allocate(capacity);
+  }
+
+  FastResetHashSet(const FastResetHashSet&) = delete;
+  FastResetHashSet& operator= (const FastResetHashSet&) = delete;
+
+  FastResetHashSet(FastResetHashSet&&) = default;
+  FastResetHashSet& operator= (FastResetHashSet&&) = default;
+
+  size_t size() const {
+    return _size;
+  }
+
+  size_t capacity() const {
+    return _slots.size();
+  }
+
+  bool contains(const Key key) const {
+    for (size_t pos = position(key); ; pos = (pos + 1) & (_slots.size() - 1)) {
+      if (_slots[pos].timestamp != _timestamp) {
+        return false;
+      }
+      if (_slots[pos].key == key) {
+        return true;
+      }
+    }
+  }
+
+  void add(const Key key) {
+    if (insert(key) && 2 * _size > _slots.size()) {
+      grow();
+    }
+  }
+
+  void clear() {
+    _size = 0;
+    ++_timestamp;
+    if (_timestamp == std::numeric_limits<Timestamp>::max()) {
+      for (Slot& slot : _slots) {
+        slot.timestamp = 0;
+      }
+      _timestamp = 1;
+    }
+  }
+
+ private:
+  FRIEND_TEST(AFastResetHashSet, HandlesTimestampOverflow);
+
+  // Fibonacci hashing: the upper bits of the product are well distributed even if the
+  // keys only differ in their lower bits.
+  size_t position(const Key key) const {
+    return (static_cast<std::uint64_t>(key) * UINT64_C(11400714819323198485)) >> _shift;
+  }
+
+  // Returns true if the key was not contained in the set.
+  bool insert(const Key key) {
+    for (size_t pos = position(key); ; pos = (pos + 1) & (_slots.size() - 1)) {
+      if (_slots[pos].timestamp != _timestamp) {
+        _slots[pos].key = key;
+        _slots[pos].timestamp = _timestamp;
+        ++_size;
+        return true;
+      }
+      if (_slots[pos].key == key) {
+        return false;
+      }
+    }
+  }
+
+  void grow() {
+    std::vector<Slot> old_slots;
+    old_slots.swap(_slots);
+    const Timestamp old_timestamp = _timestamp;
+    allocate(2 * old_slots.size());
+    _timestamp = 1;
+    _size = 0;
+    for (const Slot& slot : old_slots) {
+      if (slot.timestamp == old_timestamp) {
+        insert(slot.key);
+      }
+    }
+  }
+
+  void allocate(const size_t capacity) {
+    ASSERT((capacity & (capacity - 1)) == 0, V(capacity));
+    _slots.assign(capacity, Slot { Key(), 0 });
+    _shift = 64;
+    for (size_t i = capacity; i > 1; i /= 2) {
+      --_shift;
+    }
+  }
+
+  std::vector<Slot> _slots;
+  Timestamp _timestamp;
+  size_t _size;
+  size_t _shift;
+};
+}  // namespace ds
+}  // namespace kahypar
@@ -36,6 +36,8 @@
 
 #include "kahypar/datastructure/connectivity_sets.h"
 #include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/pin_counts_in_part.h"
+#include "kahypar/datastructure/sparse_set.h"
 #include "kahypar/definitions.h"
 #include "kahypar/macros.h"
 #include "kahypar/meta/empty.h"
@@ -43,6 +45,7 @@
 #include "kahypar/meta/mandatory.h"
 #include "kahypar/partition/configuration_enum_classes.h"
 #include "kahypar/utils/math.h"
+#include "kahypar/utils/serialization.h"
 
 namespace kahypar {
 namespace ds {
@@ -475,6 +478,15 @@ class GenericHypergraph {
     }
   };
 
+  /*!
+   * A PartitionSnapshot stores the block IDs of all hypernodes and the
+   * PartInfo of all blocks. See GenericHypergraph::createPartitionSnapshot.
+   */
+  struct PartitionSnapshot {
+    std::vector<PartitionID> part_ids;
+    std::vector<PartInfo> part_info;
+  };
+
   //! The data type used to store indices into HyperedgeVector
   using HyperedgeIndexVector = std::vector<size_t>;
   //! The data type used to store the pins of all nets
@@ -532,8 +544,9 @@ class GenericHypergraph {
     _hyperedges(_num_hyperedges, Hyperedge(0, 0, 1)),
     _incidence_array(2 * _num_pins, 0),
     _part_info(_k),
-    _pins_in_part(_num_hyperedges * k),
+    _pins_in_part(),
     _connectivity_sets(_num_hyperedges, k),
+    _border_nodes(_num_hypernodes),
     _hes_not_containing_u(_num_hyperedges) {
     VertexID edge_vector_index = 0;
     for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
@@ -546,6 +559,9 @@ class GenericHypergraph {
         ++edge_vector_index;
       }
     }
+    _pins_in_part.initialize(_num_hyperedges, _k, [&](const HyperedgeID he) {
+        return hyperedge(he).size();
+      });
 
     hypernode(0).setFirstEntry(_num_pins);
     for (HypernodeID i = 0; i < _num_hypernodes - 1; ++i) {
@@ -608,6 +624,7 @@ class GenericHypergraph {
     _part_info(_k),
     _pins_in_part(),
     _connectivity_sets(),
+    _border_nodes(0),
     _hes_not_containing_u() { }
 
   GenericHypergraph(GenericHypergraph&&) = default;
@@ -770,8 +787,20 @@ class GenericHypergraph {
                                             _num_hyperedges, _num_hyperedges));
   }
 
-  //! Returns a reference to the connectivity set of hyperedge he.
-  const typename ConnectivitySets<PartitionID, HyperedgeID>::ConnectivitySet &
+  /*!
+   * Returns the set of all border nodes, i.e. of all hypernodes that are incident to
+   * at least one cut hyperedge. The set is maintained by the same operations that
+   * maintain isBorderNode and is therefore only valid if isBorderNode is valid
+   * (i.e. after initializeNumCutHyperedges()). The order of the nodes is arbitrary
+   * and changes whenever a hypernode becomes a border node or an internal node.
+   */
+  const SparseSet<HypernodeID>& borderNodes() const {
+    return _border_nodes;
+  }
+
+  //! Returns a view of the connectivity set of hyperedge he, which is invalidated if
+  //! blocks are added to or removed from it.
+  typename ConnectivitySets<PartitionID, HyperedgeID>::ConnectivitySet
   connectivitySet(const HyperedgeID he) const {
     ASSERT(!hyperedge(he).isDisabled(), "Hyperedge " << he << " is disabled");
     return _connectivity_sets[he];
@@ -922,8 +951,8 @@ class GenericHypergraph {
           resetReusedPinSlotToOriginalValue(he, memento);
 
           if (connectivity(he) > 1) {
-            --hypernode(memento.u).num_incident_cut_hes;    // because u is not connected to that cut HE anymore
-            ++hypernode(memento.v).num_incident_cut_hes;    // because v is connected to that cut HE
+            decrementNumIncidentCutHEs(memento.u);    // because u is not connected to that cut HE anymore
+            incrementNumIncidentCutHEs(memento.v);    // because v is connected to that cut HE
             // because after uncontraction, u is not connected to that HE anymore
             changes_u -= pinCountInPart(he, partID(memento.u)) == 1 ? edgeWeight(he) : 0;
           } else {
@@ -963,7 +992,7 @@ class GenericHypergraph {
                << "(while uncontracting: (" << memento.u << "," << memento.v << "))");
 
         if (connectivity(he) > 1) {
-          ++hypernode(memento.v).num_incident_cut_hes;     // because v is connected to that cut HE
+          incrementNumIncidentCutHEs(memento.v);     // because v is connected to that cut HE
         }
 
         // Either the HE could have been removed from the cut before the move, or the HE
@@ -1029,8 +1058,8 @@ class GenericHypergraph {
           resetReusedPinSlotToOriginalValue(he, memento);
 
           if (connectivity(he) > 1) {
-            --hypernode(memento.u).num_incident_cut_hes;    // because u is not connected to that cut HE anymore
-            ++hypernode(memento.v).num_incident_cut_hes;    // because v is connected to that cut HE
+            decrementNumIncidentCutHEs(memento.u);    // because u is not connected to that cut HE anymore
+            incrementNumIncidentCutHEs(memento.v);    // because v is connected to that cut HE
           }
           // The state of this hyperedge now resembles the state before contraction.
           // Thus we don't need to process them any further.
@@ -1064,7 +1093,7 @@ class GenericHypergraph {
                << "(while uncontracting: (" << memento.u << "," << memento.v << "))");
 
         if (connectivity(he) > 1) {
-          ++hypernode(memento.v).num_incident_cut_hes;     // because v is connected to that cut HE
+          incrementNumIncidentCutHEs(memento.v);     // because v is connected to that cut HE
         }
 
         ++_current_num_pins;
@@ -1116,8 +1145,7 @@ class GenericHypergraph {
       if ((no_pins_left_in_source_part && !only_one_pin_in_to_part)) {
         if (pinCountInPart(he, to) == edgeSize(he)) {
           for (const HypernodeID pin : pins(he)) {
-            --hypernode(pin).num_incident_cut_hes;
-            if (hypernode(pin).num_incident_cut_hes == 0) {
+            if (decrementNumIncidentCutHEs(pin)) {
               // ASSERT(std::find(non_border_hns_to_remove.cbegin(),
               //                  non_border_hns_to_remove.cend(), pin) ==
               //        non_border_hns_to_remove.end(),
@@ -1129,7 +1157,7 @@ class GenericHypergraph {
       } else if (!no_pins_left_in_source_part && only_one_pin_in_to_part) {
         if (pinCountInPart(he, from) == edgeSize(he) - 1) {
           for (const HypernodeID pin : pins(he)) {
-            ++hypernode(pin).num_incident_cut_hes;
+            incrementNumIncidentCutHEs(pin);
           }
         }
       }
@@ -1166,6 +1194,7 @@ class GenericHypergraph {
     ASSERT(!hypernode(hn).isDisabled(), "Hypernode " << hn << " is disabled");
     ASSERT(hypernode(hn).num_incident_cut_hes == numIncidentCutHEs(hn), V(hn));
     ASSERT((hypernode(hn).num_incident_cut_hes > 0) == isBorderNodeInternal(hn), V(hn));
+    ASSERT((hypernode(hn).num_incident_cut_hes > 0) == _border_nodes.contains(hn), V(hn));
     return hypernode(hn).num_incident_cut_hes > 0;
   }
 
@@ -1339,7 +1368,7 @@ class GenericHypergraph {
       }
 
       if (connectivity(old_representative) > 1) {
-        ++hypernode(pin).num_incident_cut_hes;
+        incrementNumIncidentCutHEs(pin);
       }
 
       ASSERT(_incidence_array[hypernode(pin).firstInvalidEntry() - 1] == he,
@@ -1354,14 +1383,59 @@ class GenericHypergraph {
       hypernode(i).part_id = kInvalidPartition;
     }
     std::fill(_part_info.begin(), _part_info.end(), PartInfo());
-    std::fill(_pins_in_part.begin(), _pins_in_part.end(), 0);
     for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
       hyperedge(i).connectivity = 0;
-      _connectivity_sets[i].clear();
+      _connectivity_sets.clear(i);
+      _pins_in_part.reset(i);
     }
     for (HypernodeID i = 0; i < _num_hypernodes; ++i) {
       hypernode(i).num_incident_cut_hes = 0;
     }
+    _border_nodes.clear();
+  }
+
+  //! Stores the current partition in snapshot (reusing its memory).
+  void createPartitionSnapshot(PartitionSnapshot& snapshot) const {
+    snapshot.part_ids.resize(_num_hypernodes);
+    for (HypernodeID i = 0; i < _num_hypernodes; ++i) {
+      snapshot.part_ids[i] = _hypernodes[i].part_id;
+    }
+    snapshot.part_info = _part_info;
+  }
+
+  /*!
+   * Restores a partition stored via createPartitionSnapshot.
+   *
+   * This is equivalent to resetPartitioning() followed by a setNodePart call
+   * for each hypernode, but instead of updating the pin counts, the connectivity
+   * and the connectivity sets once per pin and block, all pin counts are rebuilt
+   * in a single pass over the pins of all hyperedges.
+   * As after setNodePart, initializeNumCutHyperedges() has to be called to provide
+   * correct border-node checks.
+   */
+  void restorePartitionSnapshot(const PartitionSnapshot& snapshot) {
+    ASSERT(snapshot.part_ids.size() == _num_hypernodes, V(snapshot.part_ids.size()));
+    ASSERT(snapshot.part_info.size() == _part_info.size(), V(snapshot.part_info.size()));
+    for (HypernodeID i = 0; i < _num_hypernodes; ++i) {
+      _hypernodes[i].part_id = snapshot.part_ids[i];
+      _hypernodes[i].num_incident_cut_hes = 0;
+    }
+    _border_nodes.clear();
+    _part_info = snapshot.part_info;
+    for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
+      hyperedge(i).connectivity = 0;
+      _connectivity_sets.clear(i);
+      _pins_in_part.reset(i);
+    }
+    for (const HyperedgeID he : edges()) {
+      for (const HypernodeID pin : pins(he)) {
+        const PartitionID part = partID(pin);
+        if (part != kInvalidPartition && _pins_in_part.increment(he, part) == 1) {
+          hyperedge(he).connectivity += 1;
+          _connectivity_sets.add(he, part);
+        }
+      }
+    }
   }
 
   Type type() const {
@@ -1586,10 +1660,11 @@ class GenericHypergraph {
     for (HypernodeID hn = 0; hn < _num_hypernodes; ++hn) {
       _hypernodes[hn].num_incident_cut_hes = 0;
     }
+    _border_nodes.clear();
     for (const HyperedgeID he : edges()) {
       if (connectivity(he) > 1) {
         for (const HypernodeID pin : pins(he)) {
-          ++hypernode(pin).num_incident_cut_hes;
+          incrementNumIncidentCutHEs(pin);
         }
       }
     }
@@ -1608,8 +1683,8 @@ class GenericHypergraph {
   HypernodeID pinCountInPart(const HyperedgeID he, const PartitionID id) const {
     ASSERT(!hyperedge(he).isDisabled(), "Hyperedge " << he << " is disabled");
     ASSERT(id < _k && id != kInvalidPartition, "Partition ID " << id << " is out of bounds");
-    ASSERT(_pins_in_part[he * _k + id] != kInvalidCount, V(he) << V(id));
-    return _pins_in_part[he * _k + id];
+    ASSERT(_pins_in_part.isValid(he, id), V(he) << V(id));
+    return _pins_in_part.get(he, id);
   }
 
   //! Returns the number of blocks a hyperedge connects
@@ -1698,6 +1773,25 @@ class GenericHypergraph {
     return num_cut_hes;
   }
 
+  //! Increments the number of incident cut hyperedges of hn and adds it to the border nodes.
+  void incrementNumIncidentCutHEs(const HypernodeID hn) {
+    if (hypernode(hn).num_incident_cut_hes++ == 0) {
+      _border_nodes.add(hn);
+    }
+  }
+
+  /*!
+   * Decrements the number of incident cut hyperedges of hn. Returns true and removes
+   * hn from the border nodes if hn became an internal node.
+   */
+  bool decrementNumIncidentCutHEs(const HypernodeID hn) {
+    if (--hypernode(hn).num_incident_cut_hes == 0) {
+      _border_nodes.remove(hn);
+      return true;
+    }
+    return false;
+  }
+
   //! Assigns a previously unassigned hypernode to  a block.
   void updatePartInfo(const HypernodeID u, const PartitionID id) {
     ASSERT(!hypernode(u).isDisabled(), "Hypernode " << u << " is disabled");
@@ -1727,12 +1821,9 @@ class GenericHypergraph {
     ASSERT(pinCountInPart(he, id) > 0,
            "HE " << he << "does not have any pins in partition " << id);
     ASSERT(id < _k && id != kInvalidPartition, "Part ID" << id << " out of bounds!");
-    ASSERT(_pins_in_part[he * _k + id] > 0, "invalid decrease");
-    const size_t offset = he * _k + id;
-    _pins_in_part[offset] -= 1;
-    const bool connectivity_decreased = _pins_in_part[offset] == 0;
+    const bool connectivity_decreased = _pins_in_part.decrement(he, id) == 0;
     if (connectivity_decreased) {
-      _connectivity_sets[he].remove(id);
+      _connectivity_sets.remove(he, id);
       hyperedge(he).connectivity -= 1;
     }
     return connectivity_decreased;
@@ -1745,12 +1836,10 @@ class GenericHypergraph {
            "HE " << he << ": pin_count[" << id << "]=" << pinCountInPart(he, id)
            << "edgesize=" << edgeSize(he));
     ASSERT(id < _k && id != kInvalidPartition, "Part ID" << id << " out of bounds!");
-    const size_t offset = he * _k + id;
-    _pins_in_part[offset] += 1;
-    const bool connectivity_increased = _pins_in_part[offset] == 1;
+    const bool connectivity_increased = _pins_in_part.increment(he, id) == 1;
     if (connectivity_increased) {
       hyperedge(he).connectivity += 1;
-      _connectivity_sets[he].add(id);
+      _connectivity_sets.add(he, id);
     }
     return connectivity_increased;
   }
@@ -1759,19 +1848,15 @@ class GenericHypergraph {
   void invalidatePartitionPinCounts(const HyperedgeID he) {
     ASSERT(hyperedge(he).isDisabled(),
            "Invalidation of pin counts only allowed for disabled hyperedges");
-    for (PartitionID part = 0; part < _k; ++part) {
-      _pins_in_part[he * _k + part] = kInvalidCount;
-    }
+    _pins_in_part.invalidate(he);
     hyperedge(he).connectivity = 0;
-    _connectivity_sets[he].clear();
+    _connectivity_sets.clear(he);
   }
 
   //! Resets the number of pins in each block to zero.
   void resetPartitionPinCounts(const HyperedgeID he) {
     ASSERT(!hyperedge(he).isDisabled(), "Hyperedge " << he << " is disabled");
-    for (PartitionID part = 0; part < _k; ++part) {
-      _pins_in_part[he * _k + part] = 0;
-    }
+    _pins_in_part.reset(he);
   }
 
   void enableEdge(const HyperedgeID e) {
@@ -1959,9 +2044,11 @@ class GenericHypergraph {
   //! Weight and size information for all blocks.
   std::vector<PartInfo> _part_info;
   //! For each hyperedge and each block, _pins_in_part stores the number of pins in that block
-  std::vector<HypernodeID> _pins_in_part;
+  PinCountsInPart<HypernodeID, HyperedgeID, PartitionID> _pins_in_part;
   //! For each hyperedge, _connectivity_sets stores the blocks the hyperedge connects
   ConnectivitySets<PartitionID, HyperedgeID> _connectivity_sets;
+  //! Contains exactly the hypernodes hn with num_incident_cut_hes > 0
+  SparseSet<HypernodeID> _border_nodes;
 
   /*!
    * Used during uncontraction to decide how to perform the uncontraction operation.
@@ -1989,6 +2076,15 @@ class GenericHypergraph {
   template <typename Hypergraph>
   friend std::pair<std::unique_ptr<Hypergraph>,
                    std::vector<typename Hypergraph::HypernodeID> > reindex(const Hypergraph& hypergraph);
+
+  template <typename Hypergraph>
+  friend class CompactHypergraphView;
+
+  template <typename Hypergraph>
+  friend void writeContractionState(const Hypergraph& hypergraph, std::ostream& out);
+
+  template <typename Hypergraph>
+  friend bool readContractionState(Hypergraph& hypergraph, std::istream& in);
 };
 
 template <typename Hypergraph>
@@ -2079,11 +2175,15 @@ reindex(const Hypergraph& hypergraph) {
   using HypernodeID = typename Hypergraph::HypernodeID;
   using HyperedgeID = typename Hypergraph::HyperedgeID;
 
-  std::unordered_map<HypernodeID, HypernodeID> original_to_reindexed;
+  std::vector<HypernodeID> original_to_reindexed(hypergraph.initialNumNodes());
   std::vector<HypernodeID> reindexed_to_original;
+  reindexed_to_original.reserve(hypergraph.currentNumNodes());
+  std::vector<HyperedgeID> original_to_reindexed_edge(hypergraph.initialNumEdges());
   std::unique_ptr<Hypergraph> reindexed_hypergraph(new Hypergraph());
 
   reindexed_hypergraph->_k = hypergraph._k;
+  reindexed_hypergraph->_hyperedges.reserve(hypergraph.currentNumEdges());
+  reindexed_hypergraph->_incidence_array.reserve(2 * hypergraph.currentNumPins());
 
   HypernodeID num_hypernodes = 0;
   for (const HypernodeID hn : hypergraph.nodes()) {
@@ -2098,6 +2198,7 @@ reindex(const Hypergraph& hypergraph) {
   HyperedgeID num_hyperedges = 0;
   HypernodeID pin_index = 0;
   for (const HyperedgeID he : hypergraph.edges()) {
+    original_to_reindexed_edge[he] = num_hyperedges;
     reindexed_hypergraph->_hyperedges.emplace_back(0, 0, hypergraph.edgeWeight(he));
     ++reindexed_hypergraph->_num_hyperedges;
     reindexed_hypergraph->_hyperedges[num_hyperedges].setFirstEntry(pin_index);
@@ -2118,11 +2219,17 @@ reindex(const Hypergraph& hypergraph) {
   reindexed_hypergraph->_current_num_pins = num_pins;
   reindexed_hypergraph->_type = hypergraph.type();
 
-  reindexed_hypergraph->_incidence_array.resize(hypergraph._k * num_pins);
-  reindexed_hypergraph->_pins_in_part.resize(num_hyperedges * hypergraph._k);
+  // Like in the constructor, the second half of the incidence array stores
+  // the incident hyperedges of the hypernodes.
+  reindexed_hypergraph->_incidence_array.resize(2 * num_pins);
+  reindexed_hypergraph->_pins_in_part.initialize(num_hyperedges, hypergraph._k,
+                                                 [&](const HyperedgeID he) {
+        return reindexed_hypergraph->edgeSize(he);
+      });
   reindexed_hypergraph->_hes_not_containing_u.setSize(num_hyperedges);
 
   reindexed_hypergraph->_connectivity_sets.initialize(num_hyperedges, hypergraph._k);
+  reindexed_hypergraph->_border_nodes = SparseSet<HypernodeID>(num_hypernodes);
 
   reindexed_hypergraph->hypernode(0).setFirstEntry(num_pins);
   for (HypernodeID i = 0; i < num_hypernodes - 1; ++i) {
@@ -2138,11 +2245,13 @@ reindex(const Hypergraph& hypergraph) {
   reindexed_hypergraph->_total_weight +=
     reindexed_hypergraph->hypernode(num_hypernodes - 1).weight();
 
-  for (const HyperedgeID he : reindexed_hypergraph->edges()) {
-    for (const HypernodeID pin : reindexed_hypergraph->pins(he)) {
+  // The incident hyperedges of each hypernode keep their order. Thus, the copy
+  // behaves exactly like a CompactHypergraphView of the hypergraph.
+  for (const HypernodeID hn : reindexed_hypergraph->nodes()) {
+    for (const HyperedgeID he : hypergraph.incidentEdges(reindexed_to_original[hn])) {
       reindexed_hypergraph->_incidence_array[
-        reindexed_hypergraph->hypernode(pin).firstInvalidEntry()] = he;
-      reindexed_hypergraph->hypernode(pin).incrementSize();
+        reindexed_hypergraph->hypernode(hn).firstInvalidEntry()] = original_to_reindexed_edge[he];
+      reindexed_hypergraph->hypernode(hn).incrementSize();
     }
   }
 
@@ -2151,6 +2260,155 @@ reindex(const Hypergraph& hypergraph) {
   return std::make_pair(std::move(reindexed_hypergraph), reindexed_to_original);
 }
 
+/*!
+ * In-place alternative to reindex().
+ *
+ * The constructor renumbers the hypernodes and hyperedges of the (unpartitioned)
+ * hypergraph such that the enabled ones get the IDs [0, currentNumNodes()) and
+ * [0, currentNumEdges()) in the order of their original IDs, and hides the disabled
+ * ones. Afterwards, the hypergraph behaves like the copy created by reindex(), but
+ * all of its arrays are reused. The destructor restores the original IDs and keeps
+ * the part IDs, pin counts and connectivity sets. As after setNodePart,
+ * initializeNumCutHyperedges() has to be called afterwards. The hypergraph must
+ * not be contracted or uncontracted while it is compacted.
+ */
+template <typename Hypergraph>
+class CompactHypergraphView {
+ private:
+  using HypernodeID = typename Hypergraph::HypernodeID;
+  using HyperedgeID = typename Hypergraph::HyperedgeID;
+
+ public:
+  explicit CompactHypergraphView(Hypergraph& hypergraph) :
+    _hg(hypergraph),
+    _num_hypernodes(hypergraph._num_hypernodes),
+    _num_hyperedges(hypergraph._num_hyperedges),
+    _num_pins(hypergraph._num_pins),
+    _original_hypernodes(),
+    _original_hyperedges() {
+    ASSERT([&]() {
+        for (const HypernodeID hn : _hg.nodes()) {
+          if (_hg.partID(hn) != Hypergraph::kInvalidPartition) {
+            return false;
+          }
+        }
+        return true;
+      } (), "Only unpartitioned hypergraphs can be compacted");
+    _original_hypernodes.reserve(_hg._current_num_hypernodes);
+    _original_hyperedges.reserve(_hg._current_num_hyperedges);
+
+    // Each enabled element is swapped with the element at the next free ID, which
+    // is disabled (or the element itself). Thus, the enabled elements keep their order.
+    std::vector<HypernodeID> compacted_hypernodes(_num_hypernodes);
+    for (HypernodeID hn = 0; hn < _num_hypernodes; ++hn) {
+      if (!_hg._hypernodes[hn].isDisabled()) {
+        compacted_hypernodes[hn] = _original_hypernodes.size();
+        swapHypernodes(hn, _original_hypernodes.size());
+        _original_hypernodes.push_back(hn);
+      }
+    }
+    std::vector<HyperedgeID> compacted_hyperedges(_num_hyperedges);
+    for (HyperedgeID he = 0; he < _num_hyperedges; ++he) {
+      if (!_hg._hyperedges[he].isDisabled()) {
+        compacted_hyperedges[he] = _original_hyperedges.size();
+        swapHyperedges(he, _original_hyperedges.size());
+        _original_hyperedges.push_back(he);
+      }
+    }
+    ASSERT(_original_hypernodes.size() == _hg._current_num_hypernodes, V(_num_hypernodes));
+    ASSERT(_original_hyperedges.size() == _hg._current_num_hyperedges, V(_num_hyperedges));
+
+    renumber(compacted_hypernodes, compacted_hyperedges);
+    _hg._num_hypernodes = _original_hypernodes.size();
+    _hg._num_hyperedges = _original_hyperedges.size();
+    _hg._num_pins = _hg._current_num_pins;
+  }
+
+  ~CompactHypergraphView() {
+    for (HypernodeID hn = 0; hn < _original_hypernodes.size(); ++hn) {
+      _hg._hypernodes[hn].num_incident_cut_hes = 0;
+    }
+    _hg._border_nodes.clear();
+
+    renumber(_original_hypernodes, _original_hyperedges);
+    // Undo the swaps of the constructor in reverse order.
+    for (HyperedgeID he = _original_hyperedges.size(); he-- > 0; ) {
+      swapHyperedges(he, _original_hyperedges[he]);
+    }
+    for (HypernodeID hn = _original_hypernodes.size(); hn-- > 0; ) {
+      swapHypernodes(hn, _original_hypernodes[hn]);
+    }
+    _hg._num_hypernodes = _num_hypernodes;
+    _hg._num_hyperedges = _num_hyperedges;
+    _hg._num_pins = _num_pins;
+  }
+
+  CompactHypergraphView(const CompactHypergraphView&) = delete;
+  CompactHypergraphView& operator= (const CompactHypergraphView&) = delete;
+
+  CompactHypergraphView(CompactHypergraphView&&) = delete;
+  CompactHypergraphView& operator= (CompactHypergraphView&&) = delete;
+
+  Hypergraph& hypergraph() {
+    return _hg;
+  }
+
+  //! Original ID of the compacted hypernode hn
+  HypernodeID originalID(const HypernodeID hn) const {
+    ASSERT(hn < _original_hypernodes.size(), V(hn));
+    return _original_hypernodes[hn];
+  }
+
+ private:
+  void swapHypernodes(const HypernodeID hn, const HypernodeID other) {
+    if (hn != other) {
+      std::swap(_hg._hypernodes[hn], _hg._hypernodes[other]);
+    }
+  }
+
+  void swapHyperedges(const HyperedgeID he, const HyperedgeID other) {
+    if (he != other) {
+      std::swap(_hg._hyperedges[he], _hg._hyperedges[other]);
+      _hg._pins_in_part.swap(he, other);
+      _hg._connectivity_sets.swap(he, other);
+    }
+  }
+
+  // Replaces the pins of the enabled hyperedges and the incident hyperedges of the
+  // enabled hypernodes by their new IDs. All other entries of the incidence array are
+  // only accessed by (un)contractions and restores of removed hyperedges and therefore
+  // keep their original IDs. The hash of a hyperedge is updated by the difference
+  // between the hashes of the new and the old IDs of its pins.
+  void renumber(const std::vector<HypernodeID>& hypernodes,
+                const std::vector<HyperedgeID>& hyperedges) {
+    auto& incidence_array = _hg._incidence_array;
+    for (HyperedgeID he = 0; he < _original_hyperedges.size(); ++he) {
+      auto& hyperedge = _hg._hyperedges[he];
+      for (auto pin = incidence_array.begin() + hyperedge.firstEntry();
+           pin != incidence_array.begin() + hyperedge.firstInvalidEntry(); ++pin) {
+        hyperedge.hash += math::hash(hypernodes[*pin]);
+        hyperedge.hash -= math::hash(static_cast<HypernodeID>(*pin));
+        *pin = hypernodes[*pin];
+      }
+    }
+    for (HypernodeID hn = 0; hn < _original_hypernodes.size(); ++hn) {
+      const auto& hypernode = _hg._hypernodes[hn];
+      for (auto he = incidence_array.begin() + hypernode.firstEntry();
+           he != incidence_array.begin() + hypernode.firstInvalidEntry(); ++he) {
+        *he = hyperedges[*he];
+      }
+    }
+  }
+
+  Hypergraph& _hg;
+  const HypernodeID _num_hypernodes;
+  const HyperedgeID _num_hyperedges;
+  const HypernodeID _num_pins;
+  //! Original IDs of the enabled hypernodes and hyperedges
+  std::vector<HypernodeID> _original_hypernodes;
+  std::vector<HyperedgeID> _original_hyperedges;
+};
+
 template <typename Hypergraph>
 std::pair<std::unique_ptr<Hypergraph>,
           std::vector<typename Hypergraph::HypernodeID> >
@@ -2242,10 +2500,13 @@ extractPartAsUnpartitionedHypergraphForBisection(const Hypergraph& hypergraph,
     subhypergraph->_type = hypergraph.type();
 
     subhypergraph->_incidence_array.resize(2 * num_pins);
-    subhypergraph->_pins_in_part.resize(num_hyperedges * 2);
+    subhypergraph->_pins_in_part.initialize(num_hyperedges, 2, [&](const HyperedgeID he) {
+        return subhypergraph->edgeSize(he);
+      });
     subhypergraph->_hes_not_containing_u.setSize(num_hyperedges);
 
     subhypergraph->_connectivity_sets.initialize(num_hyperedges, 2);
+    subhypergraph->_border_nodes = SparseSet<HypernodeID>(num_hypernodes);
 
     subhypergraph->hypernode(0).setFirstEntry(num_pins);
     for (HypernodeID i = 0; i < num_hypernodes - 1; ++i) {
@@ -2269,5 +2530,49 @@ extractPartAsUnpartitionedHypergraphForBisection(const Hypergraph& hypergraph,
   return std::make_pair(std::move(subhypergraph),
                         subhypergraph_to_hypergraph);
 }
+
+/*!
+ * Writes the current (contracted) state of an unpartitioned hypergraph to out.
+ * Only the information that changes during coarsening is stored. Therefore the state
+ * can only be restored into a hypergraph that was built from the same input.
+ */
+template <typename Hypergraph>
+void writeContractionState(const Hypergraph& hypergraph, std::ostream& out) {
+  ASSERT([&]() {
+      for (const auto& hn : hypergraph.nodes()) {
+        if (hypergraph.partID(hn) != Hypergraph::kInvalidPartition) {
+          return false;
+        }
+      }
+      return true;
+    } (), "Contraction state can only be written for unpartitioned hypergraphs");
+  serialization::write(out, hypergraph._current_num_hypernodes);
+  serialization::write(out, hypergraph._current_num_hyperedges);
+  serialization::write(out, hypergraph._current_num_pins);
+  serialization::write(out, hypergraph._threshold_active);
+  serialization::write(out, hypergraph._threshold_marked);
+  serialization::writeVector(out, hypergraph._hypernodes);
+  serialization::writeVector(out, hypergraph._hyperedges);
+  serialization::writeVector(out, hypergraph._incidence_array);
+}
+
+/*!
+ * Restores a state written by writeContractionState. Returns false if the state
+ * does not fit the hypergraph. In this case the hypergraph has to be considered invalid.
+ */
+template <typename Hypergraph>
+bool readContractionState(Hypergraph& hypergraph, std::istream& in) {
+  return serialization::read(in, hypergraph._current_num_hypernodes) &&
+         serialization::read(in, hypergraph._current_num_hyperedges) &&
+         serialization::read(in, hypergraph._current_num_pins) &&
+         serialization::read(in, hypergraph._threshold_active) &&
+         serialization::read(in, hypergraph._threshold_marked) &&
+         serialization::readVector(in, hypergraph._hypernodes, hypergraph._hypernodes.size()) &&
+         serialization::readVector(in, hypergraph._hyperedges, hypergraph._hyperedges.size()) &&
+         // The incidence array grows during contraction, if the incident nets of
+         // the representative have to be moved to the end of the array.
+         serialization::readVector(in, hypergraph._incidence_array) &&
+         hypergraph._incidence_array.size() >= 2 * static_cast<size_t>(hypergraph._num_pins);
+}
 }  // namespace ds
 }  // namespace kahypar
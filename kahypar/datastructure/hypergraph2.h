@@ -712,8 +712,9 @@ class GenericHypergraph2 {
                                             _num_hyperedges, _num_hyperedges));
   }
 
-  //! Returns a reference to the connectivity set of hyperedge he.
-  const typename ConnectivitySets<PartitionID, HyperedgeID>::ConnectivitySet &
+  //! Returns a view of the connectivity set of hyperedge he, which is invalidated if
+  //! blocks are added to or removed from it.
+  typename ConnectivitySets<PartitionID, HyperedgeID>::ConnectivitySet
   connectivitySet(const HyperedgeID he) const {
     ASSERT(!hyperedge(he).isDisabled(), "Hyperedge " << he << " is disabled");
     return _connectivity_sets[he];
@@ -1213,7 +1214,7 @@ class GenericHypergraph2 {
     std::fill(_pins_in_part.begin(), _pins_in_part.end(), 0);
     for (HyperedgeID i = 0; i < _num_hyperedges; ++i) {
       hyperedge(i).connectivity = 0;
-      _connectivity_sets[i].clear();
+      _connectivity_sets.clear(i);
     }
     for (HypernodeID i = 0; i < _num_hypernodes; ++i) {
       hypernode(i).num_incident_cut_hes = 0;
@@ -1588,7 +1589,7 @@ class GenericHypergraph2 {
     _pins_in_part[offset] -= 1;
     const bool connectivity_decreased = _pins_in_part[offset] == 0;
     if (connectivity_decreased) {
-      _connectivity_sets[he].remove(id);
+      _connectivity_sets.remove(he, id);
       hyperedge(he).connectivity -= 1;
     }
     return connectivity_decreased;
@@ -1606,7 +1607,7 @@ class GenericHypergraph2 {
     const bool connectivity_increased = _pins_in_part[offset] == 1;
     if (connectivity_increased) {
       hyperedge(he).connectivity += 1;
-      _connectivity_sets[he].add(id);
+      _connectivity_sets.add(he, id);
     }
     return connectivity_increased;
   }
@@ -1619,7 +1620,7 @@ class GenericHypergraph2 {
       _pins_in_part[he * _k + part] = kInvalidCount;
     }
     hyperedge(he).connectivity = 0;
-    _connectivity_sets[he].clear();
+    _connectivity_sets.clear(he);
   }
 
   //! Resets the number of pins in each block to zero.
@@ -103,6 +103,13 @@ class KWayPriorityQueue {
     return _num_nonempty_pqs;
   }
 
+  // A part is unused if its internal heap is empty and therefore not part of the
+  // non-empty heaps.
+  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool isUnused(const PartitionID part) const {
+    ASSERT((_mapping[part].index != kInvalidIndex ? _mapping[_mapping[part].index].part != kInvalidPart : true), V(part));
+    return _mapping[part].index == kInvalidIndex;
+  }
+
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool isEnabled(const PartitionID part) const {
     ASSERT(static_cast<unsigned int>(part) < _queues.size(), "Invalid " << V(part));
     return _mapping[part].index < _num_enabled_pqs;
@@ -285,12 +292,6 @@ class KWayPriorityQueue {
   }
 
  private:
-  FRIEND_TEST(AKWayPriorityQueue, DisablesInternalHeapIfItBecomesEmptyDueToRemoval);
-  FRIEND_TEST(AKWayPriorityQueue, ChoosesMaxKeyAmongAllEnabledInternalHeaps);
-  FRIEND_TEST(AKWayPriorityQueue, DoesNotConsiderDisabledHeapForChoosingMax);
-  FRIEND_TEST(AKWayPriorityQueue, ReconsidersDisabledHeapAgainAfterEnabling);
-  FRIEND_TEST(AKWayPriorityQueue, PQIsUnusedAndDisableIfItBecomesEmptyAfterDeleteMaxFromPartition);
-
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void swap(const size_t index_a, const size_t index_b) {
     using std::swap;
     swap(_queues[index_a], _queues[index_b]);
@@ -331,11 +332,6 @@ class KWayPriorityQueue {
     return _ties[Randomize::instance().getRandomInt(0, _ties.size() - 1)];
   }
 
-  KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool isUnused(const PartitionID part) const {
-    ASSERT((_mapping[part].index != kInvalidIndex ? _mapping[_mapping[part].index].part != kInvalidPart : true), V(part));
-    return _mapping[part].index == kInvalidIndex;
-  }
-
   KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void markUnused(const PartitionID part) {
     _mapping[_mapping[part].index].part = kInvalidPart;
     _mapping[part].index = kInvalidIndex;
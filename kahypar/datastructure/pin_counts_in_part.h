@@ -0,0 +1,328 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+
+namespace kahypar {
+namespace ds {
+/*!
+ * Stores the number of pins of each hyperedge in each block.
+ *
+ * By default, each hyperedge and block has one HypernodeID counter. For
+ * k >= kCompactLayoutMinK, where this dense layout needs the most memory, each
+ * hyperedge instead uses counters of 1, 2 or sizeof(HypernodeID) bytes, depending
+ * on the maximum size it can reach. The largest value of each width is reserved to
+ * mark invalidated counters. If all hyperedges use the same width or if storing the
+ * offset and width of each hyperedge would cost more than it saves, all counters
+ * have the same width and are addressed directly. Otherwise, offset and width of
+ * each hyperedge are packed into one 64-bit word. The compact layout saves 70-75%
+ * of the memory, but each access has to determine the width of the counter.
+ */
+template <typename HypernodeID = Mandatory,
+          typename HyperedgeID = Mandatory,
+          typename PartitionID = Mandatory>
+class PinCountsInPart final {
+ private:
+  using Byte = uint8_t;
+  using Width = uint8_t;
+  using Layout = uint64_t;
+
+  static constexpr Layout kWidthBits = 8;
+
+ public:
+  static constexpr HypernodeID kInvalidCount = std::numeric_limits<HypernodeID>::max();
+  // Minimum number of blocks for which initialize() chooses the compact layout.
+  static constexpr PartitionID kCompactLayoutMinK = 128;
+
+  PinCountsInPart() :
+    _num_hyperedges(0),
+    _k(0),
+    _compact(false),
+    _width(0),
+    _layout(),
+    _counts(),
+    _dense_counts() { }
+
+  PinCountsInPart(const PinCountsInPart&) = delete;
+  PinCountsInPart& operator= (const PinCountsInPart&) = delete;
+
+  PinCountsInPart(PinCountsInPart&&) = default;
+  PinCountsInPart& operator= (PinCountsInPart&&) = default;
+
+  /*!
+   * Allocates zero-initialized counters for num_hyperedges hyperedges and k blocks.
+   * max_size(he) has to be an upper bound for the size of hyperedge he.
+   */
+  template <typename MaxSize>
+  void initialize(const HyperedgeID num_hyperedges, const PartitionID k,
+                  const MaxSize& max_size) {
+    initialize(num_hyperedges, k, max_size, k >= kCompactLayoutMinK);
+  }
+
+  template <typename MaxSize>
+  void initialize(const HyperedgeID num_hyperedges, const PartitionID k,
+                  const MaxSize& max_size, const bool compact) {
+    _num_hyperedges = num_hyperedges;
+    _k = k;
+    _compact = compact;
+    if (!compact) {
+      _width = 0;
+      _layout.clear();
+      _counts.clear();
+      _dense_counts.assign(static_cast<size_t>(num_hyperedges) * k, 0);
+      return;
+    }
+    _dense_counts.clear();
+    _dense_counts.shrink_to_fit();
+    _layout.resize(num_hyperedges);
+    Width max_width = 1;
+    bool uniform = true;
+    size_t offset = 0;
+    for (HyperedgeID he = 0; he < num_hyperedges; ++he) {
+      const Width width = widthFor(max_size(he));
+      uniform &= he == 0 || width == max_width;
+      max_width = std::max(max_width, width);
+      _layout[he] = (static_cast<Layout>(offset) << kWidthBits) | width;
+      offset += static_cast<size_t>(k) * width;
+    }
+
+    const size_t uniform_size = static_cast<size_t>(num_hyperedges) * k * max_width;
+    if (uniform || uniform_size <= offset + _layout.size() * sizeof(Layout)) {
+      _width = max_width;
+      _layout.clear();
+      _layout.shrink_to_fit();
+      _counts.assign(uniform_size, 0);
+    } else {
+      _width = 0;
+      _counts.assign(offset, 0);
+    }
+  }
+
+  HypernodeID get(const HyperedgeID he, const PartitionID part) const {
+    ASSERT(he < _num_hyperedges && part < _k, V(he) << V(part));
+    if (!_compact) {
+      return _dense_counts[static_cast<size_t>(he) * _k + part];
+    }
+    const Width width = widthOf(he);
+    return load(_counts.data() + offsetOf(he, width) + static_cast<size_t>(part) * width, width);
+  }
+
+  //! Returns kInvalidCount for invalidated counters.
+  HypernodeID value(const HyperedgeID he, const PartitionID part) const {
+    return isValid(he, part) ? get(he, part) : kInvalidCount;
+  }
+
+  bool isValid(const HyperedgeID he, const PartitionID part) const {
+    return get(he, part) != (_compact ? maxValue(widthOf(he)) : kInvalidCount);
+  }
+
+  //! Increments the counter and returns its new value.
+  HypernodeID increment(const HyperedgeID he, const PartitionID part) {
+    ASSERT(he < _num_hyperedges && part < _k, V(he) << V(part));
+    if (!_compact) {
+      return ++_dense_counts[static_cast<size_t>(he) * _k + part];
+    }
+    const Width width = widthOf(he);
+    Byte* counter = _counts.data() + offsetOf(he, width) + static_cast<size_t>(part) * width;
+    const HypernodeID count = load(counter, width) + 1;
+    ASSERT(count < maxValue(width), "Pin count overflow:" << V(he) << V(part));
+    store(counter, width, count);
+    return count;
+  }
+
+  //! Decrements the counter and returns its new value.
+  HypernodeID decrement(const HyperedgeID he, const PartitionID part) {
+    ASSERT(he < _num_hyperedges && part < _k, V(he) << V(part));
+    if (!_compact) {
+      ASSERT(_dense_counts[static_cast<size_t>(he) * _k + part] > 0 &&
+             _dense_counts[static_cast<size_t>(he) * _k + part] != kInvalidCount,
+             V(he) << V(part));
+      return --_dense_counts[static_cast<size_t>(he) * _k + part];
+    }
+    const Width width = widthOf(he);
+    Byte* counter = _counts.data() + offsetOf(he, width) + static_cast<size_t>(part) * width;
+    const HypernodeID count = load(counter, width);
+    ASSERT(count > 0 && count != maxValue(width), V(he) << V(part) << V(count));
+    store(counter, width, count - 1);
+    return count - 1;
+  }
+
+  void reset(const HyperedgeID he) {
+    if (!_compact) {
+      fillDense(he, 0);
+      return;
+    }
+    fill(he, 0);
+  }
+
+  void invalidate(const HyperedgeID he) {
+    if (!_compact) {
+      fillDense(he, kInvalidCount);
+      return;
+    }
+    // All bits set is the largest value of each width.
+    fill(he, std::numeric_limits<Byte>::max());
+  }
+
+  //! Exchanges the counters of hyperedges he and other.
+  void swap(const HyperedgeID he, const HyperedgeID other) {
+    ASSERT(he < _num_hyperedges && other < _num_hyperedges, V(he) << V(other));
+    if (!_compact) {
+      const auto begin = _dense_counts.begin() + static_cast<size_t>(he) * _k;
+      std::swap_ranges(begin, begin + _k, _dense_counts.begin() + static_cast<size_t>(other) * _k);
+    } else if (_width == 0) {
+      // Each hyperedge keeps its counters, only their offsets and widths are exchanged.
+      std::swap(_layout[he], _layout[other]);
+    } else {
+      const auto begin = _counts.begin() + offsetOf(he, _width);
+      std::swap_ranges(begin, begin + static_cast<size_t>(_k) * _width,
+                       _counts.begin() + offsetOf(other, _width));
+    }
+  }
+
+  void reset() {
+    std::fill(_counts.begin(), _counts.end(), 0);
+    std::fill(_dense_counts.begin(), _dense_counts.end(), 0);
+  }
+
+  bool isCompact() const {
+    return _compact;
+  }
+
+  //! Number of counters, i.e., number of hyperedges times k.
+  size_t size() const {
+    return static_cast<size_t>(_num_hyperedges) * _k;
+  }
+
+  size_t sizeInBytes() const {
+    return _counts.size() * sizeof(Byte) + _layout.size() * sizeof(Layout) +
+           _dense_counts.size() * sizeof(HypernodeID);
+  }
+
+  bool operator== (const PinCountsInPart& other) const {
+    if (_num_hyperedges != other._num_hyperedges || _k != other._k) {
+      return false;
+    }
+    for (HyperedgeID he = 0; he < _num_hyperedges; ++he) {
+      for (PartitionID part = 0; part < _k; ++part) {
+        if (value(he, part) != other.value(he, part)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+ private:
+  // Counters have to represent edge sizes up to max_size + 1, because pin counts
+  // are incremented before the edge size during uncontraction.
+  static Width widthFor(const HypernodeID max_size) {
+    if (max_size + 2 < std::numeric_limits<uint8_t>::max()) {
+      return sizeof(uint8_t);
+    } else if (sizeof(HypernodeID) > sizeof(uint16_t) &&
+               max_size + 2 < std::numeric_limits<uint16_t>::max()) {
+      return sizeof(uint16_t);
+    }
+    return sizeof(HypernodeID);
+  }
+
+  static HypernodeID maxValue(const Width width) {
+    return width == sizeof(HypernodeID) ?
+           std::numeric_limits<HypernodeID>::max() :
+           (static_cast<HypernodeID>(1) << (8 * width)) - 1;
+  }
+
+  static HypernodeID load(const Byte* counter, const Width width) {
+    switch (width) {
+      case sizeof(uint8_t):
+        return *counter;
+      case sizeof(uint16_t): {
+          uint16_t count;
+          std::memcpy(&count, counter, sizeof(uint16_t));
+          return count;
+        }
+      default: {
+          HypernodeID count;
+          std::memcpy(&count, counter, sizeof(HypernodeID));
+          return count;
+        }
+    }
+  }
+
+  static void store(Byte* counter, const Width width, const HypernodeID count) {
+    switch (width) {
+      case sizeof(uint8_t):
+        *counter = static_cast<uint8_t>(count);
+        break;
+      case sizeof(uint16_t): {
+          const uint16_t value = static_cast<uint16_t>(count);
+          std::memcpy(counter, &value, sizeof(uint16_t));
+          break;
+        }
+      default:
+        std::memcpy(counter, &count, sizeof(HypernodeID));
+    }
+  }
+
+  Width widthOf(const HyperedgeID he) const {
+    return _width != 0 ? _width : static_cast<Width>(_layout[he]);
+  }
+
+  size_t offsetOf(const HyperedgeID he, const Width width) const {
+    return _width != 0 ? static_cast<size_t>(he) * _k * width : _layout[he] >> kWidthBits;
+  }
+
+  void fill(const HyperedgeID he, const Byte value) {
+    ASSERT(he < _num_hyperedges, V(he));
+    const Width width = widthOf(he);
+    Byte* begin = _counts.data() + offsetOf(he, width);
+    std::fill(begin, begin + static_cast<size_t>(_k) * width, value);
+  }
+
+  void fillDense(const HyperedgeID he, const HypernodeID value) {
+    ASSERT(he < _num_hyperedges, V(he));
+    const auto begin = _dense_counts.begin() + static_cast<size_t>(he) * _k;
+    std::fill(begin, begin + _k, value);
+  }
+
+  HyperedgeID _num_hyperedges;
+  PartitionID _k;
+  // Whether the counters are stored in _counts (compact) or in _dense_counts.
+  bool _compact;
+  // Width of all counters if it is the same for all hyperedges, 0 otherwise.
+  Width _width;
+  // Offset of the counters of each hyperedge in the upper and their width
+  // in the lower kWidthBits bits, if _width is 0.
+  std::vector<Layout> _layout;
+  std::vector<Byte> _counts;
+  std::vector<HypernodeID> _dense_counts;
+};
+}  // namespace ds
+}  // namespace kahypar
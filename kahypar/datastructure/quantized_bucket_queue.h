@@ -0,0 +1,214 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+
+namespace kahypar {
+namespace ds {
+// Approximate max priority queue for (non-negative) floating point keys.
+// Keys are quantised logarithmically: Each power of two in
+// [2^kMinExponent, 2^kMaxExponent) is split into 2^kSubBucketBits buckets,
+// smaller and larger keys are clamped to the first/last bucket. Elements within
+// the same bucket are returned in arbitrary order, i.e. top() returns an element
+// whose key is within a relative error of 2^-kSubBucketBits of the maximum key.
+// All operations except finding the next non-empty bucket after removing the
+// last element of the top bucket take constant time.
+// The exact keys are stored, so getKey() and topKey() return the original values.
+template <typename IDType = Mandatory,
+          typename KeyType = Mandatory>
+class QuantizedBucketMaxQueue {
+ private:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr int kMinExponent = -32;
+  static constexpr int kMaxExponent = 32;
+  static constexpr size_t kSubBuckets = static_cast<size_t>(1) << kSubBucketBits;
+  static constexpr size_t kNumBuckets = (kMaxExponent - kMinExponent) * kSubBuckets;
+  static constexpr size_t kInvalidBucket = std::numeric_limits<size_t>::max();
+
+  struct Handle {
+    size_t bucket;
+    size_t index;
+  };
+
+ public:
+  using value_type = IDType;
+  using key_type = KeyType;
+
+  // Second parameter is used to satisfy EnhancedBucketPQ interface
+  explicit QuantizedBucketMaxQueue(const IDType max_size,
+                                   const KeyType& UNUSED(unused) = 0) :
+    _num_elements(0),
+    _max_bucket(0),
+    _handles(std::make_unique<Handle[]>(max_size)),
+    _keys(std::make_unique<KeyType[]>(max_size)),
+    _buckets(kNumBuckets) {
+    for (IDType i = 0; i < max_size; ++i) {
+      _handles[i] = { kInvalidBucket, 0 };
+    }
+  }
+
+  QuantizedBucketMaxQueue(const QuantizedBucketMaxQueue&) = delete;
+  QuantizedBucketMaxQueue& operator= (const QuantizedBucketMaxQueue&) = delete;
+
+  QuantizedBucketMaxQueue(QuantizedBucketMaxQueue&&) = default;
+  QuantizedBucketMaxQueue& operator= (QuantizedBucketMaxQueue&&) = default;
+
+  size_t size() const {
+    return _num_elements;
+  }
+
+  bool empty() const {
+    return _num_elements == 0;
+  }
+
+  bool contains(const IDType id) const {
+    return _handles[id].bucket != kInvalidBucket;
+  }
+
+  const KeyType & getKey(const IDType id) const {
+    ASSERT(contains(id), V(id));
+    return _keys[id];
+  }
+
+  void push(const IDType id, const KeyType key) {
+    ASSERT(!contains(id), V(id));
+    _keys[id] = key;
+    insert(id, bucketOf(key));
+    ++_num_elements;
+  }
+
+  const IDType & top() const {
+    ASSERT(!empty(), "Queue is empty");
+    ASSERT(!_buckets[_max_bucket].empty(), V(_max_bucket));
+    return _buckets[_max_bucket].back();
+  }
+
+  const KeyType & topKey() const {
+    return _keys[top()];
+  }
+
+  void pop() {
+    remove(top());
+  }
+
+  void remove(const IDType id) {
+    ASSERT(contains(id), V(id));
+    const size_t bucket = _handles[id].bucket;
+    erase(id);
+    --_num_elements;
+    if (bucket == _max_bucket) {
+      updateMaxBucket();
+    }
+  }
+
+  void updateKey(const IDType id, const KeyType new_key) {
+    ASSERT(contains(id), V(id));
+    _keys[id] = new_key;
+    const size_t old_bucket = _handles[id].bucket;
+    const size_t new_bucket = bucketOf(new_key);
+    if (old_bucket != new_bucket) {
+      erase(id);
+      insert(id, new_bucket);
+      if (old_bucket == _max_bucket) {
+        updateMaxBucket();
+      }
+    }
+  }
+
+  void increaseKey(const IDType id, const KeyType new_key) {
+    updateKey(id, new_key);
+  }
+
+  void decreaseKey(const IDType id, const KeyType new_key) {
+    updateKey(id, new_key);
+  }
+
+  void clear() {
+    if (_num_elements > 0) {
+      for (size_t bucket = 0; bucket <= _max_bucket; ++bucket) {
+        for (const IDType id : _buckets[bucket]) {
+          _handles[id].bucket = kInvalidBucket;
+        }
+        _buckets[bucket].clear();
+      }
+    }
+    _num_elements = 0;
+    _max_bucket = 0;
+  }
+
+  static size_t bucketOf(const KeyType key) {
+    if (!(key > 0)) {
+      return 0;
+    }
+    int exponent = 0;
+    // key = mantissa * 2^exponent with mantissa in [0.5, 1)
+    const double mantissa = std::frexp(static_cast<double>(key), &exponent);
+    if (exponent <= kMinExponent) {
+      return 0;
+    } else if (exponent > kMaxExponent) {
+      return kNumBuckets - 1;
+    }
+    const size_t sub_bucket = static_cast<size_t>((mantissa - 0.5) * 2 * kSubBuckets);
+    return (exponent - kMinExponent - 1) * kSubBuckets + sub_bucket;
+  }
+
+ private:
+  void insert(const IDType id, const size_t bucket) {
+    _buckets[bucket].push_back(id);
+    _handles[id] = { bucket, _buckets[bucket].size() - 1 };
+    if (bucket > _max_bucket || _num_elements == 0) {
+      _max_bucket = bucket;
+    }
+  }
+
+  void erase(const IDType id) {
+    const Handle handle = _handles[id];
+    std::vector<IDType>& bucket = _buckets[handle.bucket];
+    ASSERT(bucket[handle.index] == id, V(id));
+    _handles[bucket.back()].index = handle.index;
+    bucket[handle.index] = bucket.back();
+    bucket.pop_back();
+    _handles[id].bucket = kInvalidBucket;
+  }
+
+  void updateMaxBucket() {
+    while (_max_bucket > 0 && _buckets[_max_bucket].empty()) {
+      --_max_bucket;
+    }
+  }
+
+  size_t _num_elements;
+  size_t _max_bucket;
+  std::unique_ptr<Handle[]> _handles;
+  std::unique_ptr<KeyType[]> _keys;
+  std::vector<std::vector<IDType> > _buckets;
+};
+}  // namespace ds
+}  // namespace kahypar
@@ -41,8 +41,6 @@ class SparseSetBase {
   SparseSetBase(const SparseSetBase&) = delete;
   SparseSetBase& operator= (const SparseSetBase&) = delete;
 
-  SparseSetBase& operator= (SparseSetBase&&) = delete;
-
   ValueType size() const {
     return _size;
   }
@@ -94,6 +92,14 @@ class SparseSetBase {
     other._dense = nullptr;
   }
 
+  SparseSetBase& operator= (SparseSetBase&& other) {
+    using std::swap;
+    swap(_size, other._size);
+    swap(_sparse, other._sparse);
+    swap(_dense, other._dense);
+    return *this;
+  }
+
   ValueType _size;
   ValueType* _sparse;
   ValueType* _dense;
@@ -112,7 +118,10 @@ class SparseSet final : public SparseSetBase<ValueType, SparseSet<ValueType> >{
   SparseSet(SparseSet&& other) :
     Base(std::move(other)) { }
 
-  SparseSet& operator= (SparseSet&&) = delete;
+  SparseSet& operator= (SparseSet&& other) {
+    Base::operator= (std::move(other));
+    return *this;
+  }
   SparseSet& operator= (const SparseSet&) = delete;
 
   void remove(const ValueType value) {
@@ -27,9 +27,6 @@
 #include "datastructure/hypergraph.h"
 // #include "datastructure/GenericHypergraph2.h"
 
-// Use bucket PQ for FM refinement.
-// #define USE_BUCKET_QUEUE
-
 // Gather advanced statistics
 // #define GATHER_STATS
 
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/coarsening/i_coarsener.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/utils/math.h"
+#include "kahypar/utils/serialization.h"
+
+namespace kahypar {
+namespace io {
+static constexpr uint64_t kCoarseningSnapshotMagic = 0x50414E534859484BULL;  // "KHYHSNAP"
+static constexpr uint32_t kCoarseningSnapshotVersion = 2;
+
+// Identifies the input of the coarsening phase: the (preprocessed) hypergraph
+// and all configuration parameters that influence the coarsening result.
+struct CoarseningSnapshotHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint64_t config_hash;
+  uint64_t input_hash;
+  HypernodeID num_hypernodes;
+  HyperedgeID num_hyperedges;
+  HypernodeID num_pins;
+  HypernodeWeight total_weight;
+  HypernodeID current_num_hypernodes;
+  HyperedgeID current_num_hyperedges;
+  HypernodeID current_num_pins;
+
+  bool operator== (const CoarseningSnapshotHeader& other) const {
+    return magic == other.magic && version == other.version &&
+           config_hash == other.config_hash && input_hash == other.input_hash &&
+           num_hypernodes == other.num_hypernodes &&
+           num_hyperedges == other.num_hyperedges && num_pins == other.num_pins &&
+           total_weight == other.total_weight &&
+           current_num_hypernodes == other.current_num_hypernodes &&
+           current_num_hyperedges == other.current_num_hyperedges &&
+           current_num_pins == other.current_num_pins;
+  }
+};
+
+// Hash of all configuration parameters that influence the outcome of the coarsening phase.
+// Note that the contraction limit and the maximum allowed node weight depend on k.
+static inline uint64_t coarseningConfigurationHash(const Configuration& config) {
+  std::ostringstream oss;
+  oss << std::setprecision(17)
+  << config.preprocessing
+  << toString(config.coarsening.algorithm)
+  << " " << config.coarsening.contraction_limit_multiplier
+  << " " << config.coarsening.max_allowed_weight_multiplier
+  << " " << config.coarsening.batch_parallel_net_detection
+  << " " << config.coarsening.rating_sample_size
+  << " " << config.coarsening.two_hop_contraction
+  << " " << config.coarsening.community_cluster_contraction
+  << " " << config.coarsening.max_allowed_node_weight
+  << " " << config.coarsening.contraction_limit
+  << " " << config.coarsening.hypernode_weight_fraction
+  << " " << config.partition.hyperedge_size_threshold
+  << " " << config.partition.seed;
+  const std::string str = oss.str();
+  return math::XXH64(str.data(), str.size(), 0);
+}
+
+// Hash of the pins of all hyperedges as well as all hypernode and hyperedge weights.
+// Distinguishes inputs that have the same dimensions.
+static inline uint64_t coarseningInputHash(const Hypergraph& hypergraph) {
+  std::vector<HypernodeID> pins;
+  pins.reserve(hypergraph.currentNumPins());
+  std::vector<HyperedgeWeight> edge_weights;
+  edge_weights.reserve(hypergraph.currentNumEdges());
+  for (const HyperedgeID he : hypergraph.edges()) {
+    pins.push_back(hypergraph.edgeSize(he));
+    for (const HypernodeID pin : hypergraph.pins(he)) {
+      pins.push_back(pin);
+    }
+    edge_weights.push_back(hypergraph.edgeWeight(he));
+  }
+  std::vector<HypernodeWeight> node_weights;
+  node_weights.reserve(hypergraph.currentNumNodes());
+  for (const HypernodeID hn : hypergraph.nodes()) {
+    node_weights.push_back(hypergraph.nodeWeight(hn));
+  }
+  uint64_t hash = math::XXH64(pins.data(), sizeof(HypernodeID) * pins.size(), 0);
+  hash = math::XXH64(edge_weights.data(), sizeof(HyperedgeWeight) * edge_weights.size(), hash);
+  return math::XXH64(node_weights.data(), sizeof(HypernodeWeight) * node_weights.size(), hash);
+}
+
+// Has to be called before the hypergraph is coarsened.
+static inline CoarseningSnapshotHeader createCoarseningSnapshotHeader(const Hypergraph& hypergraph,
+                                                                      const Configuration& config) {
+  return CoarseningSnapshotHeader { kCoarseningSnapshotMagic, kCoarseningSnapshotVersion,
+                                    coarseningConfigurationHash(config),
+                                    coarseningInputHash(hypergraph),
+                                    hypergraph.initialNumNodes(), hypergraph.initialNumEdges(),
+                                    hypergraph.initialNumPins(), hypergraph.totalWeight(),
+                                    hypergraph.currentNumNodes(), hypergraph.currentNumEdges(),
+                                    hypergraph.currentNumPins() };
+}
+
+static inline void writeCoarseningSnapshotHeader(std::ostream& out,
+                                                 const CoarseningSnapshotHeader& header) {
+  serialization::write(out, header.magic);
+  serialization::write(out, header.version);
+  serialization::write(out, header.config_hash);
+  serialization::write(out, header.input_hash);
+  serialization::write(out, header.num_hypernodes);
+  serialization::write(out, header.num_hyperedges);
+  serialization::write(out, header.num_pins);
+  serialization::write(out, header.total_weight);
+  serialization::write(out, header.current_num_hypernodes);
+  serialization::write(out, header.current_num_hyperedges);
+  serialization::write(out, header.current_num_pins);
+}
+
+static inline bool readCoarseningSnapshotHeader(std::istream& in,
+                                                CoarseningSnapshotHeader& header) {
+  return serialization::read(in, header.magic) &&
+         serialization::read(in, header.version) &&
+         serialization::read(in, header.config_hash) &&
+         serialization::read(in, header.input_hash) &&
+         serialization::read(in, header.num_hypernodes) &&
+         serialization::read(in, header.num_hyperedges) &&
+         serialization::read(in, header.num_pins) &&
+         serialization::read(in, header.total_weight) &&
+         serialization::read(in, header.current_num_hypernodes) &&
+         serialization::read(in, header.current_num_hyperedges) &&
+         serialization::read(in, header.current_num_pins);
+}
+
+// Writes the coarsened hypergraph together with everything that is necessary to uncoarsen
+// it to a binary file. Has to be called directly after coarsener.coarsen() using the
+// header that was created before coarsening. The coarsening state is preceded by its
+// size and checksum, so that truncated or damaged files are detected before anything
+// is restored.
+static inline void writeCoarseningSnapshot(const std::string& filename,
+                                           const CoarseningSnapshotHeader& header,
+                                           const ICoarsener& coarsener) {
+  std::ostringstream state_stream(std::ios::binary);
+  coarsener.writeSnapshot(state_stream);
+  const std::string state = state_stream.str();
+
+  std::ofstream out_stream(filename.c_str(), std::ios::binary);
+  writeCoarseningSnapshotHeader(out_stream, header);
+  serialization::write(out_stream, static_cast<uint64_t>(state.size()));
+  serialization::write(out_stream, math::XXH64(state.data(), state.size(), 0));
+  out_stream.write(state.data(), state.size());
+  out_stream.close();
+}
+
+enum class CoarseningSnapshotStatus : uint8_t {
+  restored,
+  not_found,
+  mismatch,
+  corrupted,
+  invalid
+};
+
+// Tries to restore a snapshot written by writeCoarseningSnapshot for the given (uncoarsened)
+// hypergraph. Unless the snapshot is restored, neither the hypergraph nor the coarsener are
+// modified, i.e. if the file does not exist (not_found), was created for a different
+// hypergraph or configuration (mismatch) or is damaged (corrupted). Only if a state that
+// passed all checks still cannot be restored, invalid is returned and the hypergraph
+// has to be considered invalid.
+static inline CoarseningSnapshotStatus readCoarseningSnapshot(const std::string& filename,
+                                                              Hypergraph& hypergraph,
+                                                              ICoarsener& coarsener,
+                                                              const Configuration& config) {
+  std::ifstream in_stream(filename.c_str(), std::ios::binary);
+  if (!in_stream) {
+    return CoarseningSnapshotStatus::not_found;
+  }
+  CoarseningSnapshotHeader header { };
+  if (!readCoarseningSnapshotHeader(in_stream, header)) {
+    return CoarseningSnapshotStatus::corrupted;
+  }
+  if (!(header == createCoarseningSnapshotHeader(hypergraph, config))) {
+    return CoarseningSnapshotStatus::mismatch;
+  }
+
+  uint64_t state_size = 0;
+  uint64_t state_checksum = 0;
+  if (!serialization::read(in_stream, state_size) ||
+      !serialization::read(in_stream, state_checksum)) {
+    return CoarseningSnapshotStatus::corrupted;
+  }
+  const std::streampos state_begin = in_stream.tellg();
+  in_stream.seekg(0, std::ios::end);
+  if (static_cast<uint64_t>(in_stream.tellg() - state_begin) != state_size) {
+    return CoarseningSnapshotStatus::corrupted;
+  }
+  in_stream.seekg(state_begin);
+  std::string state(state_size, '\0');
+  in_stream.read(&state[0], state_size);
+  if (!in_stream || math::XXH64(state.data(), state.size(), 0) != state_checksum) {
+    return CoarseningSnapshotStatus::corrupted;
+  }
+
+  std::istringstream state_stream(state, std::ios::binary);
+  if (!coarsener.readSnapshot(state_stream)) {
+    return CoarseningSnapshotStatus::invalid;
+  }
+  return CoarseningSnapshotStatus::restored;
+}
+}  // namespace io
+}  // namespace kahypar
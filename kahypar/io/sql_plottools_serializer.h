@@ -50,6 +50,8 @@ static inline void serialize(const Configuration& config, const Hypergraph& hype
   << " epsilon=" << config.partition.epsilon
   << " seed=" << config.partition.seed
   << " num_v_cycles=" << config.partition.global_search_iterations
+  << " time_limit=" << config.partition.time_limit
+  << " rb_num_threads=" << config.partition.rb_num_threads
   << " he_size_threshold=" << config.partition.hyperedge_size_threshold
   << " total_graph_weight=" << config.partition.total_graph_weight
   << " L_opt0=" << config.partition.perfect_balance_part_weights[0]
@@ -104,10 +106,22 @@ static inline void serialize(const Configuration& config, const Hypergraph& hype
   << " coarsening_hypernode_weight_fraction=" << config.coarsening.hypernode_weight_fraction
   << " coarsening_max_allowed_node_weight=" << config.coarsening.max_allowed_node_weight
   << " coarsening_contraction_limit=" << config.coarsening.contraction_limit
+  << " coarsening_batch_parallel_net_detection=" << std::boolalpha
+  << config.coarsening.batch_parallel_net_detection
+  << " coarsening_rating_sample_size=" << config.coarsening.rating_sample_size
+  << " coarsening_two_hop_contraction=" << config.coarsening.two_hop_contraction
+  << " coarsening_community_cluster_contraction="
+  << config.coarsening.community_cluster_contraction
   << " IP_mode=" << toString(config.initial_partitioning.mode)
   << " IP_technique=" << toString(config.initial_partitioning.technique)
   << " IP_algorithm=" << toString(config.initial_partitioning.algo)
   << " IP_pool_type=" << config.initial_partitioning.pool_type
+  << " IP_pool_num_threads=" << config.initial_partitioning.pool_num_threads
+  << " IP_pool_adaptive=" << std::boolalpha << config.initial_partitioning.pool_adaptive
+  << " IP_pool_warmup_runs=" << config.initial_partitioning.pool_warmup_runs
+  << " IP_greedy_rebalancing=" << std::boolalpha
+  << config.initial_partitioning.greedy_rebalancing
+  << " IP_gain_queue=" << toString(config.initial_partitioning.gain_queue)
   << " IP_num_runs=" << config.initial_partitioning.nruns
   << " IP_coarsening_algo=" << toString(config.initial_partitioning.coarsening.algorithm)
   << " IP_coarsening_max_allowed_weight_multiplier="
@@ -119,7 +133,9 @@ static inline void serialize(const Configuration& config, const Hypergraph& hype
   << config.initial_partitioning.local_search.iterations_per_level;
   if (config.initial_partitioning.local_search.algorithm == RefinementAlgorithm::twoway_fm ||
       config.initial_partitioning.local_search.algorithm == RefinementAlgorithm::kway_fm ||
-      config.initial_partitioning.local_search.algorithm == RefinementAlgorithm::kway_fm_km1) {
+      config.initial_partitioning.local_search.algorithm == RefinementAlgorithm::kway_fm_km1 ||
+      config.initial_partitioning.local_search.algorithm ==
+      RefinementAlgorithm::kway_fm_km1_parallel) {
     oss << " IP_local_search_fm_stopping_rule="
     << toString(config.initial_partitioning.local_search.fm.stopping_rule)
     << " IP_local_search_fm_max_number_of_fruitless_moves="
@@ -127,27 +143,39 @@ static inline void serialize(const Configuration& config, const Hypergraph& hype
     << " IP_local_search_fm_global_rebalancing="
     << toString(config.initial_partitioning.local_search.fm.global_rebalancing)
     << " IP_local_search_fm_adaptive_stopping_alpha="
-    << config.initial_partitioning.local_search.fm.adaptive_stopping_alpha;
+    << config.initial_partitioning.local_search.fm.adaptive_stopping_alpha
+    << " IP_local_search_fm_gain_queue="
+    << toString(config.initial_partitioning.local_search.fm.gain_queue);
   }
-  if (config.initial_partitioning.local_search.algorithm == RefinementAlgorithm::label_propagation) {
+  if (config.initial_partitioning.local_search.algorithm == RefinementAlgorithm::label_propagation ||
+      config.initial_partitioning.local_search.algorithm ==
+      RefinementAlgorithm::label_propagation_parallel) {
     oss << " IP_local_search_sclap_max_number_iterations="
     << config.initial_partitioning.local_search.sclap.max_number_iterations;
   }
 
   oss << " local_search_algorithm=" << toString(config.local_search.algorithm)
-  << " local_search_iterations_per_level=" << config.local_search.iterations_per_level;
+  << " local_search_iterations_per_level=" << config.local_search.iterations_per_level
+  << " local_search_uncontraction_batch_size=" << config.local_search.uncontraction_batch_size
+  << " local_search_num_threads=" << config.local_search.num_threads;
   if (config.local_search.algorithm == RefinementAlgorithm::twoway_fm ||
       config.local_search.algorithm == RefinementAlgorithm::kway_fm ||
-      config.local_search.algorithm == RefinementAlgorithm::kway_fm_km1) {
+      config.local_search.algorithm == RefinementAlgorithm::kway_fm_km1 ||
+      config.local_search.algorithm == RefinementAlgorithm::kway_fm_km1_parallel) {
     oss << " local_search_fm_stopping_rule=" << toString(config.local_search.fm.stopping_rule)
     << " local_search_fm_max_number_of_fruitless_moves="
     << config.local_search.fm.max_number_of_fruitless_moves
     << " local_search_fm_global_rebalancing=" << toString(config.local_search.fm.global_rebalancing)
-    << " local_search_fm_adaptive_stopping_alpha=" << config.local_search.fm.adaptive_stopping_alpha;
+    << " local_search_fm_adaptive_stopping_alpha=" << config.local_search.fm.adaptive_stopping_alpha
+    << " local_search_fm_sparse_gain_cache_min_k=" << config.local_search.fm.sparse_gain_cache_min_k
+    << " local_search_fm_gain_queue=" << toString(config.local_search.fm.gain_queue);
   }
-  if (config.local_search.algorithm == RefinementAlgorithm::label_propagation) {
+  if (config.local_search.algorithm == RefinementAlgorithm::label_propagation ||
+      config.local_search.algorithm == RefinementAlgorithm::label_propagation_parallel) {
     oss << " local_search_sclap_max_number_iterations="
-    << config.local_search.sclap.max_number_iterations;
+    << config.local_search.sclap.max_number_iterations
+    << " local_search_sclap_deterministic=" << std::boolalpha
+    << config.local_search.sclap.deterministic;
   }
   oss << partitioner.internals();
   for (PartitionID i = 0; i != hypergraph.k(); ++i) {
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "kahypar/datastructure/quantized_bucket_queue.h"
 #include "kahypar/meta/policy_registry.h"
 #include "kahypar/meta/registrar.h"
 #include "kahypar/partition/coarsening/do_nothing_coarsener.h"
@@ -50,6 +51,16 @@
     return new ip(hypergraph, config);                                          \
   })
 
+#define REGISTER_DISPATCHED_INITIAL_PARTITIONER(id, dispatcher, ip, ...)          \
+  static meta::Registrar<InitialPartitioningFactory> register_ ## ip(            \
+    id,                                                                           \
+    [](Hypergraph& hypergraph, Configuration& config) -> IInitialPartitioner* {  \
+    return dispatcher<ip>::create(                                                \
+      std::forward_as_tuple(hypergraph, config),                                  \
+      __VA_ARGS__                                                                 \
+      );                                                                          \
+  })
+
 #define REGISTER_DISPATCHED_REFINER(id, dispatcher, ...)          \
   static meta::Registrar<RefinerFactory> register_ ## dispatcher( \
     id,                                                           \
@@ -82,8 +93,15 @@ namespace kahypar {
 ////////////////////////////////////////////////////////////////////////////////
   using RandomWinsFullCoarsener = FullVertexPairCoarsener<RandomWinsRaterHeavyEdgeRater>;
   using RandomWinsLazyUpdateCoarsener = LazyVertexPairCoarsener<RandomWinsRaterHeavyEdgeRater>;
+  using RatingBucketQueue = ds::QuantizedBucketMaxQueue<HypernodeID, RatingType>;
+  using RandomWinsBucketFullCoarsener = FullVertexPairCoarsener<RandomWinsRaterHeavyEdgeRater,
+                                                                RatingBucketQueue>;
+  using RandomWinsBucketLazyUpdateCoarsener = LazyVertexPairCoarsener<RandomWinsRaterHeavyEdgeRater,
+                                                                      RatingBucketQueue>;
   REGISTER_COARSENER(CoarseningAlgorithm::heavy_lazy, RandomWinsLazyUpdateCoarsener);
   REGISTER_COARSENER(CoarseningAlgorithm::heavy_full, RandomWinsFullCoarsener);
+  REGISTER_COARSENER(CoarseningAlgorithm::heavy_lazy_bucket, RandomWinsBucketLazyUpdateCoarsener);
+  REGISTER_COARSENER(CoarseningAlgorithm::heavy_full_bucket, RandomWinsBucketFullCoarsener);
   REGISTER_COARSENER(CoarseningAlgorithm::ml_style, MLCoarsener);
   REGISTER_COARSENER(CoarseningAlgorithm::do_nothing, DoNothingCoarsener);
 
@@ -94,66 +112,117 @@ namespace kahypar {
   using LPInitialPartitionerBFS_FM =
           LabelPropagationInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                              FMGainComputationPolicy>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_FM_SEQ =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     FMGainComputationPolicy,
-                                                    SequentialQueueSelectionPolicy>;
+                                                    SequentialQueueSelectionPolicy,
+                                                    GainQueue>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_FM_GLO =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     FMGainComputationPolicy,
-                                                    GlobalQueueSelectionPolicy>;
+                                                    GlobalQueueSelectionPolicy,
+                                                    GainQueue>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_FM_RND =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     FMGainComputationPolicy,
-                                                    RoundRobinQueueSelectionPolicy>;
+                                                    RoundRobinQueueSelectionPolicy,
+                                                    GainQueue>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_MAXP_SEQ =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     MaxPinGainComputationPolicy,
-                                                    SequentialQueueSelectionPolicy>;
+                                                    SequentialQueueSelectionPolicy,
+                                                    GainQueue>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_MAXP_GLO =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     MaxPinGainComputationPolicy,
-                                                    GlobalQueueSelectionPolicy>;
+                                                    GlobalQueueSelectionPolicy,
+                                                    GainQueue>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_MAXP_RND =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     MaxPinGainComputationPolicy,
-                                                    RoundRobinQueueSelectionPolicy>;
+                                                    RoundRobinQueueSelectionPolicy,
+                                                    GainQueue>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_MAXN_SEQ =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     MaxNetGainComputationPolicy,
-                                                    SequentialQueueSelectionPolicy>;
+                                                    SequentialQueueSelectionPolicy,
+                                                    GainQueue>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_MAXN_GLO =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     MaxNetGainComputationPolicy,
-                                                    GlobalQueueSelectionPolicy>;
+                                                    GlobalQueueSelectionPolicy,
+                                                    GainQueue>;
+  template <class GainQueue>
   using GHGInitialPartitionerBFS_MAXN_RND =
           GreedyHypergraphGrowingInitialPartitioner<BFSStartNodeSelectionPolicy<>,
                                                     MaxNetGainComputationPolicy,
-                                                    RoundRobinQueueSelectionPolicy>;
+                                                    RoundRobinQueueSelectionPolicy,
+                                                    GainQueue>;
   REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::random,
                                RandomInitialPartitioner);
   REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::bfs, BFSInitialPartitionerBFS);
   REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::lp, LPInitialPartitionerBFS_FM);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_sequential,
-                               GHGInitialPartitionerBFS_FM_SEQ);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_global,
-                               GHGInitialPartitionerBFS_FM_GLO);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_round,
-                               GHGInitialPartitionerBFS_FM_RND);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_sequential_maxpin,
-                               GHGInitialPartitionerBFS_MAXP_SEQ);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_global_maxpin,
-                               GHGInitialPartitionerBFS_MAXP_GLO);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_round_maxpin,
-                               GHGInitialPartitionerBFS_MAXP_RND);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_sequential_maxnet,
-                               GHGInitialPartitionerBFS_MAXN_SEQ);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_global_maxnet,
-                               GHGInitialPartitionerBFS_MAXN_GLO);
-  REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_round_maxnet,
-                               GHGInitialPartitionerBFS_MAXN_RND);
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_sequential,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_FM_SEQ,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_global,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_FM_GLO,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_round,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_FM_RND,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_sequential_maxpin,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_MAXP_SEQ,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_global_maxpin,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_MAXP_GLO,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_round_maxpin,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_MAXP_RND,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_sequential_maxnet,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_MAXN_SEQ,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_global_maxnet,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_MAXN_GLO,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
+  REGISTER_DISPATCHED_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::greedy_round_maxnet,
+                                          GreedyInitialPartitionerFactoryDispatcher,
+                                          GHGInitialPartitionerBFS_MAXN_RND,
+                                          meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                            config.initial_partitioning.gain_queue));
   REGISTER_INITIAL_PARTITIONER(InitialPartitionerAlgorithm::pool, PoolInitialPartitioner);
 
+////////////////////////////////////////////////////////////////////////////////
+//                    Initial Partitioning Algorithm Policies
+////////////////////////////////////////////////////////////////////////////////
+  REGISTER_POLICY(GainQueueType, GainQueueType::heap, HeapGainQueue);
+  REGISTER_POLICY(GainQueueType, GainQueueType::bucket, BucketGainQueue);
+
 ////////////////////////////////////////////////////////////////////////////////
 //                       Local Search Algorithm Policies
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,6 +234,8 @@ namespace kahypar {
                   GlobalRebalancing);
   REGISTER_POLICY(GlobalRebalancingMode, GlobalRebalancingMode::off,
                   NoGlobalRebalancing);
+  REGISTER_POLICY(GainCacheType, GainCacheType::dense, DenseGainCache);
+  REGISTER_POLICY(GainCacheType, GainCacheType::sparse, SparseGainCache);
 
 ////////////////////////////////////////////////////////////////////////////////
 //                           Local Search Algorithms
@@ -174,15 +245,32 @@ namespace kahypar {
                               meta::PolicyRegistry<RefinementStoppingRule>::getInstance().getPolicy(
                                 config.local_search.fm.stopping_rule),
                               meta::PolicyRegistry<GlobalRebalancingMode>::getInstance().getPolicy(
-                                config.local_search.fm.global_rebalancing));
+                                config.local_search.fm.global_rebalancing),
+                              meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                config.local_search.fm.gain_queue));
   REGISTER_DISPATCHED_REFINER(RefinementAlgorithm::kway_fm,
                               KWayFMFactoryDispatcher,
                               meta::PolicyRegistry<RefinementStoppingRule>::getInstance().getPolicy(
-                                config.local_search.fm.stopping_rule));
+                                config.local_search.fm.stopping_rule),
+                              meta::PolicyRegistry<GainCacheType>::getInstance().getPolicy(
+                                config.partition.k >= config.local_search.fm.sparse_gain_cache_min_k ?
+                                GainCacheType::sparse : GainCacheType::dense),
+                              meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                config.local_search.fm.gain_queue));
   REGISTER_DISPATCHED_REFINER(RefinementAlgorithm::kway_fm_km1,
                               KWayKMinusOneFactoryDispatcher,
+                              meta::PolicyRegistry<RefinementStoppingRule>::getInstance().getPolicy(
+                                config.local_search.fm.stopping_rule),
+                              meta::PolicyRegistry<GainCacheType>::getInstance().getPolicy(
+                                config.partition.k >= config.local_search.fm.sparse_gain_cache_min_k ?
+                                GainCacheType::sparse : GainCacheType::dense),
+                              meta::PolicyRegistry<GainQueueType>::getInstance().getPolicy(
+                                config.local_search.fm.gain_queue));
+  REGISTER_DISPATCHED_REFINER(RefinementAlgorithm::kway_fm_km1_parallel,
+                              KWayParallelKMinusOneFactoryDispatcher,
                               meta::PolicyRegistry<RefinementStoppingRule>::getInstance().getPolicy(
                                 config.local_search.fm.stopping_rule));
   REGISTER_REFINER(RefinementAlgorithm::label_propagation, LPRefiner);
+  REGISTER_REFINER(RefinementAlgorithm::label_propagation_parallel, ParallelLPRefiner);
   REGISTER_REFINER(RefinementAlgorithm::do_nothing, DoNothingRefiner);
 }  // namespace kahypar
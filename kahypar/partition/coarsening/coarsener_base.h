@@ -21,7 +21,10 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <map>
+#include <memory>
 #include <stack>
 #include <string>
 #include <unordered_map>
@@ -35,6 +38,9 @@
 #include "kahypar/partition/configuration.h"
 #include "kahypar/partition/metrics.h"
 #include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/partition/refinement/lp_refiner.h"
+#include "kahypar/partition/refinement/refinement_scheduler.h"
+#include "kahypar/utils/serialization.h"
 #include "kahypar/utils/stats.h"
 
 namespace kahypar {
@@ -61,7 +67,9 @@ class CoarsenerBase {
     _config(config),
     _history(),
     _max_hn_weights(),
-    _hypergraph_pruner(_hg.initialNumNodes()) {
+    _hypergraph_pruner(_hg.initialNumNodes(), _hg.initialNumEdges()),
+    _refinement_scheduler(config),
+    _fallback_refiner() {
     _history.reserve(_hg.initialNumNodes());
     _max_hn_weights.reserve(_hg.initialNumNodes());
     _max_hn_weights.emplace_back(_hg.initialNumNodes(), weight_of_heaviest_node);
@@ -82,7 +90,11 @@ class CoarsenerBase {
       _max_hn_weights.emplace_back(_hg.currentNumNodes(), _hg.nodeWeight(rep_node));
     }
     removeSingleNodeHyperedges();
-    removeParallelHyperedges();
+    if (_config.coarsening.batch_parallel_net_detection) {
+      _hypergraph_pruner.updateFingerprints(_hg, _history.back());
+    } else {
+      removeParallelHyperedges();
+    }
   }
 
   void removeSingleNodeHyperedges() {
@@ -97,30 +109,169 @@ class CoarsenerBase {
     Stats::instance().add(_config, "numRemovedParalellHEs", removed_parallel_hes);
   }
 
+  // If parallel net detection is batched, this method has to be called at the end of each
+  // coarsening pass (and before the coarsest hypergraph is handed to initial partitioning).
+  // It is a no-op if batching is disabled or if no contraction was performed since the
+  // last call. The removed nets are attributed to _history.back().
+  HyperedgeID removeParallelHyperedgesOfPass() {
+    HyperedgeID removed_parallel_hes = 0;
+    if (_config.coarsening.batch_parallel_net_detection && !_history.empty()) {
+      removed_parallel_hes = _hypergraph_pruner.removeParallelHyperedgesOfPass(_hg, _history.back());
+      Stats::instance().add(_config, "numRemovedParalellHEs", removed_parallel_hes);
+    }
+    return removed_parallel_hes;
+  }
+
+  // Batched counterpart of the per-contraction community update: The net vertices of the
+  // parallel nets removed at the end of a pass are contracted in the community structure
+  // (i.e., the louvain instance or the rater) if multilevel louvain is used.
+  template <typename Communities>
+  void removeParallelHyperedgesOfPass(Communities& communities) {
+    if (removeParallelHyperedgesOfPass() > 0 && _config.preprocessing.use_multilevel_louvain) {
+      const size_t N = _hg.initialNumNodes();
+      const CoarseningMemento& memento = _history.back();
+      for (int i = memento.parallel_hes_begin;
+           i < memento.parallel_hes_begin + memento.parallel_hes_size; ++i) {
+        communities.contractHypernodes(
+          N + _hypergraph_pruner.removedParallelHyperedges()[i].representative_id,
+          N + _hypergraph_pruner.removedParallelHyperedges()[i].removed_id);
+      }
+    }
+  }
+
   void restoreParallelHyperedges() {
     _hypergraph_pruner.restoreParallelHyperedges(_hg, _history.back());
   }
 
+  // Writes everything that is necessary to uncoarsen the current (coarsened) hypergraph:
+  // the contracted hypergraph itself, the contraction history and the removal logs
+  // of the pruner.
+  void writeCoarseningState(std::ostream& out) const {
+    ds::writeContractionState(_hg, out);
+    serialization::write(out, static_cast<uint64_t>(_history.size()));
+    for (const CoarseningMemento& memento : _history) {
+      serialization::write(out, memento.one_pin_hes_begin);
+      serialization::write(out, memento.one_pin_hes_size);
+      serialization::write(out, memento.parallel_hes_begin);
+      serialization::write(out, memento.parallel_hes_size);
+      serialization::write(out, memento.contraction_memento.u);
+      serialization::write(out, memento.contraction_memento.u_first_entry);
+      serialization::write(out, memento.contraction_memento.u_size);
+      serialization::write(out, memento.contraction_memento.v);
+    }
+    serialization::write(out, static_cast<uint64_t>(_max_hn_weights.size()));
+    for (const CurrentMaxNodeWeight& max_weight : _max_hn_weights) {
+      serialization::write(out, max_weight.num_nodes);
+      serialization::write(out, max_weight.max_weight);
+    }
+    _hypergraph_pruner.writeRemovalLogs(out);
+  }
+
+  // Restores a state written by writeCoarseningState. The coarsener has to be in its initial
+  // state, i.e., coarsen() must not have been called before.
+  bool readCoarseningState(std::istream& in) {
+    ASSERT(_history.empty(), "Coarsener already coarsened the hypergraph");
+    if (!ds::readContractionState(_hg, in)) {
+      return false;
+    }
+    uint64_t history_size = 0;
+    if (!serialization::read(in, history_size) || history_size > _hg.initialNumNodes()) {
+      return false;
+    }
+    for (uint64_t i = 0; i < history_size; ++i) {
+      int one_pin_hes_begin = 0;
+      int one_pin_hes_size = 0;
+      int parallel_hes_begin = 0;
+      int parallel_hes_size = 0;
+      HypernodeID u = 0;
+      HypernodeID u_first_entry = 0;
+      HypernodeID u_size = 0;
+      HypernodeID v = 0;
+      if (!(serialization::read(in, one_pin_hes_begin) &&
+            serialization::read(in, one_pin_hes_size) &&
+            serialization::read(in, parallel_hes_begin) &&
+            serialization::read(in, parallel_hes_size) &&
+            serialization::read(in, u) &&
+            serialization::read(in, u_first_entry) &&
+            serialization::read(in, u_size) &&
+            serialization::read(in, v))) {
+        return false;
+      }
+      _history.emplace_back(Hypergraph::ContractionMemento(u, u_first_entry, u_size, v));
+      _history.back().one_pin_hes_begin = one_pin_hes_begin;
+      _history.back().one_pin_hes_size = one_pin_hes_size;
+      _history.back().parallel_hes_begin = parallel_hes_begin;
+      _history.back().parallel_hes_size = parallel_hes_size;
+    }
+    uint64_t num_max_hn_weights = 0;
+    if (!serialization::read(in, num_max_hn_weights)) {
+      return false;
+    }
+    _max_hn_weights.clear();
+    for (uint64_t i = 0; i < num_max_hn_weights; ++i) {
+      HypernodeID num_nodes = 0;
+      HypernodeWeight max_weight = 0;
+      if (!serialization::read(in, num_nodes) || !serialization::read(in, max_weight)) {
+        return false;
+      }
+      _max_hn_weights.emplace_back(num_nodes, max_weight);
+    }
+    return !_max_hn_weights.empty() && _hypergraph_pruner.readRemovalLogs(in);
+  }
+
   void restoreSingleNodeHyperedges() {
     _hypergraph_pruner.restoreSingleNodeHyperedges(_hg, _history.back());
   }
 
   void initializeRefiner(IRefiner& refiner) {
-#ifdef USE_BUCKET_QUEUE
-    HyperedgeID max_degree = 0;
-    for (const HypernodeID hn : _hg.nodes()) {
-      max_degree = std::max(max_degree, _hg.nodeDegree(hn));
-    }
-    HyperedgeWeight max_he_weight = 0;
-    for (const HyperedgeID he : _hg.edges()) {
-      max_he_weight = std::max(max_he_weight, _hg.edgeWeight(he));
-    }
-    LOGVAR(max_degree);
-    LOGVAR(max_he_weight);
-    refiner.initialize(static_cast<HyperedgeWeight>(max_degree * max_he_weight));
-#else
-    refiner.initialize(0);
-#endif
+    HyperedgeWeight max_gain = 0;
+    if (_config.local_search.fm.gain_queue == GainQueueType::bucket) {
+      // Bucket queues need an upper bound on the absolute gain of a move.
+      HyperedgeID max_degree = 0;
+      for (const HypernodeID hn : _hg.nodes()) {
+        max_degree = std::max(max_degree, _hg.nodeDegree(hn));
+      }
+      HyperedgeWeight max_he_weight = 0;
+      for (const HyperedgeID he : _hg.edges()) {
+        max_he_weight = std::max(max_he_weight, _hg.edgeWeight(he));
+      }
+      max_gain = static_cast<HyperedgeWeight>(max_degree * max_he_weight);
+    }
+    refiner.initialize(max_gain);
+    if (RefinementScheduler::hasDeadline(_config)) {
+      // Each contraction that remains to be undone adds one hypernode.
+      _refinement_scheduler.reset(_hg.currentNumNodes() + _history.size());
+      _fallback_refiner.reset();
+      refiner.setMoveBudget(RefinementScheduler::kUnlimitedMoves);
+    }
+  }
+
+  // Returns the refiner for the current level if a time limit is given or nullptr if the
+  // deadline has passed. If the configured refiner is too slow to refine all remaining
+  // levels in time, they are refined by label propagation instead.
+  IRefiner* scheduleLocalSearch(IRefiner& refiner, const size_t num_refinement_nodes) {
+    if (RefinementScheduler::deadlinePassed(_config)) {
+      return nullptr;
+    }
+    if (!_fallback_refiner) {
+      if (!_refinement_scheduler.isBehindSchedule(_hg.currentNumNodes())) {
+        refiner.setMoveBudget(std::max(_refinement_scheduler.moveBudget(_hg.currentNumNodes()),
+                                       static_cast<int>(num_refinement_nodes)));
+        return &refiner;
+      }
+      if (_config.partition.verbose_output) {
+        LOG("Switching to label propagation refinement at " << _hg.currentNumNodes()
+            << " hypernodes to meet the time limit");
+      }
+      _fallback_refiner.reset(new LPRefiner(_hg, _config));
+      // LP optimizes the cut. In direct k-way km1 mode, it must not worsen the
+      // objective of the refiner it replaces.
+      _fallback_refiner->rejectKMinusOneIncreasingMoves(
+        _config.partition.mode == Mode::direct_kway &&
+        _config.partition.objective == Objective::km1);
+      _fallback_refiner->initialize(0);
+    }
+    return _fallback_refiner.get();
   }
 
   void performLocalSearch(IRefiner& refiner, std::vector<HypernodeID>& refinement_nodes,
@@ -128,18 +279,34 @@ class CoarsenerBase {
                           const UncontractionGainChanges& changes) {
     ASSERT(changes.representative.size() != 0, "0");
     ASSERT(changes.contraction_partner.size() != 0, "0");
-    bool improvement_found = performLocalSearchIteration(refiner, refinement_nodes, changes,
+    const bool has_deadline = RefinementScheduler::hasDeadline(_config);
+    IRefiner* level_refiner = &refiner;
+    HighResClockTimepoint start;
+    if (has_deadline) {
+      level_refiner = scheduleLocalSearch(refiner, refinement_nodes.size());
+      if (level_refiner == nullptr) {
+        return;
+      }
+      start = std::chrono::high_resolution_clock::now();
+    }
+    bool improvement_found = performLocalSearchIteration(*level_refiner, refinement_nodes, changes,
                                                          current_metrics);
+    int num_moves = level_refiner->numPerformedMoves();
     UncontractionGainChanges no_changes;
     no_changes.representative.push_back(0);
     no_changes.contraction_partner.push_back(0);
 
     int iteration = 1;
     while ((iteration < _config.local_search.iterations_per_level) && improvement_found) {
-      improvement_found = performLocalSearchIteration(refiner, refinement_nodes, no_changes,
+      improvement_found = performLocalSearchIteration(*level_refiner, refinement_nodes, no_changes,
                                                       current_metrics);
+      num_moves += level_refiner->numPerformedMoves();
       ++iteration;
     }
+    if (has_deadline) {
+      const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+      _refinement_scheduler.update(std::chrono::duration<double>(end - start).count(), num_moves);
+    }
   }
 
   bool performLocalSearchIteration(IRefiner& refiner,
@@ -178,5 +345,8 @@ class CoarsenerBase {
   std::vector<CoarseningMemento> _history;
   std::vector<CurrentMaxNodeWeight> _max_hn_weights;
   HypergraphPruner _hypergraph_pruner;
+  RefinementScheduler _refinement_scheduler;
+  // Label propagation refiner that replaces the configured refiner once time runs short.
+  std::unique_ptr<LPRefiner> _fallback_refiner;
 };
 }  // namespace kahypar
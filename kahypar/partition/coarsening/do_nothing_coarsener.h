@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <iostream>
 #include <string>
 
 #include "kahypar/definitions.h"
@@ -40,5 +41,7 @@ class DoNothingCoarsener final : public ICoarsener {
   void coarsenImpl(const HypernodeID) override final { }
   bool uncoarsenImpl(IRefiner&) override final { return false; }
   std::string policyStringImpl() const override final { return std::string(""); }
+  void writeSnapshotImpl(std::ostream&) const override final { }
+  bool readSnapshotImpl(std::istream&) override final { return true; }
 };
 }  // namespace kahypar
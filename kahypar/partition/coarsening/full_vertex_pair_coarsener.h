@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <iostream>
 #include <limits>
 #include <string>
 #include <utility>
@@ -34,17 +35,18 @@
 #include "kahypar/utils/stats.h"
 
 namespace kahypar {
-template <class Rater = Mandatory>
+template <class Rater = Mandatory,
+          class PrioQueue = ds::BinaryMaxHeap<HypernodeID, RatingType> >
 class FullVertexPairCoarsener final : public ICoarsener,
-                                      private VertexPairCoarsenerBase<>{
+                                      private VertexPairCoarsenerBase<PrioQueue>{
  private:
-  using Base = VertexPairCoarsenerBase;
+  using Base = VertexPairCoarsenerBase<PrioQueue>;
   using Rating = typename Rater::Rating;
 
  public:
   FullVertexPairCoarsener(Hypergraph& hypergraph, const Configuration& config,
                           const HypernodeWeight weight_of_heaviest_node) :
-    VertexPairCoarsenerBase(hypergraph, config, weight_of_heaviest_node),
+    Base(hypergraph, config, weight_of_heaviest_node),
     _rater(_hg, _config),
     _target(hypergraph.initialNumNodes()) { }
 
@@ -99,14 +101,26 @@ class FullVertexPairCoarsener final : public ICoarsener,
 
       reRateAffectedHypernodes(rep_node, rerated_hypernodes, invalid_hypernodes);
     }
+    // The full coarsener does not work in passes. Thus batched parallel net detection
+    // is performed once on the coarsest hypergraph.
+    removeParallelHyperedgesOfPass();
   }
 
   bool uncoarsenImpl(IRefiner& refiner) override final {
     return doUncoarsen(refiner);
   }
 
+  void writeSnapshotImpl(std::ostream& out) const override final {
+    writeCoarseningState(out);
+  }
+
+  bool readSnapshotImpl(std::istream& in) override final {
+    return readCoarseningState(in);
+  }
+
   std::string policyStringImpl() const override final {
-    return std::string(" ratingFunction=" + meta::templateToString<Rater>());
+    return std::string(" ratingFunction=" + meta::templateToString<Rater>() +
+                       " ratingPQ=" + meta::templateToString<PrioQueue>());
   }
 
 
@@ -151,6 +165,12 @@ class FullVertexPairCoarsener final : public ICoarsener,
     }
   }
 
+  using Base::rateAllHypernodes;
+  using Base::performContraction;
+  using Base::removeParallelHyperedgesOfPass;
+  using Base::doUncoarsen;
+  using Base::writeCoarseningState;
+  using Base::readCoarseningState;
   using Base::_pq;
   using Base::_hg;
   using Base::_config;
@@ -27,6 +27,7 @@
 #include "kahypar/datastructure/sparse_map.h"
 #include "kahypar/definitions.h"
 #include "kahypar/macros.h"
+#include "kahypar/partition/coarsening/sampled_rating.h"
 #include "kahypar/partition/configuration.h"
 #include "kahypar/partition/preprocessing/louvain.h"
 #include "kahypar/partition/preprocessing/quality_measure.h"
@@ -85,14 +86,21 @@ class HeavyEdgeRater {
     DBG(dbg_partition_rating, "Calculating rating for HN " << u);
     const HypernodeWeight weight_u = _hg.nodeWeight(u);
     const PartitionID part_u = _hg.partID(u);
+    const auto add_score = [&](const HypernodeID v, const RatingType score) {
+                             if (v != u && _comm[u] == _comm[v] &&
+                                 belowThresholdNodeWeight(weight_u, _hg.nodeWeight(v)) &&
+                                 (part_u == _hg.partID(v))) {
+                               _tmp_ratings[v] += score;
+                             }
+                           };
     for (const HyperedgeID he : _hg.incidentEdges(u)) {
       ASSERT(_hg.edgeSize(he) > 1, V(he));
-      const RatingType score = static_cast<RatingType>(_hg.edgeWeight(he)) / (_hg.edgeSize(he) - 1);
-      for (const HypernodeID v : _hg.pins(he)) {
-        if (v != u && _comm[u] == _comm[v] &&
-            belowThresholdNodeWeight(weight_u, _hg.nodeWeight(v)) &&
-            (part_u == _hg.partID(v))) {
-          _tmp_ratings[v] += score;
+      if (rating::isSampled(_hg, he, _config)) {
+        rating::forEachSampledPin<RatingType>(_hg, u, he, _config, add_score);
+      } else {
+        const RatingType score = static_cast<RatingType>(_hg.edgeWeight(he)) / (_hg.edgeSize(he) - 1);
+        for (const HypernodeID v : _hg.pins(he)) {
+          add_score(v, score);
         }
       }
     }
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <algorithm>
+#include <iostream>
 #include <limits>
 #include <string>
 #include <vector>
@@ -29,6 +30,7 @@
 #include "kahypar/definitions.h"
 #include "kahypar/partition/coarsening/coarsening_memento.h"
 #include "kahypar/utils/math.h"
+#include "kahypar/utils/serialization.h"
 #include "kahypar/utils/stats.h"
 
 namespace kahypar {
@@ -57,11 +59,13 @@ class HypergraphPruner {
   static constexpr HyperedgeID kInvalidID = std::numeric_limits<HyperedgeID>::max();
 
  public:
-  explicit HypergraphPruner(const HypernodeID max_num_nodes) :
+  HypergraphPruner(const HypernodeID max_num_nodes, const HyperedgeID max_num_edges) :
     _removed_single_node_hyperedges(),
     _removed_parallel_hyperedges(),
     _fingerprints(),
-    _contained_hypernodes(max_num_nodes) { }
+    _contained_hypernodes(max_num_nodes),
+    _pass_representatives(),
+    _fingerprinted_hyperedges(max_num_edges) { }
 
   HypergraphPruner(const HypergraphPruner&) = delete;
   HypergraphPruner& operator= (const HypergraphPruner&) = delete;
@@ -136,6 +140,47 @@ class HypergraphPruner {
     memento.parallel_hes_begin = _removed_parallel_hyperedges.size();
 
     createFingerprints(hypergraph, memento.contraction_memento.u, memento.contraction_memento.v);
+    const HyperedgeID removed_parallel_hes = removeParallelHyperedgesWithEqualFingerprints(
+      hypergraph, memento);
+
+    ASSERT([&]() {
+        for (auto edge_it = hypergraph.incidentEdges(memento.contraction_memento.u).first;
+             edge_it != hypergraph.incidentEdges(memento.contraction_memento.u).second; ++edge_it) {
+          _contained_hypernodes.reset();
+          for (const HypernodeID pin : hypergraph.pins(*edge_it)) {
+            _contained_hypernodes.set(pin, 1);
+          }
+
+          for (auto next_edge_it = edge_it + 1;
+               next_edge_it != hypergraph.incidentEdges(memento.contraction_memento.u).second;
+               ++next_edge_it) {
+            // size check is necessary. Otherwise we might iterate over the pins of a small HE that
+            // is completely contained in a larger one and think that both are parallel.
+            if (hypergraph.edgeSize(*edge_it) == hypergraph.edgeSize(*next_edge_it)) {
+              bool parallel = true;
+              for (const HypernodeID pin :  hypergraph.pins(*next_edge_it)) {
+                parallel &= _contained_hypernodes[pin];
+              }
+              if (parallel) {
+                hypergraph.printEdgeState(*edge_it);
+                hypergraph.printEdgeState(*next_edge_it);
+                return false;
+              }
+            }
+          }
+        }
+        return true;
+      } (), "parallel HE removal failed");
+
+
+    return removed_parallel_hes;
+  }
+
+  // Sorts the current fingerprints according to their hash value and removes all hyperedges
+  // that are parallel to a hyperedge with the same fingerprint. The removed hyperedges are
+  // attributed to the given memento.
+  HyperedgeID removeParallelHyperedgesWithEqualFingerprints(Hypergraph& hypergraph,
+                                                           CoarseningMemento& memento) {
     std::sort(_fingerprints.begin(), _fingerprints.end(),
               [](const Fingerprint& a, const Fingerprint& b) { return a.hash < b.hash; });
 
@@ -149,7 +194,7 @@ class HypergraphPruner {
       } ());
 
     size_t i = 0;
-    HyperedgeWeight removed_parallel_hes = 0;
+    HyperedgeID removed_parallel_hes = 0;
     bool filled_probe_bitset = false;
     while (i < _fingerprints.size()) {
       size_t j = i + 1;
@@ -185,38 +230,6 @@ class HypergraphPruner {
       filled_probe_bitset = false;
       ++i;
     }
-
-
-    ASSERT([&]() {
-        for (auto edge_it = hypergraph.incidentEdges(memento.contraction_memento.u).first;
-             edge_it != hypergraph.incidentEdges(memento.contraction_memento.u).second; ++edge_it) {
-          _contained_hypernodes.reset();
-          for (const HypernodeID pin : hypergraph.pins(*edge_it)) {
-            _contained_hypernodes.set(pin, 1);
-          }
-
-          for (auto next_edge_it = edge_it + 1;
-               next_edge_it != hypergraph.incidentEdges(memento.contraction_memento.u).second;
-               ++next_edge_it) {
-            // size check is necessary. Otherwise we might iterate over the pins of a small HE that
-            // is completely contained in a larger one and think that both are parallel.
-            if (hypergraph.edgeSize(*edge_it) == hypergraph.edgeSize(*next_edge_it)) {
-              bool parallel = true;
-              for (const HypernodeID pin :  hypergraph.pins(*next_edge_it)) {
-                parallel &= _contained_hypernodes[pin];
-              }
-              if (parallel) {
-                hypergraph.printEdgeState(*edge_it);
-                hypergraph.printEdgeState(*next_edge_it);
-                return false;
-              }
-            }
-          }
-        }
-        return true;
-      } (), "parallel HE removal failed");
-
-
     return removed_parallel_hes;
   }
 
@@ -256,31 +269,82 @@ class HypergraphPruner {
   void createFingerprints(Hypergraph& hypergraph, const HypernodeID u, const HypernodeID v) {
     _fingerprints.clear();
     for (const HyperedgeID he : hypergraph.incidentEdges(u)) {
-      if (hypergraph.edgeContractionType(he) == Hypergraph::ContractionType::Case2) {
-        hypergraph.edgeHash(he) -= math::hash(v);
-        hypergraph.edgeHash(he) += math::hash(u);
-      } else if (hypergraph.edgeContractionType(he) == Hypergraph::ContractionType::Case1) {
-        hypergraph.edgeHash(he) -= math::hash(v);
-      }
-      hypergraph.resetEdgeContractionType(he);
-      ASSERT([&]() {
-          size_t correct_hash = 42;
-          for (const HypernodeID pin : hypergraph.pins(he)) {
-            correct_hash += math::hash(pin);
-          }
-          if (correct_hash != hypergraph.edgeHash(he)) {
-            LOGVAR(correct_hash);
-            LOGVAR(hypergraph.edgeHash(he));
-            return false;
-          }
-          return true;
-        } (), V(he));
+      updateFingerprint(hypergraph, he, u, v);
       DBG(dbg_coarsening_fingerprinting, "Fingerprint for HE " << he
           << "= {" << he << "," << hypergraph.edgeHash(he) << "," << hypergraph.edgeSize(he) << "}");
       _fingerprints.emplace_back(he, hypergraph.edgeHash(he));
     }
   }
 
+  // Batched parallel hyperedge detection: Instead of fingerprinting all hyperedges incident
+  // to the representative after each contraction, we only keep the hashes of the affected
+  // hyperedges up to date and remember the representative. The parallel hyperedges are then
+  // removed once per coarsening pass via removeParallelHyperedgesOfPass.
+  void updateFingerprints(Hypergraph& hypergraph, const CoarseningMemento& memento) {
+    const HypernodeID u = memento.contraction_memento.u;
+    for (const HyperedgeID he : hypergraph.incidentEdges(u)) {
+      updateFingerprint(hypergraph, he, u, memento.contraction_memento.v);
+    }
+    _pass_representatives.push_back(u);
+  }
+
+  // Each hyperedge that changed during the current pass contains at least one of the
+  // representatives that are still enabled. Since parallel hyperedges share all their pins,
+  // every hyperedge parallel to a changed hyperedge is therefore also incident to one of
+  // these representatives. Thus it is sufficient to fingerprint each hyperedge incident to
+  // these representatives exactly once. All removed hyperedges are attributed to the memento
+  // of the last contraction of the pass. Since this memento is the first one to be undone
+  // during uncoarsening, restoration works exactly as in the unbatched case.
+  // Fingerprinting and sorting are done sequentially: They take less than 10% of the
+  // coarsening time, whereas the verification has to remove hyperedges one at a time anyway.
+  HyperedgeID removeParallelHyperedgesOfPass(Hypergraph& hypergraph,
+                                             CoarseningMemento& memento) {
+    if (_pass_representatives.empty()) {
+      return 0;
+    }
+    ASSERT(memento.parallel_hes_size == 0, V(memento.parallel_hes_size));
+    memento.parallel_hes_begin = _removed_parallel_hyperedges.size();
+
+    _fingerprints.clear();
+    _fingerprinted_hyperedges.reset();
+    for (const HypernodeID rep : _pass_representatives) {
+      if (hypergraph.nodeIsEnabled(rep)) {
+        for (const HyperedgeID he : hypergraph.incidentEdges(rep)) {
+          if (!_fingerprinted_hyperedges[he]) {
+            _fingerprinted_hyperedges.set(he, true);
+            _fingerprints.emplace_back(he, hypergraph.edgeHash(he));
+          }
+        }
+      }
+    }
+    _pass_representatives.clear();
+
+    return removeParallelHyperedgesWithEqualFingerprints(hypergraph, memento);
+  }
+
+  void updateFingerprint(Hypergraph& hypergraph, const HyperedgeID he,
+                         const HypernodeID u, const HypernodeID v) {
+    if (hypergraph.edgeContractionType(he) == Hypergraph::ContractionType::Case2) {
+      hypergraph.edgeHash(he) -= math::hash(v);
+      hypergraph.edgeHash(he) += math::hash(u);
+    } else if (hypergraph.edgeContractionType(he) == Hypergraph::ContractionType::Case1) {
+      hypergraph.edgeHash(he) -= math::hash(v);
+    }
+    hypergraph.resetEdgeContractionType(he);
+    ASSERT([&]() {
+        size_t correct_hash = 42;
+        for (const HypernodeID pin : hypergraph.pins(he)) {
+          correct_hash += math::hash(pin);
+        }
+        if (correct_hash != hypergraph.edgeHash(he)) {
+          LOGVAR(correct_hash);
+          LOGVAR(hypergraph.edgeHash(he));
+          return false;
+        }
+        return true;
+      } (), V(he));
+  }
+
   const std::vector<ParallelHE> & removedParallelHyperedges() const {
     return _removed_parallel_hyperedges;
   }
@@ -289,10 +353,40 @@ class HypergraphPruner {
     return _removed_single_node_hyperedges;
   }
 
+  void writeRemovalLogs(std::ostream& out) const {
+    serialization::writeVector(out, _removed_single_node_hyperedges);
+    serialization::write(out, static_cast<uint64_t>(_removed_parallel_hyperedges.size()));
+    for (const ParallelHE& parallel_he : _removed_parallel_hyperedges) {
+      serialization::write(out, parallel_he.representative_id);
+      serialization::write(out, parallel_he.removed_id);
+    }
+  }
+
+  bool readRemovalLogs(std::istream& in) {
+    _removed_parallel_hyperedges.clear();
+    uint64_t num_parallel_hes = 0;
+    if (!serialization::readVector(in, _removed_single_node_hyperedges) ||
+        !serialization::read(in, num_parallel_hes)) {
+      return false;
+    }
+    _removed_parallel_hyperedges.reserve(num_parallel_hes);
+    for (uint64_t i = 0; i < num_parallel_hes; ++i) {
+      HyperedgeID representative = kInvalidID;
+      HyperedgeID removed = kInvalidID;
+      if (!serialization::read(in, representative) || !serialization::read(in, removed)) {
+        return false;
+      }
+      _removed_parallel_hyperedges.emplace_back(representative, removed);
+    }
+    return true;
+  }
+
  private:
   std::vector<HyperedgeID> _removed_single_node_hyperedges;
   std::vector<ParallelHE> _removed_parallel_hyperedges;
   std::vector<Fingerprint> _fingerprints;
   ds::FastResetFlagArray<uint64_t> _contained_hypernodes;
+  std::vector<HypernodeID> _pass_representatives;
+  ds::FastResetFlagArray<> _fingerprinted_hyperedges;
 };
 }  // namespace kahypar
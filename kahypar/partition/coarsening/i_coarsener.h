@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <iostream>
 #include <string>
 
 #include "kahypar/definitions.h"
@@ -47,6 +48,14 @@ class ICoarsener {
     return policyStringImpl();
   }
 
+  void writeSnapshot(std::ostream& out) const {
+    writeSnapshotImpl(out);
+  }
+
+  bool readSnapshot(std::istream& in) {
+    return readSnapshotImpl(in);
+  }
+
   virtual ~ICoarsener() { }
 
  protected:
@@ -56,5 +65,7 @@ class ICoarsener {
   virtual void coarsenImpl(const HypernodeID limit) = 0;
   virtual bool uncoarsenImpl(IRefiner& refiner) = 0;
   virtual std::string policyStringImpl() const = 0;
+  virtual void writeSnapshotImpl(std::ostream& out) const = 0;
+  virtual bool readSnapshotImpl(std::istream& in) = 0;
 };
 }  // namespace kahypar
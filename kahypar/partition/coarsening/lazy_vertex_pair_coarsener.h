@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <iostream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -33,11 +34,12 @@
 #include "kahypar/utils/stats.h"
 
 namespace kahypar {
-template <class Rater = Mandatory>
+template <class Rater = Mandatory,
+          class PrioQueue = ds::BinaryMaxHeap<HypernodeID, RatingType> >
 class LazyVertexPairCoarsener final : public ICoarsener,
-                                      private VertexPairCoarsenerBase<>{
+                                      private VertexPairCoarsenerBase<PrioQueue>{
  private:
-  using Base = VertexPairCoarsenerBase;
+  using Base = VertexPairCoarsenerBase<PrioQueue>;
   using Rating = typename Rater::Rating;
 
  public:
@@ -127,6 +129,7 @@ class LazyVertexPairCoarsener final : public ICoarsener,
           updatePQandContractionTarget(rep_node, _rater.rate(rep_node));
         }
       }
+      removeParallelHyperedgesOfPass(_rater);
       
       if (num_hns_before_pass == _hg.currentNumNodes()) {
           if(_config.preprocessing.use_louvain && !ignoreCommunities && !_config.preprocessing.only_community_contraction_allowed  && _hg.currentNumNodes() >= 2*limit) {
@@ -149,8 +152,17 @@ class LazyVertexPairCoarsener final : public ICoarsener,
     return Base::doUncoarsen(refiner);
   }
 
+  void writeSnapshotImpl(std::ostream& out) const override final {
+    Base::writeCoarseningState(out);
+  }
+
+  bool readSnapshotImpl(std::istream& in) override final {
+    return Base::readCoarseningState(in);
+  }
+
   std::string policyStringImpl() const override final {
-    return std::string(" ratingFunction=" + meta::templateToString<Rater>());
+    return std::string(" ratingFunction=" + meta::templateToString<Rater>() +
+                       " ratingPQ=" + meta::templateToString<PrioQueue>());
   }
 
   void invalidateAffectedHypernodes(const HypernodeID rep_node) {
@@ -182,10 +194,14 @@ class LazyVertexPairCoarsener final : public ICoarsener,
     }
   }
 
+  using Base::rateAllHypernodes;
+  using Base::performContraction;
+  using Base::removeParallelHyperedgesOfPass;
   using Base::_pq;
   using Base::_hg;
   using Base::_config;
   using Base::_history;
+  using Base::_hypergraph_pruner;
   Rater _rater;
   ds::FastResetFlagArray<> _outdated_rating;
   std::vector<HypernodeID> _target;
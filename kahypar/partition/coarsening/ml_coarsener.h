@@ -20,8 +20,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iostream>
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 #include <set>
 
@@ -30,6 +33,7 @@
 #include "kahypar/definitions.h"
 #include "kahypar/macros.h"
 #include "kahypar/partition/coarsening/policies/rating_tie_breaking_policy.h"
+#include "kahypar/partition/coarsening/sampled_rating.h"
 #include "kahypar/partition/preprocessing/louvain.h"
 #include "kahypar/partition/preprocessing/quality_measure.h"
 
@@ -118,24 +122,7 @@ class MLCoarsener final : public ICoarsener,
             already_matched.set(hn, true);
             already_matched.set(rating.target, true);
             
-            performContraction(hn, rating.target);
-            if(_config.preprocessing.use_multilevel_louvain) {
-                _louvain.contractHypernodes(hn,rating.target);
-                size_t N = _hg.initialNumNodes();
-                int one_pin_hes_begin = _history.back().one_pin_hes_begin;
-                int one_pin_hes_size = _history.back().one_pin_hes_size;
-                for(int i = one_pin_hes_begin; i < one_pin_hes_begin+one_pin_hes_size; ++i) {
-                    _louvain.contractHypernodes(hn,N+_hypergraph_pruner.removedSingleNodeHyperedges()[i]);
-                }
-                
-                int parallel_hes_begin = _history.back().parallel_hes_begin;
-                int parallel_hes_size = _history.back().parallel_hes_size;
-                for(int i = parallel_hes_begin; i < parallel_hes_begin+parallel_hes_size; ++i) {
-                    _louvain.contractHypernodes(N+_hypergraph_pruner.removedParallelHyperedges()[i].representative_id,
-                                                  N+_hypergraph_pruner.removedParallelHyperedges()[i].removed_id);
-                }
-            }
-            
+            contract(hn, rating.target);
           }
 
           if (_hg.currentNumNodes() <= limit) {
@@ -143,6 +130,20 @@ class MLCoarsener final : public ICoarsener,
           }
         }
       }
+      // If the matching stalls (e.g., because leaves of star-like neighborhoods cannot be
+      // contracted with their heavy center), unmatched hypernodes are contracted with
+      // each other to ensure that each pass at least halves the number of hypernodes.
+      if (2 * (num_hns_before_pass - _hg.currentNumNodes()) < num_hns_before_pass) {
+        if (_config.coarsening.two_hop_contraction && _hg.currentNumNodes() > limit) {
+          contractTwoHopNeighbors(current_hns, already_matched, limit);
+        }
+        if (_config.coarsening.community_cluster_contraction && _config.preprocessing.use_louvain &&
+            _hg.currentNumNodes() > limit) {
+          contractCommunityClusters(current_hns, already_matched, limit);
+        }
+      }
+
+      removeParallelHyperedgesOfPass(_louvain);
 
       if (num_hns_before_pass == _hg.currentNumNodes()) {
         if (_config.preprocessing.use_louvain) {
@@ -216,17 +217,179 @@ class MLCoarsener final : public ICoarsener,
       }
   }
 
+  void contract(const HypernodeID rep_node, const HypernodeID contracted_node) {
+    performContraction(rep_node, contracted_node);
+    if(_config.preprocessing.use_multilevel_louvain) {
+        _louvain.contractHypernodes(rep_node,contracted_node);
+        size_t N = _hg.initialNumNodes();
+        int one_pin_hes_begin = _history.back().one_pin_hes_begin;
+        int one_pin_hes_size = _history.back().one_pin_hes_size;
+        for(int i = one_pin_hes_begin; i < one_pin_hes_begin+one_pin_hes_size; ++i) {
+            _louvain.contractHypernodes(rep_node,N+_hypergraph_pruner.removedSingleNodeHyperedges()[i]);
+        }
+
+        int parallel_hes_begin = _history.back().parallel_hes_begin;
+        int parallel_hes_size = _history.back().parallel_hes_size;
+        for(int i = parallel_hes_begin; i < parallel_hes_begin+parallel_hes_size; ++i) {
+            _louvain.contractHypernodes(N+_hypergraph_pruner.removedParallelHyperedges()[i].representative_id,
+                                          N+_hypergraph_pruner.removedParallelHyperedges()[i].removed_id);
+        }
+    }
+  }
+
+  // Contracts pairs of unmatched hypernodes that share the same heaviest neighbor.
+  void contractTwoHopNeighbors(const std::vector<HypernodeID>& current_hns,
+                               ds::FastResetFlagArray<>& already_matched,
+                               const HypernodeID limit) {
+    std::vector<std::pair<HypernodeID, HypernodeID> > neighbor_and_hn;
+    for (const HypernodeID hn : current_hns) {
+      if (_hg.nodeIsEnabled(hn) && !already_matched[hn]) {
+        const HypernodeID neighbor = heaviestNeighbor(hn);
+        if (neighbor != kInvalidTarget) {
+          neighbor_and_hn.emplace_back(neighbor, hn);
+        }
+      }
+    }
+    // Hypernodes with the same heaviest neighbor are consecutive, while the
+    // (random) order of current_hns is kept within each group.
+    std::stable_sort(neighbor_and_hn.begin(), neighbor_and_hn.end(),
+                     [](const std::pair<HypernodeID, HypernodeID>& l,
+                        const std::pair<HypernodeID, HypernodeID>& r) {
+          return l.first < r.first;
+        });
+
+    size_t num_contractions = 0;
+    size_t group_begin = 0;
+    while (group_begin < neighbor_and_hn.size() && _hg.currentNumNodes() > limit) {
+      size_t group_end = group_begin + 1;
+      while (group_end < neighbor_and_hn.size() &&
+             neighbor_and_hn[group_end].first == neighbor_and_hn[group_begin].first) {
+        ++group_end;
+      }
+      num_contractions += contractUnmatchedGroup(neighbor_and_hn, group_begin, group_end,
+                                                 already_matched, limit);
+      group_begin = group_end;
+    }
+    Stats::instance().addToTotal(_config, "numTwoHopContractions", num_contractions);
+  }
+
+  // Contracts the unmatched hypernodes of each community into as few hypernodes as
+  // the maximum allowed node weight permits.
+  void contractCommunityClusters(const std::vector<HypernodeID>& current_hns,
+                                 ds::FastResetFlagArray<>& already_matched,
+                                 const HypernodeID limit) {
+    std::vector<std::pair<HypernodeID, HypernodeID> > comm_and_hn;
+    for (const HypernodeID hn : current_hns) {
+      if (_hg.nodeIsEnabled(hn) && !already_matched[hn]) {
+        comm_and_hn.emplace_back(_comm[hn], hn);
+      }
+    }
+    std::stable_sort(comm_and_hn.begin(), comm_and_hn.end(),
+                     [](const std::pair<HypernodeID, HypernodeID>& l,
+                        const std::pair<HypernodeID, HypernodeID>& r) {
+          return l.first < r.first;
+        });
+
+    size_t num_contractions = 0;
+    size_t group_begin = 0;
+    while (group_begin < comm_and_hn.size() && _hg.currentNumNodes() > limit) {
+      size_t group_end = group_begin + 1;
+      while (group_end < comm_and_hn.size() &&
+             comm_and_hn[group_end].first == comm_and_hn[group_begin].first) {
+        ++group_end;
+      }
+      // Each hypernode of the community is contracted into the current representative
+      // until the representative becomes too heavy.
+      HypernodeID rep_node = kInvalidTarget;
+      for (size_t i = group_begin; i < group_end && _hg.currentNumNodes() > limit; ++i) {
+        const HypernodeID hn = comm_and_hn[i].second;
+        if (rep_node != kInvalidTarget && _hg.partID(rep_node) == _hg.partID(hn) &&
+            belowThresholdNodeWeight(_hg.nodeWeight(rep_node), _hg.nodeWeight(hn))) {
+          contract(rep_node, hn);
+          ++num_contractions;
+        } else {
+          rep_node = hn;
+        }
+        already_matched.set(hn, true);
+      }
+      group_begin = group_end;
+    }
+    Stats::instance().addToTotal(_config, "numCommunityClusterContractions", num_contractions);
+  }
+
+  // Greedily contracts pairs of hypernodes of the range [begin, end) of the group.
+  size_t contractUnmatchedGroup(const std::vector<std::pair<HypernodeID, HypernodeID> >& group,
+                                const size_t begin, const size_t end,
+                                ds::FastResetFlagArray<>& already_matched,
+                                const HypernodeID limit) {
+    size_t num_contractions = 0;
+    for (size_t i = begin; i < end && _hg.currentNumNodes() > limit; ++i) {
+      const HypernodeID u = group[i].second;
+      if (already_matched[u]) {
+        continue;
+      }
+      for (size_t j = i + 1; j < end; ++j) {
+        const HypernodeID v = group[j].second;
+        if (!already_matched[v] && _comm[u] == _comm[v] && _hg.partID(u) == _hg.partID(v) &&
+            belowThresholdNodeWeight(_hg.nodeWeight(u), _hg.nodeWeight(v))) {
+          already_matched.set(u, true);
+          already_matched.set(v, true);
+          contract(u, v);
+          ++num_contractions;
+          break;
+        }
+      }
+    }
+    return num_contractions;
+  }
+
+  // Returns the neighbor with the highest heavy edge score regardless of its weight.
+  HypernodeID heaviestNeighbor(const HypernodeID u) {
+    const auto add_score = [&](const HypernodeID v, const RatingType score) {
+                             if (v != u && _hg.partID(u) == _hg.partID(v)) {
+                               _tmp_ratings[v] += score;
+                             }
+                           };
+    for (const HyperedgeID he : _hg.incidentEdges(u)) {
+      if (rating::isSampled(_hg, he, _config)) {
+        rating::forEachSampledPin<RatingType>(_hg, u, he, _config, add_score);
+      } else if (_hg.edgeSize(he) <= _config.partition.hyperedge_size_threshold) {
+        const RatingType score = static_cast<RatingType>(_hg.edgeWeight(he)) / (_hg.edgeSize(he) - 1);
+        for (const HypernodeID v : _hg.pins(he)) {
+          add_score(v, score);
+        }
+      }
+    }
+    RatingType max_rating = std::numeric_limits<RatingType>::min();
+    HypernodeID neighbor = kInvalidTarget;
+    for (const auto& element : _tmp_ratings) {
+      if (max_rating < element.value ||
+          (max_rating == element.value && element.key < neighbor)) {
+        max_rating = element.value;
+        neighbor = element.key;
+      }
+    }
+    _tmp_ratings.clear();
+    return neighbor;
+  }
+
   Rating contractionPartner(const HypernodeID u, const ds::FastResetFlagArray<>& already_matched) {
     DBG(dbg_partition_rating, "Calculating rating for HN " << u);
     const HypernodeWeight weight_u = _hg.nodeWeight(u);
+    const auto add_score = [&](const HypernodeID v, const RatingType score) {
+                             if ((v != u && belowThresholdNodeWeight(weight_u, _hg.nodeWeight(v)))) {
+                               _tmp_ratings[v] += score;
+                             }
+                           };
     for (const HyperedgeID he : _hg.incidentEdges(u)) {
       ASSERT(_hg.edgeSize(he) > 1, V(he));
-      if (_hg.edgeSize(he) <= _config.partition.hyperedge_size_threshold) {
+      if (rating::isSampled(_hg, he, _config)) {
+        // Large hyperedges are sampled instead of being skipped.
+        rating::forEachSampledPin<RatingType>(_hg, u, he, _config, add_score);
+      } else if (_hg.edgeSize(he) <= _config.partition.hyperedge_size_threshold) {
         const RatingType score = static_cast<RatingType>(_hg.edgeWeight(he)) / (_hg.edgeSize(he) - 1);
         for (const HypernodeID v : _hg.pins(he)) {
-          if ((v != u && belowThresholdNodeWeight(weight_u, _hg.nodeWeight(v)))) {
-            _tmp_ratings[v] += score;
-          }
+          add_score(v, score);
         }
       }
     }
@@ -301,6 +464,14 @@ class MLCoarsener final : public ICoarsener,
     return doUncoarsen(refiner);
   }
 
+  void writeSnapshotImpl(std::ostream& out) const override final {
+    writeCoarseningState(out);
+  }
+
+  bool readSnapshotImpl(std::istream& in) override final {
+    return readCoarseningState(in);
+  }
+
   std::string policyStringImpl() const override final {
     return std::string("");
   }
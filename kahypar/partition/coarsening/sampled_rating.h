@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "kahypar/definitions.h"
+#include "kahypar/macros.h"
+#include "kahypar/partition/configuration.h"
+
+namespace kahypar {
+namespace rating {
+// Returns true if only a sample of the pins of hyperedge he should be rated.
+static inline bool isSampled(const Hypergraph& hypergraph, const HyperedgeID he,
+                             const Configuration& config) {
+  return config.coarsening.rating_sample_size > 0 &&
+         hypergraph.edgeSize(he) > config.coarsening.rating_sample_size;
+}
+
+// Calls f(v, score) for rating_sample_size pins v of hyperedge he.
+// The pins are chosen via systematic sampling: Starting at an offset that
+// is derived from u and he, every (|he| / sample_size)-th pin is visited.
+// Since each pin is visited with probability sample_size / |he|, the score
+// w(he) / (|he| - 1) is rescaled by |he| / sample_size in order to keep the
+// expected rating of each pair unchanged.
+// The sample is deterministic as long as the pin order of he does not change,
+// i.e., rating the same hypernode twice yields the same result.
+template <typename RatingType, typename F>
+static inline void forEachSampledPin(const Hypergraph& hypergraph, const HypernodeID u,
+                                     const HyperedgeID he, const Configuration& config,
+                                     const F& f) {
+  ASSERT(isSampled(hypergraph, he, config), V(he));
+  const uint64_t edge_size = hypergraph.edgeSize(he);
+  const uint64_t sample_size = config.coarsening.rating_sample_size;
+  const RatingType score = static_cast<RatingType>(hypergraph.edgeWeight(he)) /
+                           (edge_size - 1) * edge_size / sample_size;
+  const uint64_t offset = (static_cast<uint64_t>(u) * 0x9E3779B97F4A7C15ULL + he) % edge_size;
+  const auto first_pin = hypergraph.pins(he).first;
+  for (uint64_t i = 0; i < sample_size; ++i) {
+    f(*(first_pin + (offset + (i * edge_size) / sample_size) % edge_size), score);
+  }
+}
+}  // namespace rating
+}  // namespace kahypar
@@ -98,37 +98,61 @@ class VertexPairCoarsenerBase : public CoarsenerBase {
 
 
     initializeRefiner(refiner);
-    std::vector<HypernodeID> refinement_nodes(2, 0);
+    std::vector<HypernodeID> refinement_nodes;
+    refinement_nodes.reserve(2 * _config.local_search.uncontraction_batch_size);
     UncontractionGainChanges changes;
     changes.representative.push_back(0);
     changes.contraction_partner.push_back(0);
+    UncontractionGainChanges batch_changes;
     while (!_history.empty()) {
-      restoreParallelHyperedges();
-      restoreSingleNodeHyperedges();
-
-      DBG(dbg_coarsening_uncoarsen, "Uncontracting: (" << _history.back().contraction_memento.u << ","
-          << _history.back().contraction_memento.v << ")");
-
       refinement_nodes.clear();
-      refinement_nodes.push_back(_history.back().contraction_memento.u);
-      refinement_nodes.push_back(_history.back().contraction_memento.v);
+      batch_changes.representative.clear();
+      batch_changes.contraction_partner.clear();
+
+      // Up to uncontraction_batch_size contractions are undone before local search is
+      // started. refinement_nodes[2 * i] and refinement_nodes[2 * i + 1] are the
+      // representative and the contraction partner of the i-th uncontraction and
+      // the i-th entries of batch_changes contain the corresponding gain changes.
+      for (HypernodeID i = 0; i < _config.local_search.uncontraction_batch_size &&
+           !_history.empty(); ++i) {
+        restoreParallelHyperedges();
+        restoreSingleNodeHyperedges();
+
+        DBG(dbg_coarsening_uncoarsen, "Uncontracting: (" << _history.back().contraction_memento.u << ","
+            << _history.back().contraction_memento.v << ")");
+
+        refinement_nodes.push_back(_history.back().contraction_memento.u);
+        refinement_nodes.push_back(_history.back().contraction_memento.v);
+
+        if (_hg.currentNumNodes() > _max_hn_weights.back().num_nodes) {
+          _max_hn_weights.pop_back();
+        }
 
-      if (_hg.currentNumNodes() > _max_hn_weights.back().num_nodes) {
-        _max_hn_weights.pop_back();
+        switch (_config.local_search.algorithm) {
+          case RefinementAlgorithm::twoway_fm:
+            _hg.uncontract(_history.back().contraction_memento, changes,
+                           meta::Int2Type<static_cast<int>(RefinementAlgorithm::twoway_fm)>());
+            break;
+          default:
+            _hg.uncontract(_history.back().contraction_memento);
+        }
+        batch_changes.representative.push_back(changes.representative[0]);
+        batch_changes.contraction_partner.push_back(changes.contraction_partner[0]);
+        changes.representative[0] = 0;
+        changes.contraction_partner[0] = 0;
+        _history.pop_back();
       }
 
-      switch (_config.local_search.algorithm) {
-        case RefinementAlgorithm::twoway_fm:
-          _hg.uncontract(_history.back().contraction_memento, changes,
-                         meta::Int2Type<static_cast<int>(RefinementAlgorithm::twoway_fm)>());
-          break;
-        default:
-          _hg.uncontract(_history.back().contraction_memento);
+      // 2-way FM needs the pairwise layout of refinement_nodes to update its gain
+      // cache and removes duplicates itself. All other refiners expect each
+      // hypernode to be contained at most once.
+      if (refinement_nodes.size() > 2 &&
+          _config.local_search.algorithm != RefinementAlgorithm::twoway_fm) {
+        std::sort(refinement_nodes.begin(), refinement_nodes.end());
+        refinement_nodes.erase(std::unique(refinement_nodes.begin(), refinement_nodes.end()),
+                               refinement_nodes.end());
       }
-      performLocalSearch(refiner, refinement_nodes, current_metrics, changes);
-      changes.representative[0] = 0;
-      changes.contraction_partner[0] = 0;
-      _history.pop_back();
+      performLocalSearch(refiner, refinement_nodes, current_metrics, batch_changes);
     }
 
     // This currently cannot be guaranteed for RB-partitioning and k != 2^x, since it might be
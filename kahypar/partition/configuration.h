@@ -126,6 +126,19 @@ struct CoarseningParameters {
   CoarseningAlgorithm algorithm = CoarseningAlgorithm::heavy_lazy;
   HypernodeID contraction_limit_multiplier = 160;
   double max_allowed_weight_multiplier = 3.25;
+  // If true, parallel nets are detected once per coarsening pass instead of
+  // after every single contraction.
+  bool batch_parallel_net_detection = false;
+  // If > 0, only this many pins of larger hyperedges are considered when rating
+  // hypernodes (with rescaled scores) instead of visiting (or skipping) all pins.
+  HypernodeID rating_sample_size = 0;
+  // Fallback contractions of the ML coarsener for passes that do not halve the
+  // number of hypernodes: Unmatched hypernodes sharing the same heaviest neighbor
+  // and/or unmatched hypernodes of the same community are contracted.
+  bool two_hop_contraction = false;
+  bool community_cluster_contraction = false;
+  // If set, the coarsening result is read from/written to this file (direct k-way only).
+  std::string snapshot_filename = "";
 
   HypernodeWeight max_allowed_node_weight = 0;
   HypernodeID contraction_limit = 0;
@@ -137,6 +150,18 @@ inline std::ostream& operator<< (std::ostream& str, const CoarseningParameters&
   str << "  Algorithm:                          " << toString(params.algorithm) << std::endl;
   str << "  max-allowed-weight-multiplier:      " << params.max_allowed_weight_multiplier << std::endl;
   str << "  contraction-limit-multiplier:       " << params.contraction_limit_multiplier << std::endl;
+  str << "  batch parallel net detection:       " << std::boolalpha
+  << params.batch_parallel_net_detection << std::endl;
+  str << "  two-hop contraction:                " << std::boolalpha
+  << params.two_hop_contraction << std::endl;
+  str << "  community cluster contraction:      " << std::boolalpha
+  << params.community_cluster_contraction << std::endl;
+  if (params.rating_sample_size != 0) {
+    str << "  rating sample size:                 " << params.rating_sample_size << std::endl;
+  }
+  if (!params.snapshot_filename.empty()) {
+    str << "  snapshot file:                      " << params.snapshot_filename << std::endl;
+  }
   if (params.hypernode_weight_fraction != 0.0) {
     str << "  hypernode weight fraction:          " << params.hypernode_weight_fraction << std::endl;
   }
@@ -155,31 +180,54 @@ struct LocalSearchParameters {
     double adaptive_stopping_alpha = 1.0;
     RefinementStoppingRule stopping_rule = RefinementStoppingRule::simple;
     GlobalRebalancingMode global_rebalancing = GlobalRebalancingMode::off;
+    // kway_fm and kway_fm_km1 use a sparse gain cache for k >= sparse_gain_cache_min_k.
+    PartitionID sparse_gain_cache_min_k = 128;
+    GainQueueType gain_queue = GainQueueType::heap;
   };
 
   struct Sclap {
     int max_number_iterations = std::numeric_limits<int>::max();
+    // Makes the parallel label propagation independent of thread scheduling.
+    bool deterministic = false;
   };
 
   LocalSearchParameters() :
     fm(),
     sclap(),
     algorithm(RefinementAlgorithm::kway_fm),
-    iterations_per_level(std::numeric_limits<int>::max()) { }
+    iterations_per_level(std::numeric_limits<int>::max()),
+    uncontraction_batch_size(1),
+    num_threads(1) { }
 
   FM fm;
   Sclap sclap;
   RefinementAlgorithm algorithm;
   int iterations_per_level;
+  // Number of contractions that are undone before local search is started
+  // on the union of all restored hypernodes. kway_fm_km1_parallel only refines
+  // batches with at least 16 border nodes per thread in parallel.
+  HypernodeID uncontraction_batch_size;
+  // Number of threads used by the parallel refinement algorithms and to initialize
+  // the gain caches of the k-way FM and label propagation refiners.
+  unsigned int num_threads;
 };
 
 inline std::ostream& operator<< (std::ostream& str, const LocalSearchParameters& params) {
   str << "Local Search Parameters:" << std::endl;
   str << "  Algorithm:                          " << toString(params.algorithm) << std::endl;
   str << "  iterations per level:               " << params.iterations_per_level << std::endl;
+  str << "  uncontraction batch size:           " << params.uncontraction_batch_size << std::endl;
+  if (params.algorithm == RefinementAlgorithm::kway_fm ||
+      params.algorithm == RefinementAlgorithm::kway_fm_km1 ||
+      params.algorithm == RefinementAlgorithm::kway_fm_km1_parallel ||
+      params.algorithm == RefinementAlgorithm::label_propagation ||
+      params.algorithm == RefinementAlgorithm::label_propagation_parallel) {
+    str << "  # threads:                          " << params.num_threads << std::endl;
+  }
   if (params.algorithm == RefinementAlgorithm::twoway_fm ||
       params.algorithm == RefinementAlgorithm::kway_fm ||
-      params.algorithm == RefinementAlgorithm::kway_fm_km1) {
+      params.algorithm == RefinementAlgorithm::kway_fm_km1 ||
+      params.algorithm == RefinementAlgorithm::kway_fm_km1_parallel) {
     str << "  stopping rule:                      " << toString(params.fm.stopping_rule) << std::endl;
     if (params.fm.stopping_rule == RefinementStoppingRule::simple) {
       str << "  max. # fruitless moves:             " << params.fm.max_number_of_fruitless_moves << std::endl;
@@ -187,8 +235,15 @@ inline std::ostream& operator<< (std::ostream& str, const LocalSearchParameters&
       str << "  adaptive stopping alpha:            " << params.fm.adaptive_stopping_alpha << std::endl;
     }
     str << "  use global rebalancing:             " << toString(params.fm.global_rebalancing) << std::endl;
-  } else if (params.algorithm == RefinementAlgorithm::label_propagation) {
+    str << "  sparse gain cache for k >=          " << params.fm.sparse_gain_cache_min_k << std::endl;
+    str << "  gain queue:                         " << toString(params.fm.gain_queue) << std::endl;
+  } else if (params.algorithm == RefinementAlgorithm::label_propagation ||
+             params.algorithm == RefinementAlgorithm::label_propagation_parallel) {
     str << "  max. # iterations:                  " << params.sclap.max_number_iterations << std::endl;
+    if (params.algorithm == RefinementAlgorithm::label_propagation_parallel) {
+      str << "  deterministic:                      " << std::boolalpha
+          << params.sclap.deterministic << std::endl;
+    }
   } else if (params.algorithm == RefinementAlgorithm::do_nothing) {
     str << "  no coarsening!  " << std::endl;
   }
@@ -210,6 +265,11 @@ struct InitialPartitioningParameters {
     unassigned_part(1),
     init_alpha(1.0),
     pool_type(1975),
+    pool_num_threads(1),
+    pool_adaptive(false),
+    pool_warmup_runs(2),
+    greedy_rebalancing(false),
+    gain_queue(GainQueueType::heap),
     lp_max_iteration(100),
     lp_assign_vertex_to_part(5),
     refinement(true) {
@@ -246,6 +306,18 @@ struct InitialPartitioningParameters {
   // If pool initial partitioner is used, the first 12 bits of this number decides
   // which algorithms are used.
   unsigned int pool_type = 1975;
+  // Number of threads used by the pool initial partitioner to run its algorithms.
+  unsigned int pool_num_threads = 1;
+  // If set, the pool initial partitioner prunes algorithms that perform badly
+  // after pool_warmup_runs runs each and spends the remaining runs on the others.
+  bool pool_adaptive = false;
+  int pool_warmup_runs = 2;
+  // If set, an imbalanced initial partition is first repaired by greedily moving
+  // hypernodes out of overloaded blocks before initial partitioning is restarted.
+  bool greedy_rebalancing = false;
+  // Priority queue used by the greedy hypergraph growing algorithms. Their gains
+  // are bounded integers, so bucket queues can be used instead of binary heaps.
+  GainQueueType gain_queue = GainQueueType::heap;
   // Maximum iterations of the Label Propagation IP over all hypernodes
   int lp_max_iteration = 100;
   // Amount of hypernodes which are assigned around each start vertex (LP)
@@ -260,6 +332,17 @@ inline std::ostream& operator<< (std::ostream& str, const InitialPartitioningPar
   str << "  Mode:                               " << toString(params.mode) << std::endl;
   str << "  Technique:                          " << toString(params.technique) << std::endl;
   str << "  Algorithm:                          " << toString(params.algo) << std::endl;
+  if (params.algo == InitialPartitionerAlgorithm::pool) {
+    str << "  # pool threads:                     " << params.pool_num_threads << std::endl;
+    str << "  adaptive pool:                      " << std::boolalpha << params.pool_adaptive
+    << std::endl;
+    if (params.pool_adaptive) {
+      str << "  # pool warm-up runs:                " << params.pool_warmup_runs << std::endl;
+    }
+  }
+  str << "  greedy rebalancing:                 " << std::boolalpha
+  << params.greedy_rebalancing << std::endl;
+  str << "  greedy gain queue:                  " << toString(params.gain_queue) << std::endl;
   str << "IP Coarsening:                        " << std::endl;
   str << params.coarsening;
   str << "IP Local Search:                      " << std::endl;
@@ -287,6 +370,9 @@ struct PartitioningParameters {
                        std::numeric_limits<HypernodeWeight>::max() }),
     total_graph_weight(0),
     hyperedge_size_threshold(std::numeric_limits<HypernodeID>::max()),
+    time_limit(0.0),
+    deadline(HighResClockTimepoint::max()),
+    rb_num_threads(1),
     verbose_output(false),
     collect_stats(false),
     graph_filename(),
@@ -305,6 +391,15 @@ struct PartitioningParameters {
   std::array<HypernodeWeight, 2> max_part_weights;
   HypernodeWeight total_graph_weight;
   HyperedgeID hyperedge_size_threshold;
+  // Time limit in seconds (0 = unlimited). The partitioner derives the deadline
+  // from it, which bounds the time spent in local search. Coarsening and initial
+  // partitioning are not bounded by the deadline.
+  double time_limit;
+  HighResClockTimepoint deadline;
+  // Number of threads used for recursive bisection. If more than one thread is used,
+  // the two subproblems of each bisection are solved concurrently and each subproblem
+  // is seeded by its parent. Thus the partition does not depend on the scheduling.
+  unsigned int rb_num_threads;
 
   bool verbose_output;
   bool collect_stats;
@@ -324,6 +419,12 @@ inline std::ostream& operator<< (std::ostream& str, const PartitioningParameters
   str << "  seed:                               " << params.seed << std::endl;
   str << "  # V-cycles:                         " << params.global_search_iterations << std::endl;
   str << "  hyperedge size threshold:           " << params.hyperedge_size_threshold << std::endl;
+  if (params.time_limit > 0.0) {
+    str << "  time limit:                         " << params.time_limit << " s" << std::endl;
+  }
+  if (params.mode == Mode::recursive_bisection) {
+    str << "  # RB threads:                       " << params.rb_num_threads << std::endl;
+  }
   str << "  total hypergraph weight:            " << params.total_graph_weight << std::endl;
   str << "  L_opt0:                             " << params.perfect_balance_part_weights[0]
   << std::endl;
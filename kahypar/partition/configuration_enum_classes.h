@@ -43,6 +43,8 @@ enum class InitialPartitioningTechnique : uint8_t {
 enum class CoarseningAlgorithm : uint8_t {
   heavy_full,
   heavy_lazy,
+  heavy_full_bucket,
+  heavy_lazy_bucket,
   ml_style,
   do_nothing
 };
@@ -52,7 +54,9 @@ enum class RefinementAlgorithm : uint8_t {
   kway_fm,
   kway_fm_maxgain,
   kway_fm_km1,
+  kway_fm_km1_parallel,
   label_propagation,
+  label_propagation_parallel,
   do_nothing
 };
 
@@ -87,6 +91,16 @@ enum class Objective : uint8_t {
   km1
 };
 
+enum class GainQueueType : uint8_t {
+  heap,
+  bucket
+};
+
+enum class GainCacheType : uint8_t {
+  dense,
+  sparse
+};
+
 
 static std::string toString(const Mode& mode) {
   switch (mode) {
@@ -136,6 +150,10 @@ static std::string toString(const CoarseningAlgorithm& algo) {
       return std::string("heavy_full");
     case CoarseningAlgorithm::heavy_lazy:
       return std::string("heavy_lazy");
+    case CoarseningAlgorithm::heavy_full_bucket:
+      return std::string("heavy_full_bucket");
+    case CoarseningAlgorithm::heavy_lazy_bucket:
+      return std::string("heavy_lazy_bucket");
     case CoarseningAlgorithm::ml_style:
       return std::string("ml_style");
     case CoarseningAlgorithm::do_nothing:
@@ -154,8 +172,12 @@ static std::string toString(const RefinementAlgorithm& algo) {
       return std::string("kway_fm_maxgain");
     case RefinementAlgorithm::kway_fm_km1:
       return std::string("kway_fm_km1");
+    case RefinementAlgorithm::kway_fm_km1_parallel:
+      return std::string("kway_fm_km1_parallel");
     case RefinementAlgorithm::label_propagation:
       return std::string("label_propagation");
+    case RefinementAlgorithm::label_propagation_parallel:
+      return std::string("label_propagation_parallel");
     case RefinementAlgorithm::do_nothing:
       return std::string("do_nothing");
   }
@@ -204,6 +226,16 @@ static std::string toString(const RefinementStoppingRule& algo) {
   return std::string("UNDEFINED");
 }
 
+static std::string toString(const GainQueueType& type) {
+  switch (type) {
+    case GainQueueType::heap:
+      return std::string("heap");
+    case GainQueueType::bucket:
+      return std::string("bucket");
+  }
+  return std::string("UNDEFINED");
+}
+
 static std::string toString(const GlobalRebalancingMode& state) {
   switch (state) {
     case GlobalRebalancingMode::off:
@@ -244,6 +276,10 @@ static CoarseningAlgorithm coarseningAlgorithmFromString(const std::string& type
     return CoarseningAlgorithm::heavy_full;
   } else if (type == "heavy_lazy") {
     return CoarseningAlgorithm::heavy_lazy;
+  } else if (type == "heavy_full_bucket") {
+    return CoarseningAlgorithm::heavy_full_bucket;
+  } else if (type == "heavy_lazy_bucket") {
+    return CoarseningAlgorithm::heavy_lazy_bucket;
   } else if (type == "ml_style") {
     return CoarseningAlgorithm::ml_style;
   }
@@ -259,10 +295,14 @@ static RefinementAlgorithm refinementAlgorithmFromString(const std::string& type
     return RefinementAlgorithm::kway_fm;
   } else if (type == "kway_fm_km1") {
     return RefinementAlgorithm::kway_fm_km1;
+  } else if (type == "kway_fm_km1_parallel") {
+    return RefinementAlgorithm::kway_fm_km1_parallel;
   } else if (type == "kway_fm_maxgain") {
     return RefinementAlgorithm::kway_fm_maxgain;
   } else if (type == "sclap") {
     return RefinementAlgorithm::label_propagation;
+  } else if (type == "sclap_parallel") {
+    return RefinementAlgorithm::label_propagation_parallel;
   }
   std::cout << "Illegal option:" << type << std::endl;
   exit(0);
@@ -302,6 +342,17 @@ static InitialPartitionerAlgorithm initialPartitioningAlgorithmFromString(const
   return InitialPartitionerAlgorithm::greedy_global;
 }
 
+static GainQueueType gainQueueTypeFromString(const std::string& type) {
+  if (type == "heap") {
+    return GainQueueType::heap;
+  } else if (type == "bucket") {
+    return GainQueueType::bucket;
+  }
+  std::cout << "Illegal option:" << type << std::endl;
+  exit(0);
+  return GainQueueType::heap;
+}
+
 static InitialPartitioningTechnique inititalPartitioningTechniqueFromString(const std::string& technique) {
   if (technique == "flat") {
     return InitialPartitioningTechnique::flat;
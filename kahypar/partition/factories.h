@@ -30,9 +30,13 @@
 #include "kahypar/partition/refinement/i_refiner.h"
 #include "kahypar/partition/refinement/kway_fm_cut_refiner.h"
 #include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/kway_fm_parallel_km1_refiner.h"
 #include "kahypar/partition/refinement/lp_refiner.h"
+#include "kahypar/partition/refinement/parallel_lp_refiner.h"
 #include "kahypar/partition/refinement/policies/2fm_rebalancing_policy.h"
 #include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+#include "kahypar/partition/refinement/policies/gain_cache_policy.h"
+#include "kahypar/partition/refinement/policies/gain_queue_policy.h"
 
 namespace kahypar {
 using CoarsenerFactory = meta::Factory<CoarseningAlgorithm,
@@ -49,13 +53,29 @@ using InitialPartitioningFactory = meta::Factory<InitialPartitionerAlgorithm,
 using TwoWayFMFactoryDispatcher = meta::StaticMultiDispatchFactory<TwoWayFMRefiner,
                                                                    IRefiner,
                                                                    meta::Typelist<StoppingPolicyClasses,
-                                                                                  RebalancingPolicyClasses> >;
+                                                                                  RebalancingPolicyClasses,
+                                                                                  GainQueuePolicyClasses> >;
+
+template <template <typename ...> class GreedyInitialPartitioner>
+using GreedyInitialPartitionerFactoryDispatcher =
+        meta::StaticMultiDispatchFactory<GreedyInitialPartitioner,
+                                         IInitialPartitioner,
+                                         meta::Typelist<GainQueuePolicyClasses> >;
 
 using KWayFMFactoryDispatcher = meta::StaticMultiDispatchFactory<KWayFMRefiner,
                                                                  IRefiner,
-                                                                 meta::Typelist<StoppingPolicyClasses> >;
+                                                                 meta::Typelist<StoppingPolicyClasses,
+                                                                                GainCachePolicyClasses,
+                                                                                GainQueuePolicyClasses> >;
 
 using KWayKMinusOneFactoryDispatcher = meta::StaticMultiDispatchFactory<KWayKMinusOneRefiner,
                                                                         IRefiner,
-                                                                        meta::Typelist<StoppingPolicyClasses> >;
+                                                                        meta::Typelist<StoppingPolicyClasses,
+                                                                                       GainCachePolicyClasses,
+                                                                                       GainQueuePolicyClasses> >;
+
+using KWayParallelKMinusOneFactoryDispatcher =
+  meta::StaticMultiDispatchFactory<KWayParallelKMinusOneRefiner,
+                                   IRefiner,
+                                   meta::Typelist<StoppingPolicyClasses> >;
 }  // namespace kahypar
@@ -32,17 +32,18 @@
 #include "kahypar/partition/initial_partitioning/i_initial_partitioner.h"
 #include "kahypar/partition/initial_partitioning/initial_partitioner_base.h"
 #include "kahypar/partition/initial_partitioning/policies/ip_gain_computation_policy.h"
+#include "kahypar/partition/refinement/policies/gain_queue_policy.h"
 #include "kahypar/utils/randomize.h"
 
 namespace kahypar {
 template <class StartNodeSelection = Mandatory,
           class GainComputation = Mandatory,
-          class QueueSelection = Mandatory>
+          class QueueSelection = Mandatory,
+          class GainQueue = HeapGainQueue>
 class GreedyHypergraphGrowingInitialPartitioner : public IInitialPartitioner,
                                                   private InitialPartitionerBase {
  private:
-  using KWayRefinementPQ = ds::KWayPriorityQueue<HypernodeID, Gain,
-                                                 std::numeric_limits<Gain>, true>;
+  using KWayRefinementPQ = typename GainQueue::PQ;
 
  public:
   GreedyHypergraphGrowingInitialPartitioner(Hypergraph& hypergraph,
@@ -52,7 +53,7 @@ class GreedyHypergraphGrowingInitialPartitioner : public IInitialPartitioner,
     _pq(config.initial_partitioning.k),
     _visit(_hg.initialNumNodes()),
     _hyperedge_in_queue(config.initial_partitioning.k * _hg.initialNumEdges()) {
-    _pq.initialize(_hg.initialNumNodes());
+    GainQueue::template initialize<GainComputation>(_pq, _hg);
   }
 
   ~GreedyHypergraphGrowingInitialPartitioner() { }
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <utility>
+
+#include "kahypar/datastructure/binary_heap.h"
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/definitions.h"
+#include "kahypar/macros.h"
+#include "kahypar/meta/mandatory.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/partition/initial_partitioning/policies/ip_gain_computation_policy.h"
+
+namespace kahypar {
+static const bool dbg_initial_partitioning_rebalancing = false;
+
+/*!
+ * Repairs the balance of a partition by greedily moving hypernodes out of
+ * overloaded blocks. All hypernodes of overloaded blocks are kept in a priority
+ * queue ordered by the gain of their best feasible move, i.e., the hypernodes
+ * with the lowest loss (typically border nodes) are moved first. After each move,
+ * the gains of the neighbors are updated. Since moves also change the weights of
+ * the target blocks, the move of the top hypernode is re-evaluated before it is
+ * performed. Each hypernode is moved at most once.
+ */
+template <class GainComputation = Mandatory>
+class GreedyRebalancer {
+ private:
+  static constexpr PartitionID kInvalidPart = -1;
+
+ public:
+  GreedyRebalancer(Hypergraph& hypergraph, const Configuration& config) :
+    _hg(hypergraph),
+    _config(config),
+    _pq(hypergraph.initialNumNodes()),
+    _visit(hypergraph.initialNumEdges()) { }
+
+  GreedyRebalancer(const GreedyRebalancer&) = delete;
+  GreedyRebalancer& operator= (const GreedyRebalancer&) = delete;
+
+  GreedyRebalancer(GreedyRebalancer&&) = delete;
+  GreedyRebalancer& operator= (GreedyRebalancer&&) = delete;
+
+  // Returns true if all blocks satisfy the balance constraint afterwards.
+  bool rebalance() {
+    _hg.initializeNumCutHyperedges();
+    _pq.clear();
+    for (const HypernodeID hn : _hg.nodes()) {
+      if (isOverloaded(_hg.partID(hn))) {
+        const std::pair<PartitionID, Gain> move = bestMove(hn);
+        if (move.first != kInvalidPart) {
+          _pq.push(hn, move.second);
+        }
+      }
+    }
+
+    while (!_pq.empty()) {
+      const HypernodeID hn = _pq.top();
+      const PartitionID from = _hg.partID(hn);
+      if (!isOverloaded(from)) {
+        _pq.pop();
+        continue;
+      }
+      const std::pair<PartitionID, Gain> move = bestMove(hn);
+      if (move.first == kInvalidPart) {
+        _pq.pop();
+      } else if (move.second < _pq.topKey()) {
+        _pq.updateKey(hn, move.second);
+      } else {
+        DBG(dbg_initial_partitioning_rebalancing, "Moving HN " << hn << " from " << from
+            << " to " << move.first << " (gain=" << move.second << ")");
+        _pq.pop();
+        _hg.changeNodePart(hn, from, move.first);
+        updateNeighbors(hn);
+      }
+    }
+
+    for (PartitionID part = 0; part < _config.partition.k; ++part) {
+      if (isOverloaded(part)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  HypernodeWeight maxPartWeight(const PartitionID part) const {
+    return _config.partition.max_part_weights[part == 0 ? 0 : 1];
+  }
+
+  bool isOverloaded(const PartitionID part) const {
+    return _hg.partWeight(part) > maxPartWeight(part);
+  }
+
+  // Returns the best block hn can be moved to without overloading it (or kInvalidPart).
+  std::pair<PartitionID, Gain> bestMove(const HypernodeID hn) {
+    const PartitionID from = _hg.partID(hn);
+    PartitionID best_part = kInvalidPart;
+    Gain best_gain = std::numeric_limits<Gain>::min();
+    if (_hg.partSize(from) == 1) {
+      return std::make_pair(best_part, best_gain);
+    }
+    for (PartitionID part = 0; part < _config.partition.k; ++part) {
+      if (part != from && _hg.partWeight(part) + _hg.nodeWeight(hn) <= maxPartWeight(part)) {
+        const Gain gain = GainComputation::calculateGain(_hg, hn, part, _visit);
+        if (gain > best_gain) {
+          best_gain = gain;
+          best_part = part;
+        }
+      }
+    }
+    return std::make_pair(best_part, best_gain);
+  }
+
+  void updateNeighbors(const HypernodeID moved_hn) {
+    for (const HyperedgeID he : _hg.incidentEdges(moved_hn)) {
+      for (const HypernodeID pin : _hg.pins(he)) {
+        if (_pq.contains(pin)) {
+          const std::pair<PartitionID, Gain> move = bestMove(pin);
+          if (move.first == kInvalidPart) {
+            _pq.remove(pin);
+          } else {
+            _pq.updateKey(pin, move.second);
+          }
+        }
+      }
+    }
+  }
+
+  Hypergraph& _hg;
+  const Configuration& _config;
+  ds::BinaryMaxHeap<HypernodeID, Gain> _pq;
+  ds::FastResetFlagArray<> _visit;
+};
+}  // namespace kahypar
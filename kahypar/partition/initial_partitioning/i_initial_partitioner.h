@@ -21,7 +21,6 @@
 #pragma once
 
 #include <limits>
-#include <vector>
 
 #include "kahypar/partition/configuration.h"
 #include "kahypar/partition/metrics.h"
@@ -37,21 +36,18 @@ class IInitialPartitioner {
 
   void partition(Hypergraph& hg, const Configuration& config) {
     HyperedgeWeight best_cut = std::numeric_limits<HyperedgeWeight>::max();
-    std::vector<PartitionID> best_partition(hg.initialNumNodes(), 0);
+    Hypergraph::PartitionSnapshot best_partition;
     for (int i = 0; i < config.initial_partitioning.nruns; ++i) {
       // hg.resetPartitioning() is called in partitionImpl
       partitionImpl();
       const HyperedgeWeight current_cut = metrics::hyperedgeCut(hg);
       if (current_cut < best_cut) {
         best_cut = current_cut;
-        for (HypernodeID hn : hg.nodes()) {
-          best_partition[hn] = hg.partID(hn);
-        }
+        hg.createPartitionSnapshot(best_partition);
       }
     }
-    hg.resetPartitioning();
-    for (HypernodeID hn : hg.nodes()) {
-      hg.setNodePart(hn, best_partition[hn]);
+    if (best_cut != std::numeric_limits<HyperedgeWeight>::max()) {
+      hg.restorePartitionSnapshot(best_partition);
     }
   }
 
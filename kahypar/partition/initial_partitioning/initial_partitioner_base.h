@@ -24,11 +24,13 @@
 #include <limits>
 #include <map>
 #include <stack>
+#include <utility>
 #include <vector>
 
 #include "kahypar/definitions.h"
 #include "kahypar/partition/configuration.h"
 #include "kahypar/partition/factories.h"
+#include "kahypar/partition/initial_partitioning/refiner_pool.h"
 #include "kahypar/partition/metrics.h"
 #include "kahypar/partition/refinement/i_refiner.h"
 #include "kahypar/partition/refinement/kway_fm_cut_refiner.h"
@@ -52,9 +54,12 @@ class InitialPartitionerBase {
       _unassigned_nodes.push_back(hn);
     }
     _unassigned_node_bound = _unassigned_nodes.size();
+    RefinerPool::instance().registerUser(_hg, _config);
   }
 
-  virtual ~InitialPartitionerBase() { }
+  virtual ~InitialPartitionerBase() {
+    RefinerPool::instance().unregisterUser(_hg, _config);
+  }
 
   void recalculateBalanceConstraints(const double epsilon) {
     for (int i = 0; i < _config.initial_partitioning.k; ++i) {
@@ -81,34 +86,27 @@ class InitialPartitionerBase {
 
   void performFMRefinement() {
     if (_config.initial_partitioning.refinement) {
-      std::unique_ptr<IRefiner> refiner;
-      if (_config.local_search.algorithm == RefinementAlgorithm::twoway_fm &&
-          _config.initial_partitioning.k > 2) {
-        refiner = (RefinerFactory::getInstance().createObject(
-                     RefinementAlgorithm::kway_fm,
-                     _hg, _config));
+      RefinementAlgorithm algorithm = _config.local_search.algorithm;
+      if (algorithm == RefinementAlgorithm::twoway_fm && _config.initial_partitioning.k > 2) {
+        algorithm = RefinementAlgorithm::kway_fm;
         LOG("WARNING: Trying to use twoway_fm for k > 2! Refiner is set to kway_fm.");
-      } else {
-        refiner = (RefinerFactory::getInstance().createObject(
-                     _config.local_search.algorithm,
-                     _hg, _config));
       }
+      std::unique_ptr<IRefiner> refiner = RefinerPool::instance().borrow(algorithm, _hg, _config);
 
-#ifdef USE_BUCKET_QUEUE
-      HyperedgeID max_degree = 0;
-      for (const HypernodeID hn : _hg.nodes()) {
-        max_degree = std::max(max_degree, _hg.nodeDegree(hn));
-      }
-      HyperedgeWeight max_he_weight = 0;
-      for (const HyperedgeID he : _hg.edges()) {
-        max_he_weight = std::max(max_he_weight, _hg.edgeWeight(he));
+      HyperedgeWeight max_gain = 0;
+      if (_config.local_search.fm.gain_queue == GainQueueType::bucket) {
+        // Bucket queues need an upper bound on the absolute gain of a move.
+        HyperedgeID max_degree = 0;
+        for (const HypernodeID hn : _hg.nodes()) {
+          max_degree = std::max(max_degree, _hg.nodeDegree(hn));
+        }
+        HyperedgeWeight max_he_weight = 0;
+        for (const HyperedgeID he : _hg.edges()) {
+          max_he_weight = std::max(max_he_weight, _hg.edgeWeight(he));
+        }
+        max_gain = static_cast<HyperedgeWeight>(max_degree * max_he_weight);
       }
-      LOGVAR(max_degree);
-      LOGVAR(max_he_weight);
-      refiner->initialize(static_cast<HyperedgeWeight>(max_degree * max_he_weight));
-#else
-      refiner->initialize(0);
-#endif
+      refiner->initialize(max_gain);
 
       std::vector<HypernodeID> refinement_nodes;
       Metrics current_metrics = { metrics::hyperedgeCut(_hg),
@@ -127,12 +125,7 @@ class InitialPartitionerBase {
       changes.contraction_partner.push_back(0);
 
       do {
-        refinement_nodes.clear();
-        for (const HypernodeID hn : _hg.nodes()) {
-          if (_hg.isBorderNode(hn)) {
-            refinement_nodes.push_back(hn);
-          }
-        }
+        refinement_nodes.assign(_hg.borderNodes().begin(), _hg.borderNodes().end());
 
         if (refinement_nodes.size() < 2) {
           break;
@@ -151,6 +144,7 @@ class InitialPartitionerBase {
         ++iteration;
       } while (iteration < _config.initial_partitioning.local_search.iterations_per_level &&
                improvement_found);
+      RefinerPool::instance().giveBack(algorithm, _hg, _config, std::move(refiner));
     }
   }
 
@@ -107,7 +107,7 @@ class LabelPropagationInitialPartitioner : public IInitialPartitioner,
 
       int unvisited_pos = nodes.size();
       while (unvisited_pos) {
-        int pos = std::rand() % unvisited_pos;
+        int pos = Randomize::instance().getRandomInt(0, unvisited_pos - 1);
         std::swap(nodes[pos], nodes[unvisited_pos - 1]);
         HypernodeID v = nodes[--unvisited_pos];
 
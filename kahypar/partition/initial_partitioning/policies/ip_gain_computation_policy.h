@@ -261,6 +261,20 @@ struct FMGainComputationPolicy {
       } (), "Error");
   }
 
+  // Bound on the absolute gain of a move, which is used as key range if the
+  // gains are stored in bucket queues.
+  static inline Gain maxGain(const Hypergraph& hg) {
+    Gain max_gain = 0;
+    for (const HypernodeID hn : hg.nodes()) {
+      Gain incident_weight = 0;
+      for (const HyperedgeID he : hg.incidentEdges(hn)) {
+        incident_weight += hg.edgeWeight(he);
+      }
+      max_gain = std::max(max_gain, incident_weight);
+    }
+    return max_gain;
+  }
+
   static GainType getType() {
     return GainType::fm_gain;
   }
@@ -323,6 +337,27 @@ struct MaxPinGainComputationPolicy {
     visit.reset();
   }
 
+  // A move can at most gain the weight of all neighbors. The weight of the neighborhood
+  // of a hypernode is bounded by the sum of the pin weights of its incident nets, which
+  // can be computed in linear time.
+  static inline Gain maxGain(const Hypergraph& hg) {
+    std::vector<Gain> pin_weight(hg.initialNumEdges(), 0);
+    for (const HyperedgeID he : hg.edges()) {
+      for (const HypernodeID pin : hg.pins(he)) {
+        pin_weight[he] += hg.nodeWeight(pin);
+      }
+    }
+    Gain max_gain = 0;
+    for (const HypernodeID hn : hg.nodes()) {
+      Gain neighborhood_weight = 0;
+      for (const HyperedgeID he : hg.incidentEdges(hn)) {
+        neighborhood_weight += pin_weight[he];
+      }
+      max_gain = std::max(max_gain, neighborhood_weight);
+    }
+    return std::min(max_gain, static_cast<Gain>(hg.totalWeight()));
+  }
+
   static GainType getType() {
     return GainType::max_pin_gain;
   }
@@ -369,6 +404,11 @@ struct MaxNetGainComputationPolicy {
     }
   }
 
+  static inline Gain maxGain(const Hypergraph& hg) {
+    // As for FM gains, a move can at most gain the weight of all incident nets.
+    return FMGainComputationPolicy::maxGain(hg);
+  }
+
   static GainType getType() {
     return GainType::max_net_gain;
   }
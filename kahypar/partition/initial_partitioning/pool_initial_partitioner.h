@@ -20,8 +20,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "kahypar/definitions.h"
@@ -30,6 +35,7 @@
 #include "kahypar/partition/initial_partitioning/initial_partitioner_base.h"
 #include "kahypar/partition/partitioner.h"
 #include "kahypar/utils/randomize.h"
+#include "kahypar/utils/stats.h"
 
 namespace kahypar {
 class PoolInitialPartitioner : public IInitialPartitioner,
@@ -55,6 +61,33 @@ class PoolInitialPartitioner : public IInitialPartitioner,
     }
   };
 
+  struct PoolRun {
+    InitialPartitionerAlgorithm algo = InitialPartitionerAlgorithm::pool;
+    int seed = 0;
+    HyperedgeWeight cut = kInvalidCut;
+    double imbalance = kInvalidImbalance;
+    std::vector<PartitionID> partition;
+  };
+
+  // Statistics of an algorithm of the adaptive pool
+  struct PortfolioEntry {
+    explicit PortfolioEntry(const InitialPartitionerAlgorithm algo) :
+      algo(algo),
+      runs(0),
+      best_cut(kInvalidCut),
+      cut_sum(0.0) { }
+
+    double meanCut() const {
+      return runs > 0 ? cut_sum / runs : std::numeric_limits<double>::max();
+    }
+
+    InitialPartitionerAlgorithm algo;
+    int runs;
+    // best cut of all balanced runs
+    HyperedgeWeight best_cut;
+    double cut_sum;
+  };
+
  public:
   PoolInitialPartitioner(Hypergraph& hypergraph, Configuration& config) :
     InitialPartitionerBase(hypergraph, config),
@@ -100,6 +133,7 @@ class PoolInitialPartitioner : public IInitialPartitioner,
     PartitioningResult max_imbalance(InitialPartitionerAlgorithm::pool, kInvalidCut, -0.1);
 
     std::vector<PartitionID> best_partition(_hg.initialNumNodes());
+    std::vector<InitialPartitionerAlgorithm> algorithms;
     unsigned int n = _partitioner_pool.size() - 1;
     for (unsigned int i = 0; i <= n; ++i) {
       // If the (n-i)th bit of pool_type is set we execute the corresponding
@@ -114,40 +148,57 @@ class PoolInitialPartitioner : public IInitialPartitioner,
         LOG("skipping maxpin");
         continue;
       }
-      std::unique_ptr<IInitialPartitioner> partitioner(
-        InitialPartitioningFactory::getInstance().createObject(algo, _hg, _config));
-      partitioner->partition(_hg, _config);
-      HyperedgeWeight current_cut = metrics::hyperedgeCut(_hg);
-      double current_imbalance = metrics::imbalance(_hg, _config);
-      LOG(toString(algo) << V(current_cut) << V(current_imbalance));
-      if (current_cut <= best_cut.cut) {
-        bool apply_best_partition = true;
-        if (best_cut.cut != kInvalidCut) {
-          if (current_imbalance > _config.initial_partitioning.epsilon) {
-            if (current_imbalance > best_cut.imbalance) {
-              apply_best_partition = false;
-            }
-          }
-        }
-        if (apply_best_partition) {
-          for (const HypernodeID hn : _hg.nodes()) {
-            best_partition[hn] = _hg.partID(hn);
-          }
-          applyPartitioningResults(best_cut, current_cut, current_imbalance, algo);
-        }
-      }
-      if (current_cut < min_cut.cut) {
-        applyPartitioningResults(min_cut, current_cut, current_imbalance, algo);
-      }
-      if (current_cut > max_cut.cut) {
-        applyPartitioningResults(max_cut, current_cut, current_imbalance, algo);
-      }
-      if (current_imbalance < min_imbalance.imbalance) {
-        applyPartitioningResults(min_imbalance, current_cut, current_imbalance, algo);
-      }
-      if (current_imbalance > max_imbalance.imbalance) {
-        applyPartitioningResults(max_imbalance, current_cut, current_imbalance, algo);
-      }
+      algorithms.push_back(algo);
+    }
+
+    const auto evaluate = [&](PoolRun& run) {
+                            const InitialPartitionerAlgorithm algo = run.algo;
+                            const HyperedgeWeight current_cut = run.cut;
+                            const double current_imbalance = run.imbalance;
+                            LOG(toString(algo) << V(current_cut) << V(current_imbalance));
+                            if (current_cut <= best_cut.cut) {
+                              bool apply_best_partition = true;
+                              if (best_cut.cut != kInvalidCut) {
+                                if (current_imbalance > _config.initial_partitioning.epsilon) {
+                                  if (current_imbalance > best_cut.imbalance) {
+                                    apply_best_partition = false;
+                                  }
+                                }
+                              }
+                              if (apply_best_partition) {
+                                if (run.partition.empty()) {
+                                  for (const HypernodeID hn : _hg.nodes()) {
+                                    best_partition[hn] = _hg.partID(hn);
+                                  }
+                                } else {
+                                  best_partition.swap(run.partition);
+                                }
+                                applyPartitioningResults(best_cut, current_cut,
+                                                         current_imbalance, algo);
+                              }
+                            }
+                            if (current_cut < min_cut.cut) {
+                              applyPartitioningResults(min_cut, current_cut, current_imbalance,
+                                                       algo);
+                            }
+                            if (current_cut > max_cut.cut) {
+                              applyPartitioningResults(max_cut, current_cut, current_imbalance,
+                                                       algo);
+                            }
+                            if (current_imbalance < min_imbalance.imbalance) {
+                              applyPartitioningResults(min_imbalance, current_cut,
+                                                       current_imbalance, algo);
+                            }
+                            if (current_imbalance > max_imbalance.imbalance) {
+                              applyPartitioningResults(max_imbalance, current_cut,
+                                                       current_imbalance, algo);
+                            }
+                          };
+
+    if (_config.initial_partitioning.pool_adaptive && algorithms.size() > 1) {
+      runAdaptivePortfolio(algorithms, evaluate);
+    } else {
+      runAlgorithms(algorithms, _config.initial_partitioning.nruns, evaluate);
     }
 
     if (_config.partition.verbose_output) {
@@ -185,6 +236,164 @@ class PoolInitialPartitioner : public IInitialPartitioner,
     _config.initial_partitioning.nruns = 1;
   }
 
+  // Runs each of the given algorithms nruns times and calls evaluate(run) for each
+  // algorithm (in the given order) with the best of its nruns partitions. If the
+  // partition of a run is empty, it is the current partition of _hg.
+  template <typename Evaluate>
+  void runAlgorithms(const std::vector<InitialPartitionerAlgorithm>& algorithms,
+                     const int nruns, const Evaluate& evaluate) {
+    if (_config.initial_partitioning.pool_num_threads > 1 && algorithms.size() > 1) {
+      std::vector<PoolRun> runs = runAlgorithmsInParallel(algorithms, nruns);
+      for (PoolRun& run : runs) {
+        evaluate(run);
+      }
+      return;
+    }
+    const int original_nruns = _config.initial_partitioning.nruns;
+    for (const InitialPartitionerAlgorithm algo : algorithms) {
+      _config.initial_partitioning.nruns = nruns;
+      std::unique_ptr<IInitialPartitioner> partitioner(
+        InitialPartitioningFactory::getInstance().createObject(algo, _hg, _config));
+      partitioner->partition(_hg, _config);
+      _config.initial_partitioning.nruns = original_nruns;
+      PoolRun run;
+      run.algo = algo;
+      run.cut = metrics::hyperedgeCut(_hg);
+      run.imbalance = metrics::imbalance(_hg, _config);
+      evaluate(run);
+    }
+  }
+
+  // Runs each algorithm on a private copy of the configuration. The first thread
+  // works on _hg, all other threads on a private copy of the hypergraph, which
+  // behaves exactly like _hg. The seed of each run is drawn from the random number
+  // generator of the calling thread before the worker threads are started. Thus,
+  // the results only depend on the seed of the partitioner and neither on the
+  // number of threads nor on the order in which the runs are scheduled.
+  std::vector<PoolRun> runAlgorithmsInParallel(
+    const std::vector<InitialPartitionerAlgorithm>& algorithms, const int nruns) {
+    std::vector<PoolRun> runs(algorithms.size());
+    for (size_t i = 0; i < runs.size(); ++i) {
+      runs[i].algo = algorithms[i];
+      runs[i].seed = Randomize::instance().newRandomSeed();
+    }
+
+    const size_t num_threads = std::min(algorithms.size(), static_cast<size_t>(
+                                          _config.initial_partitioning.pool_num_threads));
+    // The copies are created before the threads are started, since the first
+    // thread modifies _hg. Each hypergraph is reused for all runs of its thread,
+    // since the initial partitioners reset the partition before each run.
+    std::vector<std::pair<std::unique_ptr<Hypergraph>, std::vector<HypernodeID> > > copies;
+    for (size_t i = 1; i < num_threads; ++i) {
+      copies.push_back(ds::reindex(_hg));
+    }
+    std::atomic<size_t> next_run(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < num_threads; ++i) {
+      threads.emplace_back([&, i]() {
+          Hypergraph& hypergraph = i == 0 ? _hg : *copies[i - 1].first;
+          const auto original_id = [&](const HypernodeID hn) {
+                                     return i == 0 ? hn : copies[i - 1].second[hn];
+                                   };
+          for (size_t run = next_run++; run < runs.size(); run = next_run++) {
+            Configuration config(_config);
+            config.initial_partitioning.nruns = nruns;
+            Randomize::instance().setSeed(runs[run].seed);
+            std::unique_ptr<IInitialPartitioner> partitioner(
+              InitialPartitioningFactory::getInstance().createObject(runs[run].algo,
+                                                                     hypergraph, config));
+            partitioner->partition(hypergraph, config);
+            runs[run].cut = metrics::hyperedgeCut(hypergraph);
+            runs[run].imbalance = metrics::imbalance(hypergraph, config);
+            runs[run].partition.resize(_hg.initialNumNodes());
+            for (const HypernodeID hn : hypergraph.nodes()) {
+              runs[run].partition[original_id(hn)] = hypergraph.partID(hn);
+            }
+          }
+        });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    return runs;
+  }
+
+  // Successive halving over the selected algorithms: The budget of the adaptive pool
+  // is the same as that of the static pool, i.e., nruns runs per algorithm. First,
+  // each algorithm is run pool_warmup_runs times. Afterwards, the worse half of the
+  // remaining algorithms (w.r.t. the best balanced cut, ties are broken by the mean
+  // cut) is pruned repeatedly and the remaining budget is split evenly among the
+  // rounds until only one algorithm is left, which gets the rest of the budget.
+  template <typename Evaluate>
+  void runAdaptivePortfolio(const std::vector<InitialPartitionerAlgorithm>& algorithms,
+                            const Evaluate& evaluate) {
+    std::vector<PortfolioEntry> portfolio;
+    for (const InitialPartitionerAlgorithm algo : algorithms) {
+      portfolio.emplace_back(algo);
+    }
+    size_t num_active = portfolio.size();
+    int budget = _config.initial_partitioning.nruns * static_cast<int>(portfolio.size());
+
+    budget -= runPortfolioRound(portfolio, num_active,
+                                std::max(1, std::min(_config.initial_partitioning.pool_warmup_runs,
+                                                     _config.initial_partitioning.nruns)),
+                                evaluate);
+    while (budget > 0) {
+      if (num_active > 1) {
+        std::sort(portfolio.begin(), portfolio.begin() + num_active,
+                  [](const PortfolioEntry& lhs, const PortfolioEntry& rhs) {
+            return lhs.best_cut < rhs.best_cut ||
+            (lhs.best_cut == rhs.best_cut && lhs.meanCut() < rhs.meanCut());
+          });
+        const size_t num_survivors = (num_active + 1) / 2;
+        for (size_t i = num_survivors; i < num_active; ++i) {
+          LOG("pruning " << toString(portfolio[i].algo) << V(portfolio[i].best_cut)
+              << V(portfolio[i].meanCut()) << V(portfolio[i].runs));
+        }
+        num_active = num_survivors;
+      }
+      // number of remaining rounds including the final round with only one algorithm
+      int num_rounds = 1;
+      for (size_t active = num_active; active > 1; active = (active + 1) / 2) {
+        ++num_rounds;
+      }
+      budget -= runPortfolioRound(portfolio, num_active,
+                                  std::max(1, budget / (num_rounds *
+                                                        static_cast<int>(num_active))),
+                                  evaluate);
+    }
+
+    for (const PortfolioEntry& entry : portfolio) {
+      Stats::instance().add(_config, "ipPoolRuns_" + toString(entry.algo), entry.runs);
+    }
+  }
+
+  // Runs each of the first num_active algorithms of the portfolio the given number
+  // of times and returns the total number of runs.
+  template <typename Evaluate>
+  int runPortfolioRound(std::vector<PortfolioEntry>& portfolio, const size_t num_active,
+                        const int repetitions, const Evaluate& evaluate) {
+    std::vector<InitialPartitionerAlgorithm> round;
+    for (int i = 0; i < repetitions; ++i) {
+      for (size_t j = 0; j < num_active; ++j) {
+        round.push_back(portfolio[j].algo);
+      }
+    }
+    runAlgorithms(round, 1, [&](PoolRun& run) {
+        for (size_t j = 0; j < num_active; ++j) {
+          if (portfolio[j].algo == run.algo) {
+            ++portfolio[j].runs;
+            portfolio[j].cut_sum += run.cut;
+            if (run.imbalance <= _config.initial_partitioning.epsilon) {
+              portfolio[j].best_cut = std::min(portfolio[j].best_cut, run.cut);
+            }
+          }
+        }
+        evaluate(run);
+      });
+    return static_cast<int>(round.size());
+  }
+
   void applyPartitioningResults(PartitioningResult& result, const HyperedgeWeight cut,
                                 const double imbalance,
                                 const InitialPartitionerAlgorithm algo) const {
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/partition/factories.h"
+#include "kahypar/partition/refinement/i_refiner.h"
+
+namespace kahypar {
+// Refiners of the initial partitioners of the calling thread. All initial partitioners
+// that are executed for one initial partitioning call work on the same hypergraph
+// and configuration. Instead of allocating a new refiner (including its gain cache,
+// priority queue, ...) for each run, a refiner is borrowed from the pool and given
+// back afterwards.
+//
+// Refiners store references to the hypergraph and the configuration. Each initial
+// partitioner therefore registers itself as a user of its hypergraph and configuration.
+// Pooled refiners belong to such a registration and are released as soon as its last
+// user is destroyed. Thus a refiner can never be handed to a different hypergraph or
+// configuration that is later allocated at the same address.
+class RefinerPool {
+ private:
+  struct Registration {
+    const Hypergraph* hypergraph;
+    const Configuration* config;
+    size_t num_users;
+    std::vector<std::pair<RefinementAlgorithm, std::unique_ptr<IRefiner> > > refiners;
+  };
+
+ public:
+  RefinerPool(const RefinerPool&) = delete;
+  RefinerPool(RefinerPool&&) = delete;
+  RefinerPool& operator= (const RefinerPool&) = delete;
+  RefinerPool& operator= (RefinerPool&&) = delete;
+
+  static RefinerPool & instance() {
+    static thread_local RefinerPool pool;
+    return pool;
+  }
+
+  std::unique_ptr<IRefiner> borrow(const RefinementAlgorithm algorithm, Hypergraph& hypergraph,
+                                   const Configuration& config) {
+    Registration* registration = find(hypergraph, config);
+    if (registration != nullptr) {
+      auto& refiners = registration->refiners;
+      for (auto it = refiners.begin(); it != refiners.end(); ++it) {
+        if (it->first == algorithm) {
+          std::unique_ptr<IRefiner> refiner = std::move(it->second);
+          refiners.erase(it);
+          return refiner;
+        }
+      }
+    }
+    return std::unique_ptr<IRefiner>(RefinerFactory::getInstance().createObject(algorithm,
+                                                                                hypergraph,
+                                                                                config));
+  }
+
+  void giveBack(const RefinementAlgorithm algorithm, const Hypergraph& hypergraph,
+                const Configuration& config, std::unique_ptr<IRefiner>&& refiner) {
+    Registration* registration = find(hypergraph, config);
+    ASSERT(registration != nullptr,
+           "Refiners can only be pooled for registered hypergraphs and configurations");
+    registration->refiners.emplace_back(algorithm, std::move(refiner));
+  }
+
+  void registerUser(const Hypergraph& hypergraph, const Configuration& config) {
+    Registration* registration = find(hypergraph, config);
+    if (registration == nullptr) {
+      _registrations.push_back({ &hypergraph, &config, 0, { } });
+      registration = &_registrations.back();
+    }
+    ++registration->num_users;
+  }
+
+  void unregisterUser(const Hypergraph& hypergraph, const Configuration& config) {
+    Registration* registration = find(hypergraph, config);
+    ASSERT(registration != nullptr && registration->num_users > 0, "Unknown user");
+    if (--registration->num_users == 0) {
+      _registrations.erase(_registrations.begin() + (registration - _registrations.data()));
+    }
+  }
+
+  // Number of pooled refiners for the given hypergraph and configuration.
+  size_t size(const Hypergraph& hypergraph, const Configuration& config) const {
+    const Registration* registration = find(hypergraph, config);
+    return registration != nullptr ? registration->refiners.size() : 0;
+  }
+
+ private:
+  RefinerPool() :
+    _registrations() { }
+
+  const Registration* find(const Hypergraph& hypergraph, const Configuration& config) const {
+    for (const Registration& registration : _registrations) {
+      if (registration.hypergraph == &hypergraph && registration.config == &config) {
+        return &registration;
+      }
+    }
+    return nullptr;
+  }
+
+  Registration* find(const Hypergraph& hypergraph, const Configuration& config) {
+    return const_cast<Registration*>(static_cast<const RefinerPool&>(*this).find(hypergraph,
+                                                                                 config));
+  }
+
+  std::vector<Registration> _registrations;
+};
+}  // namespace kahypar
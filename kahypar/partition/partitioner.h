@@ -21,14 +21,18 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
+#include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <stack>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -36,17 +40,20 @@
 #include "gtest/gtest_prod.h"
 
 #include "kahypar/definitions.h"
+#include "kahypar/io/coarsening_snapshot_io.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "kahypar/io/partitioning_output.h"
 #include "kahypar/partition/coarsening/hypergraph_pruner.h"
 #include "kahypar/partition/coarsening/i_coarsener.h"
 #include "kahypar/partition/configuration.h"
 #include "kahypar/partition/factories.h"
+#include "kahypar/partition/initial_partitioning/greedy_rebalancer.h"
 #include "kahypar/partition/metrics.h"
 #include "kahypar/partition/preprocessing/large_hyperedge_remover.h"
 #include "kahypar/partition/preprocessing/min_hash_sparsifier.h"
 #include "kahypar/partition/preprocessing/single_node_hyperedge_remover.h"
 #include "kahypar/partition/refinement/2way_fm_refiner.h"
+#include "kahypar/partition/refinement/refinement_scheduler.h"
 #include "kahypar/utils/randomize.h"
 #include "kahypar/utils/stats.h"
 
@@ -71,7 +78,11 @@ class Partitioner {
   using PartitionWeights = std::vector<HypernodeWeight>;
   using Hyperedges = std::vector<HyperedgeID>;
   using HypergraphPtr = std::unique_ptr<Hypergraph, void (*)(Hypergraph*)>;
-  using MappingStack = std::vector<std::vector<HypernodeID> >;
+  // Each extracted hypergraph of recursive bisection maps its hypernodes directly
+  // to the hypernodes of the input hypergraph. The input hypergraph itself has an
+  // empty mapping.
+  using Mapping = std::vector<HypernodeID>;
+  using MappingStack = std::vector<Mapping>;
 
   enum class RBHypergraphState : std::uint8_t {
     unpartitioned,
@@ -97,7 +108,8 @@ class Partitioner {
     _single_node_he_remover(),
     _large_he_remover(),
     _pin_sparsifier(),
-    _internals() { }
+    _internals(),
+    _internals_mutex() { }
 
   Partitioner(const Partitioner&) = delete;
   Partitioner& operator= (const Partitioner&) = delete;
@@ -144,8 +156,19 @@ class Partitioner {
 
   inline void performRecursiveBisectionPartitioning(Hypergraph& hypergraph,
                                                     const Configuration& config);
-  inline HypernodeID originalHypernode(const HypernodeID hn,
-                                       const MappingStack& mapping_stack) const;
+  inline void composeMapping(Mapping& mapping, const Mapping& parent_mapping) const;
+
+  inline void performParallelRecursiveBisectionPartitioning(Hypergraph& hypergraph,
+                                                            const Configuration& config);
+  inline void bisectRecursively(HypergraphPtr hypergraph, const Hypergraph& input_hypergraph,
+                                const PartitionID lower_k, const PartitionID upper_k,
+                                Mapping mapping,
+                                std::vector<PartitionID>& final_parts,
+                                std::atomic<int>& idle_threads,
+                                const Configuration& original_config);
+  inline void bisect(Hypergraph& hypergraph, const Hypergraph& input_hypergraph,
+                     const PartitionID lower_k, const PartitionID upper_k,
+                     const Configuration& original_config);
 
   inline double calculateRelaxedEpsilon(const HypernodeWeight original_hypergraph_weight,
                                         const HypernodeWeight current_hypergraph_weight,
@@ -159,10 +182,14 @@ class Partitioner {
                                                               const PartitionID k0,
                                                               const PartitionID k1) const;
 
+  inline void coarsen(Hypergraph& hypergraph, ICoarsener& coarsener, const Configuration& config);
+
   inline void performPartitioning(Hypergraph& hypergraph, ICoarsener& coarsener, IRefiner& refiner,
                                   const Configuration& config);
 
   inline void performInitialPartitioning(Hypergraph& hg, const Configuration& config);
+  inline std::vector<PartitionID> computeInitialPartition(Hypergraph& init_hg,
+                                                          const Configuration& config);
   inline void createMappingsForInitialPartitioning(HmetisToCoarsenedMapping& hmetis_to_hg,
                                                    CoarsenedToHmetisMapping& hg_to_hmetis,
                                                    const Hypergraph& hg);
@@ -182,6 +209,7 @@ class Partitioner {
   LargeHyperedgeRemover _large_he_remover;
   MinHashSparsifier _pin_sparsifier;
   std::string _internals;
+  std::mutex _internals_mutex;
 };
 
 inline void Partitioner::setupConfig(const Hypergraph& hypergraph, Configuration& config) const {
@@ -282,19 +310,51 @@ inline void Partitioner::performInitialPartitioning(Hypergraph& hg, const Config
     io::printHypergraphInfo(hg, "Coarsened Hypergraph");
   }
 
-  std::uniform_int_distribution<int> int_dist;
-  auto extracted_init_hypergraph = ds::reindex(hg);
-  std::vector<HypernodeID> mapping(std::move(extracted_init_hypergraph.second));
+  ASSERT([&]() {
+      for (const HypernodeID hn : hg.nodes()) {
+        if (hg.partID(hn) != -1) {
+          return false;
+        }
+      }
+      return true;
+    } (), "The original hypergraph isn't unpartitioned!");
+
+  if (config.initial_partitioning.technique == InitialPartitioningTechnique::flat &&
+      config.initial_partitioning.mode == Mode::direct_kway) {
+    // The direct k-way flat initial partitioners work on the coarsened hypergraph
+    // itself, which is compacted in place instead of being copied.
+    ds::CompactHypergraphView<Hypergraph> view(hg);
+    Hypergraph& init_hg = view.hypergraph();
+    const std::vector<PartitionID> partition = computeInitialPartition(init_hg, config);
+    init_hg.resetPartitioning();
+    for (const HypernodeID hn : init_hg.nodes()) {
+      init_hg.setNodePart(hn, partition[hn]);
+    }
+  } else {
+    // All other initial partitioning techniques coarsen the hypergraph again
+    // and therefore need a copy.
+    auto extracted_init_hypergraph = ds::reindex(hg);
+    const std::vector<PartitionID> partition =
+      computeInitialPartition(*extracted_init_hypergraph.first, config);
+    for (const HypernodeID hn : extracted_init_hypergraph.first->nodes()) {
+      hg.setNodePart(extracted_init_hypergraph.second[hn], partition[hn]);
+    }
+  }
+
+  Stats::instance().addToTotal(config, "InitialCut", metrics::hyperedgeCut(hg));
+}
 
+// Partitions the compacted hypergraph init_hg and returns the best partition.
+inline std::vector<PartitionID> Partitioner::computeInitialPartition(Hypergraph& init_hg,
+                                                                     const Configuration& config) {
   double init_alpha = config.initial_partitioning.init_alpha;
   double best_imbalance = std::numeric_limits<double>::max();
-  std::vector<PartitionID> best_imbalanced_partition(
-    extracted_init_hypergraph.first->initialNumNodes(), 0);
+  std::vector<PartitionID> best_imbalanced_partition(init_hg.initialNumNodes(), 0);
 
   do {
-    extracted_init_hypergraph.first->resetPartitioning();
+    init_hg.resetPartitioning();
     Configuration init_config = Partitioner::createConfigurationForInitialPartitioning(
-      *extracted_init_hypergraph.first, config, init_alpha);
+      init_hg, config, init_alpha);
 
 
     if (config.partition.verbose_output) {
@@ -310,45 +370,36 @@ inline void Partitioner::performInitialPartitioning(Hypergraph& hg, const Config
       // corresponding initial partitioing algorithm, otherwise...
       std::unique_ptr<IInitialPartitioner> partitioner(
         InitialPartitioningFactory::getInstance().createObject(
-          config.initial_partitioning.algo,
-          *extracted_init_hypergraph.first, init_config));
-      partitioner->partition(*extracted_init_hypergraph.first,
-                             init_config);
+          config.initial_partitioning.algo, init_hg, init_config));
+      partitioner->partition(init_hg, init_config);
     } else {
       // ... we call the partitioner again with the new configuration.
-      partitionInternal(*extracted_init_hypergraph.first, init_config);
+      partitionInternal(init_hg, init_config);
     }
 
-    const double imbalance = metrics::imbalance(*extracted_init_hypergraph.first, config);
-    if (imbalance < best_imbalance) {
-      for (const HypernodeID hn : extracted_init_hypergraph.first->nodes()) {
-        best_imbalanced_partition[hn] = extracted_init_hypergraph.first->partID(hn);
+    if (config.initial_partitioning.greedy_rebalancing &&
+        metrics::imbalance(init_hg, config) > config.partition.epsilon) {
+      // Try to repair the balance of the current initial partition before
+      // restarting initial partitioning with a tighter balance constraint.
+      GreedyRebalancer<FMGainComputationPolicy> rebalancer(init_hg, config);
+      const bool rebalanced = rebalancer.rebalance();
+      Stats::instance().addToTotal(config, "InitialRebalancingAttempts", 1);
+      Stats::instance().addToTotal(config, "InitialRebalancingSuccesses", rebalanced);
+      if (config.partition.verbose_output) {
+        LOG("Greedy rebalancing of initial partition " << (rebalanced ? "succeeded" : "failed"));
       }
     }
-    init_alpha -= 0.1;
-  } while (metrics::imbalance(*extracted_init_hypergraph.first, config)
-           > config.partition.epsilon && init_alpha > 0.0);
 
-  ASSERT([&]() {
-      for (const HypernodeID hn : hg.nodes()) {
-        if (hg.partID(hn) != -1) {
-          return false;
-        }
+    const double imbalance = metrics::imbalance(init_hg, config);
+    if (imbalance < best_imbalance) {
+      for (const HypernodeID hn : init_hg.nodes()) {
+        best_imbalanced_partition[hn] = init_hg.partID(hn);
       }
-      return true;
-    } (), "The original hypergraph isn't unpartitioned!");
-
-  // Apply the best balanced partition to the original hypergraph
-  for (const HypernodeID hn : extracted_init_hypergraph.first->nodes()) {
-    PartitionID part = extracted_init_hypergraph.first->partID(hn);
-    if (part != best_imbalanced_partition[hn]) {
-      part = best_imbalanced_partition[hn];
     }
-    hg.setNodePart(mapping[hn], part);
-  }
-
+    init_alpha -= 0.1;
+  } while (metrics::imbalance(init_hg, config) > config.partition.epsilon && init_alpha > 0.0);
 
-  Stats::instance().addToTotal(config, "InitialCut", metrics::hyperedgeCut(hg));
+  return best_imbalanced_partition;
 }
 
 inline Configuration Partitioner::createConfigurationForInitialPartitioning(const Hypergraph& hg,
@@ -364,6 +415,9 @@ inline Configuration Partitioner::createConfigurationForInitialPartitioning(cons
   config.partition.epsilon = init_alpha * original_config.partition.epsilon;
   config.partition.collect_stats = false;
   config.partition.global_search_iterations = 0;
+  // Initial partitioning runs on small coarse hypergraphs. Each bisection of a parallel
+  // recursive bisection already runs on its own thread.
+  config.partition.rb_num_threads = 1;
 
   config.initial_partitioning.k = config.partition.k;
   config.initial_partitioning.epsilon = init_alpha * original_config.partition.epsilon;
@@ -450,6 +504,9 @@ inline Configuration Partitioner::createConfigurationForInitialPartitioning(cons
 }
 
 inline void Partitioner::partition(Hypergraph& hypergraph, Configuration& config) {
+  if (RefinementScheduler::hasDeadline(config)) {
+    config.partition.deadline = RefinementScheduler::deadlineAfter(config.partition.time_limit);
+  }
   setupConfig(hypergraph, config);
 
   if (config.preprocessing.min_hash_sparsifier.is_active) {
@@ -476,12 +533,51 @@ inline void Partitioner::partitionInternal(Hypergraph& hypergraph, const Configu
 }
 
 
+inline void Partitioner::coarsen(Hypergraph& hypergraph, ICoarsener& coarsener,
+                                 const Configuration& config) {
+  // Snapshots are only supported for the top-level hypergraph in direct k-way mode.
+  // In recursive bisection mode, each bisection coarsens a different hypergraph.
+  if (config.coarsening.snapshot_filename.empty() ||
+      config.partition.mode != Mode::direct_kway) {
+    coarsener.coarsen(config.coarsening.contraction_limit);
+    return;
+  }
+
+  switch (io::readCoarseningSnapshot(config.coarsening.snapshot_filename, hypergraph, coarsener,
+                                     config)) {
+    case io::CoarseningSnapshotStatus::restored:
+      if (config.partition.verbose_output) {
+        LOG("Restored coarsened hypergraph from " << config.coarsening.snapshot_filename);
+      }
+      return;
+    case io::CoarseningSnapshotStatus::corrupted:
+      // Nothing was restored, so the snapshot is simply recomputed and overwritten.
+      LOG("Coarsening snapshot " << config.coarsening.snapshot_filename
+          << " is corrupted and will be recomputed.");
+      break;
+    case io::CoarseningSnapshotStatus::invalid:
+      std::cerr << "Error: Coarsening snapshot " << config.coarsening.snapshot_filename
+                << " could not be restored." << std::endl;
+      std::exit(-1);
+    case io::CoarseningSnapshotStatus::not_found:
+    case io::CoarseningSnapshotStatus::mismatch:
+      break;
+  }
+  const io::CoarseningSnapshotHeader header = io::createCoarseningSnapshotHeader(hypergraph,
+                                                                                 config);
+  coarsener.coarsen(config.coarsening.contraction_limit);
+  io::writeCoarseningSnapshot(config.coarsening.snapshot_filename, header, coarsener);
+  if (config.partition.verbose_output) {
+    LOG("Wrote coarsened hypergraph to " << config.coarsening.snapshot_filename);
+  }
+}
+
 inline void Partitioner::performPartitioning(Hypergraph& hypergraph,
                                              ICoarsener& coarsener,
                                              IRefiner& refiner,
                                              const Configuration& config) {
   HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
-  coarsener.coarsen(config.coarsening.contraction_limit);
+  coarsen(hypergraph, coarsener, config);
   HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
   Stats::instance().addToTotal(config, "Coarsening",
                                std::chrono::duration<double>(end - start).count());
@@ -525,13 +621,15 @@ inline bool Partitioner::partitionVCycle(Hypergraph& hypergraph, ICoarsener& coa
   return found_improved_cut;
 }
 
-inline HypernodeID Partitioner::originalHypernode(const HypernodeID hn,
-                                                  const MappingStack& mapping_stack) const {
-  HypernodeID node = hn;
-  for (auto it = mapping_stack.crbegin(); it != mapping_stack.crend(); ++it) {
-    node = (*it)[node];
+// Turns the mapping of an extracted hypergraph to its parent into a mapping to the
+// input hypergraph, i.e., the hypernodes of a leaf are mapped in a single step.
+inline void Partitioner::composeMapping(Mapping& mapping, const Mapping& parent_mapping) const {
+  if (parent_mapping.empty()) {
+    return;
+  }
+  for (HypernodeID& hn : mapping) {
+    hn = parent_mapping[hn];
   }
-  return node;
 }
 
 inline double Partitioner::calculateRelaxedEpsilon(const HypernodeWeight original_hypergraph_weight,
@@ -591,11 +689,82 @@ inline Configuration Partitioner::createConfigurationForCurrentBisection(const C
     current_config.coarsening.hypernode_weight_fraction
     * current_config.partition.total_graph_weight);
 
+  if (RefinementScheduler::hasDeadline(original_config)) {
+    // Each level of the recursion bisects all hypernodes once. Thus a bisection gets
+    // the share of the time limit that corresponds to its number of hypernodes.
+    const double share = current_hypergraph.currentNumNodes() /
+                         (static_cast<double>(original_hypergraph.currentNumNodes()) *
+                          ceil(log2(static_cast<double>(original_config.partition.k))));
+    current_config.partition.deadline =
+      std::min(original_config.partition.deadline,
+               RefinementScheduler::deadlineAfter(share * original_config.partition.time_limit));
+  }
+
   return current_config;
 }
 
+inline void Partitioner::bisect(Hypergraph& hypergraph, const Hypergraph& input_hypergraph,
+                                const PartitionID lower_k, const PartitionID upper_k,
+                                const Configuration& original_config) {
+  const PartitionID k = upper_k - lower_k + 1;
+  const PartitionID km = k / 2;
+  Configuration current_config =
+    createConfigurationForCurrentBisection(original_config,
+                                           input_hypergraph, hypergraph, k, km,
+                                           k - km);
+  current_config.partition.rb_lower_k = lower_k;
+  current_config.partition.rb_upper_k = upper_k;
+
+  std::unique_ptr<ICoarsener> coarsener(
+    CoarsenerFactory::getInstance().createObject(
+      current_config.coarsening.algorithm,
+      hypergraph, current_config,
+      hypergraph.weightOfHeaviestNode()));
+
+  std::unique_ptr<IRefiner> refiner(
+    RefinerFactory::getInstance().createObject(
+      current_config.local_search.algorithm,
+      hypergraph, current_config));
+
+  ASSERT(coarsener.get() != nullptr, "coarsener not found");
+  ASSERT(refiner.get() != nullptr, "refiner not found");
+
+  // TODO(schlag): find better solution
+  {
+    std::lock_guard<std::mutex> lock(_internals_mutex);
+    if (_internals.empty()) {
+      _internals.append(coarsener->policyString() + " " + refiner->policyString());
+    }
+  }
+
+  if (current_config.partition.verbose_output) {
+    io::printHypergraphInfo(hypergraph, "---");
+  }
+
+  // TODO(schlag): we could integrate v-cycles in a similar fashion as is
+  // performDirectKwayPartitioning
+  performPartitioning(hypergraph, *coarsener, *refiner, current_config);
+
+  if (current_config.partition.verbose_output) {
+    LOG("-------------------------------------------------------------");
+  }
+}
+
 inline void Partitioner::performRecursiveBisectionPartitioning(Hypergraph& input_hypergraph,
                                                                const Configuration& original_config) {
+  // Nothing has to be bisected if all hypernodes belong to a single block.
+  if (original_config.partition.k == 1 || input_hypergraph.currentNumNodes() == 0) {
+    input_hypergraph.resetPartitioning();
+    for (const HypernodeID hn : input_hypergraph.nodes()) {
+      input_hypergraph.setNodePart(hn, 0);
+    }
+    input_hypergraph.initializeNumCutHyperedges();
+    return;
+  }
+  if (original_config.partition.rb_num_threads > 1) {
+    performParallelRecursiveBisectionPartitioning(input_hypergraph, original_config);
+    return;
+  }
   // Custom deleters for Hypergraphs stored in hypergraph_stack. The top-level
   // hypergraph is the input hypergraph, which is not supposed to be deleted.
   // All extracted hypergraphs however can be deleted as soon as they are not needed
@@ -614,9 +783,12 @@ inline void Partitioner::performRecursiveBisectionPartitioning(Hypergraph& input
   while (!hypergraph_stack.empty()) {
     Hypergraph& current_hypergraph = *hypergraph_stack.back().hypergraph;
 
-    if (hypergraph_stack.back().lower_k == hypergraph_stack.back().upper_k) {
+    // Subproblems without hypernodes cannot be bisected and are finished as well.
+    if (hypergraph_stack.back().lower_k == hypergraph_stack.back().upper_k ||
+        current_hypergraph.currentNumNodes() == 0) {
+      ASSERT(!mapping_stack.empty(), "The top-level hypergraph is not a leaf");
       for (const HypernodeID hn : current_hypergraph.nodes()) {
-        const HypernodeID original_hn = originalHypernode(hn, mapping_stack);
+        const HypernodeID original_hn = mapping_stack.back()[hn];
         const PartitionID current_part = input_hypergraph.partID(original_hn);
         ASSERT(current_part != Hypergraph::kInvalidPartition, V(current_part));
         if (current_part != hypergraph_stack.back().lower_k) {
@@ -643,46 +815,13 @@ inline void Partitioner::performRecursiveBisectionPartitioning(Hypergraph& input
         }
         break;
       case RBHypergraphState::unpartitioned: {
-          Configuration current_config =
-            createConfigurationForCurrentBisection(original_config,
-                                                   input_hypergraph, current_hypergraph, k, km,
-                                                   k - km);
-          current_config.partition.rb_lower_k = k1;
-          current_config.partition.rb_upper_k = k2;
-
-          std::unique_ptr<ICoarsener> coarsener(
-            CoarsenerFactory::getInstance().createObject(
-              current_config.coarsening.algorithm,
-              current_hypergraph, current_config,
-              current_hypergraph.weightOfHeaviestNode()));
-
-          std::unique_ptr<IRefiner> refiner(
-            RefinerFactory::getInstance().createObject(
-              current_config.local_search.algorithm,
-              current_hypergraph, current_config));
-
-          ASSERT(coarsener.get() != nullptr, "coarsener not found");
-          ASSERT(refiner.get() != nullptr, "refiner not found");
-
-          // TODO(schlag): find better solution
-          if (_internals.empty()) {
-            _internals.append(coarsener->policyString() + " " + refiner->policyString());
-          }
-
-          if (current_config.partition.verbose_output) {
-            io::printHypergraphInfo(current_hypergraph, "---");
-          }
-
-          // TODO(schlag): we could integrate v-cycles in a similar fashion as is
-          // performDirectKwayPartitioning
-          performPartitioning(current_hypergraph, *coarsener, *refiner, current_config);
-
-          if (current_config.partition.verbose_output) {
-            LOG("-------------------------------------------------------------");
-          }
+          bisect(current_hypergraph, input_hypergraph, k1, k2, original_config);
 
           auto extractedHypergraph_1 = ds::extractPartAsUnpartitionedHypergraphForBisection(
-            current_hypergraph, 1, current_config.partition.objective == Objective::km1 ? true : false);
+            current_hypergraph, 1, original_config.partition.objective == Objective::km1 ? true : false);
+          if (!mapping_stack.empty()) {
+            composeMapping(extractedHypergraph_1.second, mapping_stack.back());
+          }
           mapping_stack.emplace_back(std::move(extractedHypergraph_1.second));
 
           hypergraph_stack.back().state =
@@ -696,6 +835,12 @@ inline void Partitioner::performRecursiveBisectionPartitioning(Hypergraph& input
           auto extractedHypergraph_0 =
             ds::extractPartAsUnpartitionedHypergraphForBisection(
               current_hypergraph, 0, original_config.partition.objective == Objective::km1 ? true : false);
+          if (!mapping_stack.empty()) {
+            composeMapping(extractedHypergraph_0.second, mapping_stack.back());
+            // Both subproblems map directly to the input hypergraph. Thus the mapping of
+            // the current hypergraph is not needed anymore.
+            Mapping().swap(mapping_stack.back());
+          }
           mapping_stack.emplace_back(std::move(extractedHypergraph_0.second));
           hypergraph_stack.back().state = RBHypergraphState::finished;
           hypergraph_stack.emplace_back(HypergraphPtr(extractedHypergraph_0.first.release(),
@@ -707,6 +852,98 @@ inline void Partitioner::performRecursiveBisectionPartitioning(Hypergraph& input
   }
 }
 
+// After each bisection, the subproblems of block 0 and block 1 are independent. The
+// subproblem of block 1 is handed to a new thread if one of the rb_num_threads threads
+// is idle and is solved by the current thread otherwise. A thread that waits for its
+// child does not count as busy. Since concurrent moves in the input hypergraph would
+// race, the leaves only store the final block of each hypernode in final_parts, which
+// is applied to the input hypergraph once all subproblems are solved.
+inline void Partitioner::performParallelRecursiveBisectionPartitioning(
+  Hypergraph& input_hypergraph, const Configuration& original_config) {
+  std::vector<PartitionID> final_parts(input_hypergraph.initialNumNodes(),
+                                       Hypergraph::kInvalidPartition);
+  std::atomic<int> idle_threads(original_config.partition.rb_num_threads - 1);
+  bisectRecursively(HypergraphPtr(&input_hypergraph, [](Hypergraph*) { }), input_hypergraph,
+                    0, original_config.partition.k - 1, Mapping(), final_parts,
+                    idle_threads, original_config);
+
+  for (const HypernodeID hn : input_hypergraph.nodes()) {
+    ASSERT(final_parts[hn] != Hypergraph::kInvalidPartition, V(hn));
+    if (input_hypergraph.partID(hn) != final_parts[hn]) {
+      input_hypergraph.changeNodePart(hn, input_hypergraph.partID(hn), final_parts[hn]);
+    }
+  }
+}
+
+inline void Partitioner::bisectRecursively(HypergraphPtr hypergraph,
+                                           const Hypergraph& input_hypergraph,
+                                           const PartitionID lower_k,
+                                           const PartitionID upper_k,
+                                           Mapping mapping,
+                                           std::vector<PartitionID>& final_parts,
+                                           std::atomic<int>& idle_threads,
+                                           const Configuration& original_config) {
+  if (lower_k == upper_k || hypergraph->currentNumNodes() == 0) {
+    ASSERT(hypergraph.get() != &input_hypergraph, "The top-level hypergraph is not a leaf");
+    for (const HypernodeID hn : hypergraph->nodes()) {
+      final_parts[mapping[hn]] = lower_k;
+    }
+    return;
+  }
+
+  bisect(*hypergraph, input_hypergraph, lower_k, upper_k, original_config);
+
+  const bool km1 = original_config.partition.objective == Objective::km1;
+  auto extracted_hypergraph_1 = ds::extractPartAsUnpartitionedHypergraphForBisection(
+    *hypergraph, 1, km1);
+  auto extracted_hypergraph_0 = ds::extractPartAsUnpartitionedHypergraphForBisection(
+    *hypergraph, 0, km1);
+  hypergraph.reset();
+  composeMapping(extracted_hypergraph_1.second, mapping);
+  composeMapping(extracted_hypergraph_0.second, mapping);
+  Mapping().swap(mapping);
+
+  // The seeds are drawn before any subproblem is started. Thus the partition depends
+  // neither on the number of threads nor on the order in which subproblems are solved.
+  const int seed_1 = Randomize::instance().newRandomSeed();
+  const int seed_0 = Randomize::instance().newRandomSeed();
+
+  const PartitionID km = (upper_k - lower_k + 1) / 2;
+  auto solve_block_1 = [&]() {
+                         Randomize::instance().setSeed(seed_1);
+                         bisectRecursively(HypergraphPtr(extracted_hypergraph_1.first.release(),
+                                                         [](Hypergraph* h) { delete h; }),
+                                           input_hypergraph, lower_k + km, upper_k,
+                                           std::move(extracted_hypergraph_1.second),
+                                           final_parts, idle_threads,
+                                           original_config);
+                       };
+
+  std::thread block_1_thread;
+  if (idle_threads.fetch_sub(1) > 0) {
+    block_1_thread = std::thread([&]() {
+                                   solve_block_1();
+                                   ++idle_threads;
+                                 });
+  } else {
+    ++idle_threads;
+    solve_block_1();
+  }
+
+  Randomize::instance().setSeed(seed_0);
+  bisectRecursively(HypergraphPtr(extracted_hypergraph_0.first.release(),
+                                  [](Hypergraph* h) { delete h; }),
+                    input_hypergraph, lower_k, lower_k + km - 1,
+                    std::move(extracted_hypergraph_0.second), final_parts, idle_threads,
+                    original_config);
+
+  if (block_1_thread.joinable()) {
+    ++idle_threads;
+    block_1_thread.join();
+    --idle_threads;
+  }
+}
+
 inline void Partitioner::performDirectKwayPartitioning(Hypergraph& hypergraph,
                                                        const Configuration& config) {
   std::unique_ptr<ICoarsener> coarsener(
@@ -719,7 +956,10 @@ inline void Partitioner::performDirectKwayPartitioning(Hypergraph& hypergraph,
       config.local_search.algorithm, hypergraph, config));
 
   // TODO(schlag): find better solution
-  _internals.append(coarsener->policyString() + " " + refiner->policyString());
+  {
+    std::lock_guard<std::mutex> lock(_internals_mutex);
+    _internals.append(coarsener->policyString() + " " + refiner->policyString());
+  }
 
   performPartitioning(hypergraph, *coarsener, *refiner, config);
 
@@ -730,6 +970,10 @@ inline void Partitioner::performDirectKwayPartitioning(Hypergraph& hypergraph,
 #endif
 
   for (int vcycle = 1; vcycle <= config.partition.global_search_iterations; ++vcycle) {
+    if (RefinementScheduler::deadlinePassed(config)) {
+      LOG("Time limit reached before v-cycle " << vcycle << ". Stopping global search.");
+      break;
+    }
     const bool found_improved_cut = partitionVCycle(hypergraph, *coarsener, *refiner, config);
 
     DBG(dbg_partition_vcycles, V(vcycle) << V(metrics::hyperedgeCut(hypergraph)));
@@ -56,21 +56,27 @@ static const bool dbg_refinement_2way_locked_hes = false;
 
 template <class StoppingPolicy = Mandatory,
           class UseGlobalRebalancing = NoGlobalRebalancing,
+          class GainQueue = HeapGainQueue,
           class FMImprovementPolicy = CutDecreasedOrInfeasibleImbalanceDecreased>
 class TwoWayFMRefiner final : public IRefiner,
-                              private FMRefinerBase<HypernodeID>{
+                              private FMRefinerBase<HypernodeID, GainQueue>{
  private:
   using RebalancePQ = ds::BinaryMaxHeap<HypernodeID, Gain>;
   using HypernodeWeightArray = std::array<HypernodeWeight, 2>;
-  using Base = FMRefinerBase<HypernodeID>;
+  using Base = FMRefinerBase<HypernodeID, GainQueue>;
+  using HEState = typename Base::HEState;
+  using Base::kInvalidHN;
+  using Base::kInvalidGain;
+  using Base::reset;
 
  public:
   TwoWayFMRefiner(Hypergraph& hypergraph, const Configuration& config) :
-    FMRefinerBase(hypergraph, config),
+    Base(hypergraph, config),
     _rebalance_pqs({ RebalancePQ(_hg.initialNumNodes()), RebalancePQ(_hg.initialNumNodes()) }),
     _he_fully_active(_hg.initialNumEdges()),
     _hns_in_activation_vector(_hg.initialNumNodes()),
     _non_border_hns_to_remove(),
+    _unique_refinement_nodes(),
     _disabled_rebalance_hns(_hg.initialNumNodes()),
     _gain_cache(_hg.initialNumNodes()),
     _locked_hes(_hg.initialNumEdges(), HEState::free),
@@ -145,12 +151,7 @@ class TwoWayFMRefiner final : public IRefiner,
 
   void initializeImpl(const HyperedgeWeight max_gain) override final {
     if (!_is_initialized) {
-#ifdef USE_BUCKET_QUEUE
-      _pq.initialize(_hg.initialNumNodes(), max_gain);
-#else
-      (void)max_gain;
-      _pq.initialize(_hg.initialNumNodes());
-#endif
+      Base::initializePQ(max_gain);
       _is_initialized = true;
     }
     if (UseGlobalRebalancing()) {
@@ -182,27 +183,49 @@ class TwoWayFMRefiner final : public IRefiner,
     _he_fully_active.reset();
     _locked_hes.resetUsedEntries();
 
-    // Will always be the case in the first FM pass, since the just uncontracted HN
-    // was not seen before.
-    ASSERT(changes.representative.size() == 1, V(changes.representative.size()));
-    ASSERT(changes.contraction_partner.size() == 1, V(changes.contraction_partner.size()));
-    if (!_gain_cache.isCached(refinement_nodes[1])) {
-      // In further FM passes, changes will be set to 0 by the caller.
-      if (_gain_cache.isCached(refinement_nodes[0])) {
-        _gain_cache.setValue(refinement_nodes[1], _gain_cache.value(refinement_nodes[0])
-                             + changes.contraction_partner[0]);
-        _gain_cache.updateValue(refinement_nodes[0], changes.representative[0]);
-        if (UseGlobalRebalancing()) {
-          _rebalance_pqs[1 - _hg.partID(refinement_nodes[0])].updateKeyBy(refinement_nodes[0],
-                                                                          changes.representative[0]);
-          _rebalance_pqs[1 - _hg.partID(refinement_nodes[1])].push(refinement_nodes[1],
-                                                                   _gain_cache.value(refinement_nodes[1]));
+    // If several contractions were undone before this call, refinement_nodes contains
+    // the (representative, contraction partner) pair of each uncontraction in the order
+    // in which they were performed and changes contains the corresponding gain changes.
+    // Applying them in that order yields the same gain cache as refining after each
+    // single uncontraction (without moving any hypernodes).
+    ASSERT(changes.representative.size() == changes.contraction_partner.size(),
+           V(changes.representative.size()) << V(changes.contraction_partner.size()));
+    ASSERT(2 * changes.representative.size() <= refinement_nodes.size(),
+           V(changes.representative.size()) << V(refinement_nodes.size()));
+    for (size_t i = 0; i < changes.representative.size(); ++i) {
+      const HypernodeID rep = refinement_nodes[2 * i];
+      const HypernodeID partner = refinement_nodes[2 * i + 1];
+      // Will always be the case in the first FM pass, since the just uncontracted HN
+      // was not seen before.
+      if (!_gain_cache.isCached(partner)) {
+        // In further FM passes, changes will be set to 0 by the caller.
+        if (_gain_cache.isCached(rep)) {
+          _gain_cache.setValue(partner, _gain_cache.value(rep)
+                               + changes.contraction_partner[i]);
+          _gain_cache.updateValue(rep, changes.representative[i]);
+          if (UseGlobalRebalancing()) {
+            _rebalance_pqs[1 - _hg.partID(rep)].updateKeyBy(rep, changes.representative[i]);
+            _rebalance_pqs[1 - _hg.partID(partner)].push(partner, _gain_cache.value(partner));
+          }
         }
       }
     }
 
-    Randomize::instance().shuffleVector(refinement_nodes, refinement_nodes.size());
-    for (const HypernodeID hn : refinement_nodes) {
+    // A hypernode might have been the representative of several uncontractions. The
+    // duplicates are removed from a copy, since further FM passes on the same batch
+    // still expect the (representative, contraction partner) pairs in refinement_nodes.
+    std::vector<HypernodeID>* nodes_to_activate = &refinement_nodes;
+    if (refinement_nodes.size() > 2) {
+      _unique_refinement_nodes = refinement_nodes;
+      std::sort(_unique_refinement_nodes.begin(), _unique_refinement_nodes.end());
+      _unique_refinement_nodes.erase(std::unique(_unique_refinement_nodes.begin(),
+                                                 _unique_refinement_nodes.end()),
+                                     _unique_refinement_nodes.end());
+      nodes_to_activate = &_unique_refinement_nodes;
+    }
+
+    Randomize::instance().shuffleVector(*nodes_to_activate, nodes_to_activate->size());
+    for (const HypernodeID hn : *nodes_to_activate) {
       activate(hn, max_allowed_part_weights);
 
       // If Lmax0==Lmax1, then all border nodes should be active. However, if Lmax0 != Lmax1,
@@ -227,7 +250,8 @@ class TwoWayFMRefiner final : public IRefiner,
     const double beta = log(_hg.currentNumNodes());
     while (!_pq.empty() &&
            !_stopping_policy.searchShouldStop(touched_hns_since_last_improvement,
-                                              _config, beta, best_metrics.cut, current_cut)) {
+                                              _config, beta, best_metrics.cut, current_cut) &&
+           !moveBudgetExhausted(_performed_moves.size())) {
       ASSERT(_pq.isEnabled(0) || _pq.isEnabled(1));
 
       Gain max_gain = kInvalidGain;
@@ -347,6 +371,7 @@ class TwoWayFMRefiner final : public IRefiner,
       restoreRebalancePQ();
     }
 
+    _num_performed_moves = _performed_moves.size();
     rollback(_performed_moves.size() - 1, min_cut_index);
     _gain_cache.rollbackDelta<UseGlobalRebalancing>(_rebalance_pqs, _hg);
 
@@ -902,12 +927,7 @@ class TwoWayFMRefiner final : public IRefiner,
   std::string policyStringImpl() const override final {
     return std::string(" RefinerStoppingPolicy=" + meta::templateToString<StoppingPolicy>() +
                        " RefinerGlobalRebalacing=" + meta::templateToString<UseGlobalRebalancing>() +
-                       " RefinerUsesBucketQueue=" +
-#ifdef USE_BUCKET_PQ
-                       "true");
-#else
-                       "false");
-#endif
+                       " RefinerGainQueue=" + meta::templateToString<GainQueue>());
   }
 
   void updatePin(const HypernodeID pin, const Gain gain_delta) KAHYPAR_ATTRIBUTE_ALWAYS_INLINE {
@@ -982,6 +1002,7 @@ class TwoWayFMRefiner final : public IRefiner,
   ds::FastResetFlagArray<> _he_fully_active;
   ds::FastResetFlagArray<> _hns_in_activation_vector;  // faster than using a SparseSet in this case
   std::vector<HypernodeID> _non_border_hns_to_remove;
+  std::vector<HypernodeID> _unique_refinement_nodes;
   ds::SparseSet<HypernodeID> _disabled_rebalance_hns;
   TwoWayFMGainCache<Gain> _gain_cache;
   ds::FastResetArray<PartitionID> _locked_hes;
@@ -23,10 +23,10 @@
 #include <limits>
 #include <vector>
 
-#include "kahypar/datastructure/bucket_queue.h"
-#include "kahypar/datastructure/kway_priority_queue.h"
 #include "kahypar/definitions.h"
+#include "kahypar/meta/mandatory.h"
 #include "kahypar/partition/configuration.h"
+#include "kahypar/partition/refinement/policies/gain_queue_policy.h"
 
 namespace kahypar {
 static const bool dbg_refinement_fm_border_node_check = false;
@@ -38,7 +38,8 @@ struct RollbackInfo {
   PartitionID to_part;
 };
 
-template <typename RollbackElement = Mandatory>
+template <typename RollbackElement = Mandatory,
+          class GainQueue = HeapGainQueue>
 class FMRefinerBase {
  protected:
   static constexpr HypernodeID kInvalidHN = std::numeric_limits<HypernodeID>::max();
@@ -50,18 +51,7 @@ class FMRefinerBase {
     locked = std::numeric_limits<PartitionID>::max(),
   };
 
-#ifdef USE_BUCKET_QUEUE
-  using KWayRefinementPQ = ds::KWayPriorityQueue<HypernodeID, Gain,
-                                                 std::numeric_limits<Gain>,
-                                                 false,
-                                                 ds::EnhancedBucketQueue<HypernodeID,
-                                                                         Gain,
-                                                                         std::numeric_limits<Gain>
-                                                                         > >;
-#else
-  using KWayRefinementPQ = ds::KWayPriorityQueue<HypernodeID, Gain,
-                                                 std::numeric_limits<Gain> >;
-#endif
+  using KWayRefinementPQ = typename GainQueue::template KWayPQ<false>;
 
 
   FMRefinerBase(Hypergraph& hypergraph, const Configuration& config) :
@@ -82,6 +72,11 @@ class FMRefinerBase {
   FMRefinerBase(FMRefinerBase&&) = delete;
   FMRefinerBase& operator= (FMRefinerBase&&) = delete;
 
+  // max_gain is only used by queues with a bounded key range.
+  void initializePQ(const HyperedgeWeight max_gain) {
+    GainQueue::initialize(_pq, _hg.initialNumNodes(), max_gain);
+  }
+
   bool hypernodeIsConnectedToPart(const HypernodeID pin, const PartitionID part) const {
     for (const HyperedgeID he : _hg.incidentEdges(pin)) {
       if (_hg.pinCountInPart(he, part) > 0) {
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <array>
+#include <limits>
 #include <string>
 #include <utility>
 #include <vector>
@@ -56,11 +57,30 @@ class IRefiner {
     return policyStringImpl();
   }
 
+  // Limits the number of moves (including moves that are rolled back) of each
+  // subsequent call to refine(). Only the FM refiners respect the budget.
+  void setMoveBudget(const int move_budget) {
+    _move_budget = move_budget;
+  }
+
+  // Number of moves performed by the last call to refine() of a refiner that
+  // respects move budgets.
+  int numPerformedMoves() const {
+    return _num_performed_moves;
+  }
+
   virtual ~IRefiner() { }
 
  protected:
   IRefiner() { }
+
+  bool moveBudgetExhausted(const int num_moves) const {
+    return num_moves >= _move_budget;
+  }
+
   bool _is_initialized = false;
+  int _move_budget = std::numeric_limits<int>::max();
+  int _num_performed_moves = 0;
 
  private:
   virtual bool refineImpl(std::vector<HypernodeID>& refinement_nodes,
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <limits>
+#include <memory>
 #include <stack>
 #include <string>
 #include <tuple>
@@ -39,16 +40,19 @@
 #include "kahypar/partition/metrics.h"
 #include "kahypar/partition/refinement/fm_refiner_base.h"
 #include "kahypar/partition/refinement/i_refiner.h"
-#include "kahypar/partition/refinement/kway_fm_gain_cache.h"
+#include "kahypar/partition/refinement/parallel_gain_cache_initialization.h"
 #include "kahypar/partition/refinement/policies/fm_improvement_policy.h"
+#include "kahypar/partition/refinement/policies/gain_cache_policy.h"
 #include "kahypar/utils/float_compare.h"
 #include "kahypar/utils/randomize.h"
 
 namespace kahypar {
 template <class StoppingPolicy = Mandatory,
+          class GainCacheLayout = DenseGainCache,
+          class GainQueue = HeapGainQueue,
           class FMImprovementPolicy = CutDecreasedOrInfeasibleImbalanceDecreased>
 class KWayFMRefiner final : public IRefiner,
-                            private FMRefinerBase<RollbackInfo>{
+                            private FMRefinerBase<RollbackInfo, GainQueue>{
   static const bool dbg_refinement_kway_fm_activation = false;
   static const bool dbg_refinement_kway_fm_improvements_cut = false;
   static const bool dbg_refinement_kway_fm_improvements_balance = false;
@@ -59,18 +63,35 @@ class KWayFMRefiner final : public IRefiner,
   static const bool dbg_refinement_kway_infeasible_moves = false;
   static const bool dbg_refinement_kway_gain_caching = false;
   static const HypernodeID hn_to_debug = 4242;
-  using GainCache = KwayGainCache<Gain>;
-  using Base = FMRefinerBase<RollbackInfo>;
+  using GainCache = typename GainCacheLayout::Cache;
+  using Base = FMRefinerBase<RollbackInfo, GainQueue>;
+  using HEState = typename Base::HEState;
+  using Base::kInvalidHN;
+  using Base::kInvalidGain;
+  using Base::moveIsFeasible;
+  using Base::moveHypernode;
+  using Base::hypernodeIsConnectedToPart;
+  using Base::heaviestPart;
+  using Base::reCalculateHeaviestPartAndItsWeight;
+  using Base::reset;
 
  public:
   KWayFMRefiner(Hypergraph& hypergraph, const Configuration& config) :
-    FMRefinerBase(hypergraph, config),
+    Base(hypergraph, config),
     _he_fully_active(_hg.initialNumEdges()),
     _tmp_gains(_config.partition.k, 0),
+    _thread_tmp_gains(),
     _already_processed_part(_hg.initialNumNodes(), Hypergraph::kInvalidPartition),
     _locked_hes(_hg.initialNumEdges(), HEState::free),
     _gain_cache(_hg.initialNumNodes(), _config.partition.k),
-    _stopping_policy() { }
+    _stopping_policy() {
+    if (GainCacheLayout::concurrent_initialization) {
+      for (unsigned int i = 1; i < _config.local_search.num_threads; ++i) {
+        _thread_tmp_gains.emplace_back(
+          new ds::SparseMap<PartitionID, Gain>(_config.partition.k, 0));
+      }
+    }
+  }
 
   virtual ~KWayFMRefiner() { }
 
@@ -87,12 +108,7 @@ class KWayFMRefiner final : public IRefiner,
 
   void initializeImpl(const HyperedgeWeight max_gain) override final {
     if (!_is_initialized) {
-#ifdef USE_BUCKET_QUEUE
-      _pq.initialize(_hg.initialNumNodes(), max_gain);
-#else
-      (void)max_gain;
-      _pq.initialize(_hg.initialNumNodes());
-#endif
+      Base::initializePQ(max_gain);
       _is_initialized = true;
     }
     _gain_cache.clear();
@@ -136,7 +152,8 @@ class KWayFMRefiner final : public IRefiner,
     const double beta = log(_hg.currentNumNodes());
     while (!_pq.empty() &&
            !_stopping_policy.searchShouldStop(touched_hns_since_last_improvement,
-                                              _config, beta, best_metrics.cut, current_cut)) {
+                                              _config, beta, best_metrics.cut, current_cut) &&
+           !moveBudgetExhausted(_performed_moves.size())) {
       Gain max_gain = kInvalidGain;
       HypernodeID max_gain_node = kInvalidHN;
       PartitionID to_part = Hypergraph::kInvalidPartition;
@@ -240,6 +257,7 @@ class KWayFMRefiner final : public IRefiner,
                                               best_metrics.cut, current_cut)
             == true ? "policy" : "empty queue"));
 
+    _num_performed_moves = _performed_moves.size();
     rollback(_performed_moves.size() - 1, min_cut_index);
     _gain_cache.rollbackDelta();
 
@@ -254,13 +272,8 @@ class KWayFMRefiner final : public IRefiner,
 
   std::string policyStringImpl() const override final {
     return std::string(" RefinerStoppingPolicy=" + meta::templateToString<StoppingPolicy>() +
-                       " RefinerUsesBucketQueue=" +
-#ifdef USE_BUCKET_PQ
-                       "true"
-#else
-                       "false"
-#endif
-                       );
+                       " RefinerGainCache=" + meta::templateToString<GainCacheLayout>() +
+                       " RefinerGainQueue=" + meta::templateToString<GainQueue>());
   }
 
   void rollback(int last_index, const int min_cut_index) {
@@ -968,7 +981,7 @@ class KWayFMRefiner final : public IRefiner,
     // have to invalidate and recalculate the gains.
     if (invalidate_hn) {
       _gain_cache.clear(hn);
-      initializeGainCacheFor(hn);
+      initializeGainCacheFor(hn, _tmp_gains);
     }
 
     if (_hg.isBorderNode(hn)) {
@@ -997,16 +1010,18 @@ class KWayFMRefiner final : public IRefiner,
   }
 
   void initializeGainCache() {
-    for (const HypernodeID hn : _hg.nodes()) {
-      initializeGainCacheFor(hn);
-    }
+    initializeGainCacheInParallel(_hg, _thread_tmp_gains.size() + 1,
+                                  [&](const HypernodeID hn, const size_t thread) {
+          initializeGainCacheFor(hn, thread == 0 ? _tmp_gains : *_thread_tmp_gains[thread - 1]);
+        });
   }
 
-  void initializeGainCacheFor(const HypernodeID hn) {
+  void initializeGainCacheFor(const HypernodeID hn,
+                              ds::SparseMap<PartitionID, Gain>& tmp_gains) {
     const PartitionID source_part = _hg.partID(hn);
     HyperedgeWeight internal_weight = 0;
 
-    _tmp_gains.clear();
+    tmp_gains.clear();
 
     for (const HyperedgeID he : _hg.incidentEdges(hn)) {
       const HyperedgeWeight he_weight = _hg.edgeWeight(he);
@@ -1017,21 +1032,21 @@ class KWayFMRefiner final : public IRefiner,
           break;
         case 2:
           for (const PartitionID part : _hg.connectivitySet(he)) {
-            _tmp_gains.add(part, 0);
+            tmp_gains.add(part, 0);
             if (_hg.pinCountInPart(he, part) == _hg.edgeSize(he) - 1) {
-              _tmp_gains[part] += he_weight;
+              tmp_gains[part] += he_weight;
             }
           }
           break;
         default:
           for (const PartitionID part : _hg.connectivitySet(he)) {
-            _tmp_gains.add(part, 0);
+            tmp_gains.add(part, 0);
           }
           break;
       }
     }
 
-    for (const auto& target_part : _tmp_gains) {
+    for (const auto& target_part : tmp_gains) {
       if (target_part.key == source_part) {
         continue;
       }
@@ -1109,6 +1124,8 @@ class KWayFMRefiner final : public IRefiner,
 
   ds::FastResetFlagArray<> _he_fully_active;
   ds::SparseMap<PartitionID, Gain> _tmp_gains;
+  // Scratch maps of the additional threads that initialize the gain cache.
+  std::vector<std::unique_ptr<ds::SparseMap<PartitionID, Gain> > > _thread_tmp_gains;
 
   // After a move, we have to update the gains for all adjacent HNs.
   // For all moves of a HN that were already present in the PQ before the
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <limits>
+#include <memory>
 #include <stack>
 #include <string>
 #include <tuple>
@@ -31,7 +32,7 @@
 #include "gtest/gtest_prod.h"
 
 #include "kahypar/datastructure/fast_reset_array.h"
-#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/fast_reset_hash_set.h"
 #include "kahypar/datastructure/sparse_map.h"
 #include "kahypar/definitions.h"
 #include "kahypar/meta/mandatory.h"
@@ -40,16 +41,19 @@
 #include "kahypar/partition/metrics.h"
 #include "kahypar/partition/refinement/fm_refiner_base.h"
 #include "kahypar/partition/refinement/i_refiner.h"
-#include "kahypar/partition/refinement/kway_fm_gain_cache.h"
+#include "kahypar/partition/refinement/parallel_gain_cache_initialization.h"
 #include "kahypar/partition/refinement/policies/fm_improvement_policy.h"
+#include "kahypar/partition/refinement/policies/gain_cache_policy.h"
 #include "kahypar/utils/float_compare.h"
 #include "kahypar/utils/randomize.h"
 
 namespace kahypar {
 template <class StoppingPolicy = Mandatory,
+          class GainCacheLayout = DenseGainCache,
+          class GainQueue = HeapGainQueue,
           class FMImprovementPolicy = CutDecreasedOrInfeasibleImbalanceDecreased>
 class KWayKMinusOneRefiner final : public IRefiner,
-                                   private FMRefinerBase<RollbackInfo>{
+                                   private FMRefinerBase<RollbackInfo, GainQueue>{
   static const bool dbg_refinement_kway_kminusone_fm_activation = false;
   static const bool dbg_refinement_kway_kminusone_fm_improvements_cut = false;
   static const bool dbg_refinement_kway_kminusone_fm_improvements_balance = false;
@@ -61,8 +65,16 @@ class KWayKMinusOneRefiner final : public IRefiner,
   static const HypernodeID hn_to_debug = 5589;
 
 
-  using GainCache = KwayGainCache<Gain>;
-  using Base = FMRefinerBase<RollbackInfo>;
+  using GainCache = typename GainCacheLayout::Cache;
+  using Base = FMRefinerBase<RollbackInfo, GainQueue>;
+  using Base::kInvalidHN;
+  using Base::kInvalidGain;
+  using Base::moveIsFeasible;
+  using Base::moveHypernode;
+  using Base::hypernodeIsConnectedToPart;
+  using Base::heaviestPart;
+  using Base::reCalculateHeaviestPartAndItsWeight;
+  using Base::reset;
 
 
   struct PinState {
@@ -81,12 +93,20 @@ class KWayKMinusOneRefiner final : public IRefiner,
 
  public:
   KWayKMinusOneRefiner(Hypergraph& hypergraph, const Configuration& config) :
-    FMRefinerBase(hypergraph, config),
+    Base(hypergraph, config),
     _tmp_gains(_config.partition.k, 0),
+    _thread_tmp_gains(),
     _new_adjacent_part(_hg.initialNumNodes(), Hypergraph::kInvalidPartition),
-    _unremovable_he_parts(_hg.initialNumEdges() * config.partition.k),
+    _unremovable_he_parts(),
     _gain_cache(_hg.initialNumNodes(), _config.partition.k),
-    _stopping_policy() { }
+    _stopping_policy() {
+    if (GainCacheLayout::concurrent_initialization) {
+      for (unsigned int i = 1; i < _config.local_search.num_threads; ++i) {
+        _thread_tmp_gains.emplace_back(
+          new ds::SparseMap<PartitionID, Gain>(_config.partition.k, 0));
+      }
+    }
+  }
 
   virtual ~KWayKMinusOneRefiner() { }
 
@@ -99,12 +119,7 @@ class KWayKMinusOneRefiner final : public IRefiner,
  private:
   void initializeImpl(const HyperedgeWeight max_gain) override final {
     if (!_is_initialized) {
-#ifdef USE_BUCKET_QUEUE
-      _pq.initialize(_hg.initialNumNodes(), max_gain);
-#else
-      (void)max_gain;
-      _pq.initialize(_hg.initialNumNodes());
-#endif
+      Base::initializePQ(max_gain);
       _is_initialized = true;
     }
     _gain_cache.clear();
@@ -123,7 +138,7 @@ class KWayKMinusOneRefiner final : public IRefiner,
            V(best_metrics.imbalance) << V(metrics::imbalance(_hg, _config)));
 
     reset();
-    _unremovable_he_parts.reset();
+    _unremovable_he_parts.clear();
 
     Randomize::instance().shuffleVector(refinement_nodes, refinement_nodes.size());
     for (const HypernodeID hn : refinement_nodes) {
@@ -147,7 +162,8 @@ class KWayKMinusOneRefiner final : public IRefiner,
     const double beta = log(_hg.currentNumNodes());
     while (!_pq.empty() && !_stopping_policy.searchShouldStop(touched_hns_since_last_improvement,
                                                               _config, beta, best_metrics.km1,
-                                                              current_km1)) {
+                                                              current_km1) &&
+           !moveBudgetExhausted(_performed_moves.size())) {
       Gain max_gain = kInvalidGain;
       HypernodeID max_gain_node = kInvalidHN;
       PartitionID to_part = Hypergraph::kInvalidPartition;
@@ -250,7 +266,7 @@ class KWayKMinusOneRefiner final : public IRefiner,
               }
             }
           }
-          _unremovable_he_parts.set(he * _config.partition.k + from_part, 1);
+          markAsUnremovable(he, from_part);
         }
       }
     }
@@ -261,6 +277,7 @@ class KWayKMinusOneRefiner final : public IRefiner,
                                               best_metrics.km1, current_km1)
             == true ? "policy" : "empty queue"));
 
+    _num_performed_moves = _performed_moves.size();
     rollback(_performed_moves.size() - 1, min_cut_index);
     _gain_cache.rollbackDelta();
 
@@ -275,13 +292,8 @@ class KWayKMinusOneRefiner final : public IRefiner,
 
   std::string policyStringImpl() const override final {
     return std::string(" RefinerStoppingPolicy=" + meta::templateToString<StoppingPolicy>() +
-                       " RefinerUsesBucketQueue=" +
-#ifdef USE_BUCKET_PQ
-                       "true"
-#else
-                       "false"
-#endif
-                       );
+                       " RefinerGainCache=" + meta::templateToString<GainCacheLayout>() +
+                       " RefinerGainQueue=" + meta::templateToString<GainQueue>());
   }
 
   void rollback(int last_index, const int min_cut_index) {
@@ -612,24 +624,27 @@ class KWayKMinusOneRefiner final : public IRefiner,
     }
   }
 
+  bool isUnremovable(const HyperedgeID he, const PartitionID part) const {
+    return _unremovable_he_parts.contains(static_cast<uint64_t>(he) * _config.partition.k + part);
+  }
+
+  void markAsUnremovable(const HyperedgeID he, const PartitionID part) {
+    _unremovable_he_parts.add(static_cast<uint64_t>(he) * _config.partition.k + part);
+  }
+
   bool fromAndToPartAreUnremovable(const HyperedgeID he, const PartitionID from_part,
                                    const PartitionID to_part) const {
-    return _unremovable_he_parts[he * _config.partition.k + from_part] &&
-           _unremovable_he_parts[he * _config.partition.k + to_part];
+    return isUnremovable(he, from_part) && isUnremovable(he, to_part);
   }
 
   bool fromAndToPartHaveUnequalStates(const HyperedgeID he, const PartitionID from_part,
                                       const PartitionID to_part) const {
-    return (!_unremovable_he_parts[he * _config.partition.k + from_part] &&
-            _unremovable_he_parts[he * _config.partition.k + to_part]) ||
-           (_unremovable_he_parts[he * _config.partition.k + from_part] &&
-            !_unremovable_he_parts[he * _config.partition.k + to_part]);
+    return isUnremovable(he, from_part) != isUnremovable(he, to_part);
   }
 
   bool moveFromUnremovableToRemovablePart(const HyperedgeID he, const PartitionID from_part,
                                           const PartitionID to_part) const {
-    return _unremovable_he_parts[he * _config.partition.k + from_part] &&
-           !_unremovable_he_parts[he * _config.partition.k + to_part];
+    return isUnremovable(he, from_part) && !isUnremovable(he, to_part);
   }
 
 
@@ -665,7 +680,7 @@ class KWayKMinusOneRefiner final : public IRefiner,
       } else {
         fullUpdate(moved_hn, from_part, to_part, he);
       }
-      _unremovable_he_parts.set(he * _config.partition.k + to_part, 1);
+      markAsUnremovable(he, to_part);
 
       ASSERT([&]() {
           // Search parts of hyperedge he which are unremoveable
@@ -675,10 +690,10 @@ class KWayKMinusOneRefiner final : public IRefiner,
               ur_parts[_hg.partID(pin)] = true;
             }
           }
-          // _unremovable_he_parts should have the same bits set as ur_parts
+          // _unremovable_he_parts should contain the same parts as ur_parts
           for (PartitionID k = 0; k < _config.partition.k; k++) {
-            ASSERT(ur_parts[k] == _unremovable_he_parts[he * _config.partition.k + k],
-                   V(ur_parts[k]) << V(_unremovable_he_parts[he * _config.partition.k + k]));
+            ASSERT(ur_parts[k] == isUnremovable(he, k),
+                   V(ur_parts[k]) << V(isUnremovable(he, k)));
           }
           return true;
         } (), "Error in locking of he/parts!");
@@ -761,7 +776,7 @@ class KWayKMinusOneRefiner final : public IRefiner,
                     for (const HyperedgeID incident_edge : _hg.incidentEdges(pin)) {
                       for (PartitionID i = 0; i < _config.partition.k; ++i) {
                         LOG("Part " << i << " unremovable: "
-                            << _unremovable_he_parts[he * _config.partition.k + i]);
+                            << isUnremovable(he, i));
                       }
                       _hg.printEdgeState(incident_edge);
                     }
@@ -864,7 +879,7 @@ class KWayKMinusOneRefiner final : public IRefiner,
     // have to invalidate and recalculate the gains.
     if (invalidate_hn) {
       _gain_cache.clear(hn);
-      initializeGainCacheFor(hn);
+      initializeGainCacheFor(hn, _tmp_gains);
     }
     if (_hg.isBorderNode(hn)) {
       ASSERT(!_hg.active(hn), V(hn));
@@ -896,24 +911,26 @@ class KWayKMinusOneRefiner final : public IRefiner,
   }
 
   void initializeGainCache() {
-    for (const HypernodeID hn : _hg.nodes()) {
-      initializeGainCacheFor(hn);
-    }
+    initializeGainCacheInParallel(_hg, _thread_tmp_gains.size() + 1,
+                                  [&](const HypernodeID hn, const size_t thread) {
+          initializeGainCacheFor(hn, thread == 0 ? _tmp_gains : *_thread_tmp_gains[thread - 1]);
+        });
   }
 
-  void initializeGainCacheFor(const HypernodeID hn) {
-    _tmp_gains.clear();
+  void initializeGainCacheFor(const HypernodeID hn,
+                              ds::SparseMap<PartitionID, Gain>& tmp_gains) {
+    tmp_gains.clear();
     const PartitionID source_part = _hg.partID(hn);
     HyperedgeWeight internal = 0;
     for (const HyperedgeID he : _hg.incidentEdges(hn)) {
       const HyperedgeWeight he_weight = _hg.edgeWeight(he);
       internal += _hg.pinCountInPart(he, source_part) != 1 ? he_weight : 0;
       for (const PartitionID part : _hg.connectivitySet(he)) {
-        _tmp_gains[part] += he_weight;
+        tmp_gains[part] += he_weight;
       }
     }
 
-    for (const auto& target_part : _tmp_gains) {
+    for (const auto& target_part : tmp_gains) {
       if (target_part.key == source_part) {
         ASSERT(!_gain_cache.entryExists(hn, source_part), V(hn) << V(source_part));
         continue;
@@ -992,6 +1009,8 @@ class KWayKMinusOneRefiner final : public IRefiner,
   using Base::_hns_to_activate;
 
   ds::SparseMap<PartitionID, Gain> _tmp_gains;
+  // Scratch maps of the additional threads that initialize the gain cache.
+  std::vector<std::unique_ptr<ds::SparseMap<PartitionID, Gain> > > _thread_tmp_gains;
 
   // After a move, we have to update the gains for all adjacent HNs.
   // For all moves of a HN that were already present in the PQ before the
@@ -1006,9 +1025,10 @@ class KWayKMinusOneRefiner final : public IRefiner,
 
   // 'Locking' of hyperedges for K-1 metric. When optimizing this metric,
   // each part of a hyperedge becomes unremovable, as soon as one of its
-  // pins is moved to that part. For each HE e, this bitvector stores whether
-  // or not a part in the connectivity set of e is unremovable.
-  ds::FastResetFlagArray<> _unremovable_he_parts;
+  // pins is moved to that part. This set stores the unremovable (HE, part) pairs
+  // as keys he * k + part. Since only the HEs incident to moved HNs are locked,
+  // its size is proportional to the work done in the current refinement call.
+  ds::FastResetHashSet<> _unremovable_he_parts;
 
   GainCache _gain_cache;
   StoppingPolicy _stopping_policy;
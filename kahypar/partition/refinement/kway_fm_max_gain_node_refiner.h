@@ -46,9 +46,10 @@ namespace kahypar {
 template <class StoppingPolicy = Mandatory,
           // does nothing for KFM
           bool global_rebalancing = false,
+          class GainQueue = HeapGainQueue,
           class FMImprovementPolicy = CutDecreasedOrInfeasibleImbalanceDecreased>
 class MaxGainNodeKWayFMRefiner final : public IRefiner,
-                                       private FMRefinerBase<RollbackInfo>{
+                                       private FMRefinerBase<RollbackInfo, GainQueue>{
   static const bool dbg_refinement_kway_fm_activation = false;
   static const bool dbg_refinement_kway_fm_improvements_cut = true;
   static const bool dbg_refinement_kway_fm_improvements_balance = false;
@@ -57,7 +58,16 @@ class MaxGainNodeKWayFMRefiner final : public IRefiner,
   static const bool dbg_refinement_kway_fm_gain_comp = false;
 
   using GainPartitionPair = std::pair<Gain, PartitionID>;
-  using Base = FMRefinerBase<RollbackInfo>;
+  using Base = FMRefinerBase<RollbackInfo, GainQueue>;
+  using Base::kInvalidHN;
+  using Base::kInvalidGain;
+  using Base::kInvalidDecrease;
+  using Base::moveIsFeasible;
+  using Base::moveHypernode;
+  using Base::hypernodeIsConnectedToPart;
+  using Base::heaviestPart;
+  using Base::reCalculateHeaviestPartAndItsWeight;
+  using Base::reset;
 
   struct GainConnectivity {
     Gain gain;
@@ -66,11 +76,10 @@ class MaxGainNodeKWayFMRefiner final : public IRefiner,
 
  public:
   MaxGainNodeKWayFMRefiner(Hypergraph& hypergraph, const Configuration& config) :
-    FMRefinerBase(hypergraph, config),
+    Base(hypergraph, config),
     _tmp_gains(_config.partition.k, { kInvalidGain, 0 }),
     _target_parts(_hg.initialNumNodes(), Hypergraph::kInvalidPartition),
     _tmp_max_gain_target_parts(),
-    _pq(_config.partition.k),
     _just_updated(_hg.initialNumNodes()),
     _seen_as_max_part(_config.partition.k),
     _stopping_policy() {
@@ -103,12 +112,7 @@ class MaxGainNodeKWayFMRefiner final : public IRefiner,
 
   void initializeImpl(const HyperedgeWeight max_gain) override final {
     if (!_is_initialized) {
-#ifdef USE_BUCKET_QUEUE
-      _pq.initialize(_hg.initialNumNodes(), max_gain);
-#else
-      (void)max_gain;
-      _pq.initialize(_hg.initialNumNodes());
-#endif
+      Base::initializePQ(max_gain);
       _is_initialized = true;
     }
   }
@@ -145,7 +149,8 @@ class MaxGainNodeKWayFMRefiner final : public IRefiner,
 
     const double beta = log(_hg.currentNumNodes());
     while (!_pq.empty() && !_stopping_policy.searchShouldStop(num_moves_since_last_improvement,
-                                                              _config, beta, best_metrics.cut, current_cut)) {
+                                                              _config, beta, best_metrics.cut, current_cut) &&
+           !moveBudgetExhausted(num_moves)) {
       Gain max_gain = kInvalidGain;
       HypernodeID max_gain_node = kInvalidHN;
       PartitionID to_part = Hypergraph::kInvalidPartition;
@@ -238,6 +243,7 @@ class MaxGainNodeKWayFMRefiner final : public IRefiner,
                                               best_metrics.cut, current_cut)
             == true ? "policy " : "empty queue ") << V(num_moves_since_last_improvement));
 
+    _num_performed_moves = num_moves;
     rollback(num_moves - 1, min_cut_index);
     ASSERT(best_metrics.cut == metrics::hyperedgeCut(_hg), V(best_metrics.cut) << V(metrics::hyperedgeCut(_hg)));
     ASSERT(best_metrics.cut <= initial_cut, V(best_metrics.cut) << V(initial_cut));
@@ -247,13 +253,7 @@ class MaxGainNodeKWayFMRefiner final : public IRefiner,
 
   std::string policyStringImpl() const override final {
     return std::string(" RefinerStoppingPolicy=" + meta::templateToString<StoppingPolicy>() +
-                       " RefinerUsesBucketQueue=" +
-#ifdef USE_BUCKET_PQ
-                       "true"
-#else
-                       "false"
-#endif
-                       );
+                       " RefinerGainQueue=" + meta::templateToString<GainQueue>());
   }
 
   void rollback(int last_index, const int min_cut_index) {
@@ -592,12 +592,12 @@ class MaxGainNodeKWayFMRefiner final : public IRefiner,
 
   using Base::_hg;
   using Base::_config;
+  using Base::_pq;
   using Base::_performed_moves;
 
   std::vector<GainConnectivity> _tmp_gains;
   std::vector<PartitionID> _target_parts;
   std::vector<PartitionID> _tmp_max_gain_target_parts;
-  KWayRefinementPQ _pq;
   ds::FastResetFlagArray<> _just_updated;
   ds::FastResetFlagArray<> _seen_as_max_part;
   StoppingPolicy _stopping_policy;
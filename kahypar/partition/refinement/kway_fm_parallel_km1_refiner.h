@@ -0,0 +1,556 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "kahypar/datastructure/binary_heap.h"
+#include "kahypar/datastructure/fast_reset_array.h"
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/definitions.h"
+#include "kahypar/meta/mandatory.h"
+#include "kahypar/meta/template_parameter_to_string.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/partition/refinement/policies/fm_improvement_policy.h"
+#include "kahypar/utils/float_compare.h"
+#include "kahypar/utils/randomize.h"
+
+namespace kahypar {
+/*!
+ * Parallel k-way FM refinement optimizing the (k-1)-metric.
+ *
+ * The border nodes among the refinement nodes are distributed among several threads,
+ * each of which starts a localized FM search from its seed nodes. During the search,
+ * the shared hypergraph is only read: moves, pin count deltas and part weight deltas
+ * are kept thread-local and gains are computed w.r.t. the local view of the partition.
+ * Each hypernode can be moved by at most one search per round. Afterwards, the best
+ * prefixes of the move sequences are committed to the hypergraph one after another.
+ * Because the moves of other searches may have changed the gains in the meantime,
+ * the gains of all committed moves are recomputed on the hypergraph, moves that
+ * became infeasible are skipped and each sequence is rolled back to its best prefix
+ * w.r.t. the recomputed gains.
+ *
+ * The worker threads are started once and reused by all calls to refine(). A move
+ * budget set via setMoveBudget() is split evenly among the searches of a call.
+ * Since only batches with at least kMinSeedsPerSearch border nodes per thread are
+ * refined in parallel, the application raises --r-uncontraction-batch-size
+ * accordingly if this refiner is used with several threads.
+ */
+template <class StoppingPolicy = Mandatory,
+          class FMImprovementPolicy = CutDecreasedOrInfeasibleImbalanceDecreased>
+class KWayParallelKMinusOneRefiner final : public IRefiner {
+  static const bool dbg_refinement_parallel_kminusone_fm_commit = false;
+
+ public:
+  // Batches of refinement nodes with fewer border nodes per thread are refined by a
+  // single search in the calling thread.
+  static constexpr size_t kMinSeedsPerSearch = 16;
+
+ private:
+
+  struct Move {
+    HypernodeID hn;
+    PartitionID from;
+    PartitionID to;
+  };
+
+  class LocalizedSearch {
+    using PQ = ds::BinaryMaxHeap<HypernodeID, Gain>;
+
+ public:
+    LocalizedSearch(const Hypergraph& hypergraph, const Configuration& config) :
+      _hg(hypergraph),
+      _config(config),
+      _pq(hypergraph.initialNumNodes()),
+      _locked(hypergraph.initialNumNodes()),
+      _local_part(hypergraph.initialNumNodes(), Hypergraph::kInvalidPartition),
+      _part_weight_delta(config.partition.k, 0),
+      _connected_weight(config.partition.k, 0),
+      _connected_parts(),
+      _pin_count_delta(),
+      _added_parts(),
+      _moves(),
+      _num_performed_moves(0),
+      _stopping_policy() {
+      _connected_parts.reserve(config.partition.k);
+    }
+
+    LocalizedSearch(const LocalizedSearch&) = delete;
+    LocalizedSearch& operator= (const LocalizedSearch&) = delete;
+
+    LocalizedSearch(LocalizedSearch&&) = delete;
+    LocalizedSearch& operator= (LocalizedSearch&&) = delete;
+
+    // Performs a localized FM search of at most max_moves moves starting at the
+    // seeds and returns the prefix of moves with the best expected gain.
+    const std::vector<Move>& search(const std::vector<HypernodeID>& seeds,
+                                    std::vector<std::atomic<uint32_t> >& owner,
+                                    const uint32_t round,
+                                    const HyperedgeWeight initial_km1,
+                                    const size_t max_moves) {
+      reset();
+      for (const HypernodeID& hn : seeds) {
+        const std::pair<PartitionID, Gain> best_move = bestMove(hn);
+        if (best_move.first != Hypergraph::kInvalidPartition) {
+          _pq.push(hn, best_move.second);
+        }
+      }
+
+      const double beta = std::log(_hg.currentNumNodes());
+      Gain current_gain = 0;
+      Gain best_gain = 0;
+      size_t best_prefix = 0;
+      int num_moves_since_last_improvement = 0;
+      _stopping_policy.resetStatistics();
+
+      while (!_pq.empty() &&
+             !_stopping_policy.searchShouldStop(num_moves_since_last_improvement, _config, beta,
+                                                initial_km1 - best_gain,
+                                                initial_km1 - current_gain) &&
+             _moves.size() < max_moves) {
+        const HypernodeID hn = _pq.top();
+        const std::pair<PartitionID, Gain> best_move = bestMove(hn);
+        if (best_move.first == Hypergraph::kInvalidPartition) {
+          _pq.pop();
+          continue;
+        }
+        if (best_move.second < _pq.topKey()) {
+          // Gains of queued nodes can decrease because of changed part weights.
+          _pq.updateKey(hn, best_move.second);
+          continue;
+        }
+        _pq.pop();
+        _locked.set(hn, true);
+        if (!claim(hn, owner, round)) {
+          continue;
+        }
+
+        const PartitionID from = partID(hn);
+        move(hn, from, best_move.first);
+        _moves.push_back({ hn, from, best_move.first });
+        current_gain += best_move.second;
+        _stopping_policy.updateStatistics(best_move.second);
+        ++num_moves_since_last_improvement;
+        if (current_gain > best_gain) {
+          best_gain = current_gain;
+          best_prefix = _moves.size();
+          num_moves_since_last_improvement = 0;
+          _stopping_policy.resetStatistics();
+        }
+        updateNeighbours(hn);
+      }
+      _num_performed_moves = _moves.size();
+      _moves.resize(best_prefix);
+      return _moves;
+    }
+
+    const std::vector<Move>& moves() const {
+      return _moves;
+    }
+
+    // Number of moves of the last search, including the moves after the best prefix.
+    size_t numPerformedMoves() const {
+      return _num_performed_moves;
+    }
+
+ private:
+    void reset() {
+      _pq.clear();
+      _locked.reset();
+      _local_part.resetUsedEntries();
+      std::fill(_part_weight_delta.begin(), _part_weight_delta.end(), 0);
+      _pin_count_delta.clear();
+      _added_parts.clear();
+      _moves.clear();
+    }
+
+    static bool claim(const HypernodeID hn, std::vector<std::atomic<uint32_t> >& owner,
+                      const uint32_t round) {
+      uint32_t last_round = owner[hn].load(std::memory_order_relaxed);
+      return last_round != round &&
+             owner[hn].compare_exchange_strong(last_round, round, std::memory_order_relaxed);
+    }
+
+    PartitionID partID(const HypernodeID hn) const {
+      const PartitionID local_part = _local_part.get(hn);
+      return local_part != Hypergraph::kInvalidPartition ? local_part : _hg.partID(hn);
+    }
+
+    HypernodeWeight partWeight(const PartitionID part) const {
+      return _hg.partWeight(part) + _part_weight_delta[part];
+    }
+
+    size_t key(const HyperedgeID he, const PartitionID part) const {
+      return static_cast<size_t>(he) * _config.partition.k + part;
+    }
+
+    HypernodeID pinCountInPart(const HyperedgeID he, const PartitionID part) const {
+      const auto delta = _pin_count_delta.find(key(he, part));
+      return delta == _pin_count_delta.end() ? _hg.pinCountInPart(he, part) :
+             _hg.pinCountInPart(he, part) + delta->second;
+    }
+
+    void addConnectedPart(const PartitionID part, const HyperedgeWeight weight) {
+      if (_connected_weight[part] == 0) {
+        _connected_parts.push_back(part);
+      }
+      _connected_weight[part] += weight;
+    }
+
+    // Best feasible move of hn w.r.t. the local view of the partition. Returns
+    // kInvalidPartition if hn is not a border node or cannot be moved.
+    std::pair<PartitionID, Gain> bestMove(const HypernodeID hn) {
+      const PartitionID from = partID(hn);
+      Gain removal_gain = 0;
+      HyperedgeWeight incident_weight = 0;
+      for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+        const HyperedgeWeight weight = _hg.edgeWeight(he);
+        incident_weight += weight;
+        if (pinCountInPart(he, from) == 1) {
+          removal_gain += weight;
+        }
+        for (const PartitionID& part : _hg.connectivitySet(he)) {
+          if (part != from && pinCountInPart(he, part) > 0) {
+            addConnectedPart(part, weight);
+          }
+        }
+        const auto added_parts = _added_parts.find(he);
+        if (added_parts != _added_parts.end()) {
+          for (const PartitionID& part : added_parts->second) {
+            if (part != from && pinCountInPart(he, part) > 0) {
+              addConnectedPart(part, weight);
+            }
+          }
+        }
+      }
+
+      std::pair<PartitionID, Gain> best_move(Hypergraph::kInvalidPartition,
+                                             std::numeric_limits<Gain>::min());
+      const HypernodeWeight weight = _hg.nodeWeight(hn);
+      for (const PartitionID& part : _connected_parts) {
+        const Gain gain = removal_gain - (incident_weight - _connected_weight[part]);
+        if (gain > best_move.second &&
+            partWeight(part) + weight <= _config.partition.max_part_weights[0]) {
+          best_move = std::make_pair(part, gain);
+        }
+        _connected_weight[part] = 0;
+      }
+      _connected_parts.clear();
+      return best_move;
+    }
+
+    void move(const HypernodeID hn, const PartitionID from, const PartitionID to) {
+      _local_part.set(hn, to);
+      _part_weight_delta[from] -= _hg.nodeWeight(hn);
+      _part_weight_delta[to] += _hg.nodeWeight(hn);
+      for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+        --_pin_count_delta[key(he, from)];
+        const int delta = ++_pin_count_delta[key(he, to)];
+        if (delta == 1 && _hg.pinCountInPart(he, to) == 0) {
+          std::vector<PartitionID>& added_parts = _added_parts[he];
+          if (std::find(added_parts.begin(), added_parts.end(), to) == added_parts.end()) {
+            added_parts.push_back(to);
+          }
+        }
+      }
+    }
+
+    void updateNeighbours(const HypernodeID hn) {
+      for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+        if (_hg.edgeSize(he) > _config.partition.hyperedge_size_threshold) {
+          continue;
+        }
+        for (const HypernodeID& pin : _hg.pins(he)) {
+          if (_locked[pin]) {
+            continue;
+          }
+          const std::pair<PartitionID, Gain> best_move = bestMove(pin);
+          if (_pq.contains(pin)) {
+            if (best_move.first == Hypergraph::kInvalidPartition) {
+              _pq.remove(pin);
+            } else {
+              _pq.updateKey(pin, best_move.second);
+            }
+          } else if (best_move.first != Hypergraph::kInvalidPartition) {
+            _pq.push(pin, best_move.second);
+          }
+        }
+      }
+    }
+
+    const Hypergraph& _hg;
+    const Configuration& _config;
+    PQ _pq;
+    ds::FastResetFlagArray<> _locked;
+    ds::FastResetArray<PartitionID> _local_part;
+    std::vector<HypernodeWeight> _part_weight_delta;
+    std::vector<HyperedgeWeight> _connected_weight;
+    std::vector<PartitionID> _connected_parts;
+    std::unordered_map<size_t, int> _pin_count_delta;
+    // Parts that are contained in a hyperedge only because of local moves.
+    std::unordered_map<HyperedgeID, std::vector<PartitionID> > _added_parts;
+    std::vector<Move> _moves;
+    size_t _num_performed_moves;
+    StoppingPolicy _stopping_policy;
+  };
+
+ public:
+  KWayParallelKMinusOneRefiner(Hypergraph& hypergraph, const Configuration& config) :
+    _hg(hypergraph),
+    _config(config),
+    _searches(),
+    _seeds(),
+    _committed_moves(),
+    _owner(hypergraph.initialNumNodes()),
+    _round(0),
+    _workers(),
+    _mutex(),
+    _start_searches(),
+    _searches_done(),
+    _generation(0),
+    _num_active_searches(0),
+    _num_pending_workers(0),
+    _max_moves_per_search(0),
+    _initial_km1(0),
+    _terminate(false) {
+    const size_t num_searches = std::max(1u, config.local_search.num_threads);
+    for (size_t i = 0; i < num_searches; ++i) {
+      _searches.emplace_back(new LocalizedSearch(hypergraph, config));
+    }
+    _seeds.resize(num_searches);
+    // The calling thread performs the first search itself.
+    for (size_t i = 1; i < num_searches; ++i) {
+      _workers.emplace_back(&KWayParallelKMinusOneRefiner::work, this, i);
+    }
+  }
+
+  ~KWayParallelKMinusOneRefiner() override {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _terminate = true;
+    }
+    _start_searches.notify_all();
+    for (std::thread& worker : _workers) {
+      worker.join();
+    }
+  }
+
+  KWayParallelKMinusOneRefiner(const KWayParallelKMinusOneRefiner&) = delete;
+  KWayParallelKMinusOneRefiner& operator= (const KWayParallelKMinusOneRefiner&) = delete;
+
+  KWayParallelKMinusOneRefiner(KWayParallelKMinusOneRefiner&&) = delete;
+  KWayParallelKMinusOneRefiner& operator= (KWayParallelKMinusOneRefiner&&) = delete;
+
+ private:
+  void initializeImpl(const HyperedgeWeight) override final {
+    _is_initialized = true;
+  }
+
+  bool refineImpl(std::vector<HypernodeID>& refinement_nodes,
+                  const std::array<HypernodeWeight, 2>&,
+                  const UncontractionGainChanges&,
+                  Metrics& best_metrics) override final {
+    ASSERT(best_metrics.km1 == metrics::km1(_hg),
+           V(best_metrics.km1) << V(metrics::km1(_hg)));
+    ASSERT(FloatingPoint<double>(best_metrics.imbalance).AlmostEquals(
+             FloatingPoint<double>(metrics::imbalance(_hg, _config))),
+           V(best_metrics.imbalance) << V(metrics::imbalance(_hg, _config)));
+
+    const HyperedgeWeight initial_km1 = best_metrics.km1;
+    const double initial_imbalance = best_metrics.imbalance;
+
+    std::vector<HypernodeID> border_nodes;
+    for (const HypernodeID& hn : refinement_nodes) {
+      if (_hg.isBorderNode(hn)) {
+        border_nodes.push_back(hn);
+      }
+    }
+    Randomize::instance().shuffleVector(border_nodes, border_nodes.size());
+
+    const size_t num_searches = std::max(static_cast<size_t>(1),
+                                         std::min(_searches.size(),
+                                                  border_nodes.size() / kMinSeedsPerSearch));
+    for (size_t i = 0; i < num_searches; ++i) {
+      _seeds[i].clear();
+    }
+    for (size_t i = 0; i < border_nodes.size(); ++i) {
+      _seeds[i % num_searches].push_back(border_nodes[i]);
+    }
+
+    nextRound();
+    runSearches(num_searches, initial_km1,
+                std::max(static_cast<size_t>(1),
+                         static_cast<size_t>(_move_budget) / num_searches));
+
+    _num_performed_moves = 0;
+    for (size_t i = 0; i < num_searches; ++i) {
+      best_metrics.km1 -= commit(_searches[i]->moves());
+      _num_performed_moves += _searches[i]->numPerformedMoves();
+    }
+    best_metrics.imbalance = metrics::imbalance(_hg, _config);
+
+    ASSERT(best_metrics.km1 == metrics::km1(_hg),
+           V(best_metrics.km1) << V(metrics::km1(_hg)));
+    return FMImprovementPolicy::improvementFound(best_metrics.km1, initial_km1,
+                                                 best_metrics.imbalance, initial_imbalance,
+                                                 _config.partition.epsilon);
+  }
+
+  // Runs the first num_searches searches concurrently. The first search is
+  // performed by the calling thread, the others by the worker threads.
+  void runSearches(const size_t num_searches, const HyperedgeWeight initial_km1,
+                   const size_t max_moves_per_search) {
+    if (num_searches == 1) {
+      _searches[0]->search(_seeds[0], _owner, _round, initial_km1, max_moves_per_search);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _num_active_searches = num_searches;
+      _num_pending_workers = _workers.size();
+      _max_moves_per_search = max_moves_per_search;
+      _initial_km1 = initial_km1;
+      ++_generation;
+    }
+    _start_searches.notify_all();
+    _searches[0]->search(_seeds[0], _owner, _round, initial_km1, max_moves_per_search);
+    std::unique_lock<std::mutex> lock(_mutex);
+    _searches_done.wait(lock, [&]() {
+        return _num_pending_workers == 0;
+      });
+  }
+
+  void work(const size_t search) {
+    size_t generation = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+      _start_searches.wait(lock, [&]() {
+          return _terminate || _generation != generation;
+        });
+      if (_terminate) {
+        return;
+      }
+      generation = _generation;
+      if (search < _num_active_searches) {
+        const size_t max_moves = _max_moves_per_search;
+        const HyperedgeWeight initial_km1 = _initial_km1;
+        lock.unlock();
+        _searches[search]->search(_seeds[search], _owner, _round, initial_km1, max_moves);
+        lock.lock();
+      }
+      if (--_num_pending_workers == 0) {
+        _searches_done.notify_one();
+      }
+    }
+  }
+
+  // Applies the moves to the hypergraph and rolls back to the best prefix
+  // w.r.t. the actual gains. Returns the gain of the committed prefix.
+  Gain commit(const std::vector<Move>& moves) {
+    Gain current_gain = 0;
+    Gain best_gain = 0;
+    size_t best_prefix = 0;
+    _committed_moves.clear();
+    for (const Move& move : moves) {
+      ASSERT(_hg.partID(move.hn) == move.from, V(move.hn));
+      if (_hg.partWeight(move.to) + _hg.nodeWeight(move.hn) >
+          _config.partition.max_part_weights[0]) {
+        continue;
+      }
+      current_gain += km1Gain(move.hn, move.from, move.to);
+      _hg.changeNodePart(move.hn, move.from, move.to);
+      _committed_moves.push_back(move);
+      if (current_gain > best_gain) {
+        best_gain = current_gain;
+        best_prefix = _committed_moves.size();
+      }
+    }
+    for (size_t i = _committed_moves.size(); i > best_prefix; --i) {
+      const Move& move = _committed_moves[i - 1];
+      _hg.changeNodePart(move.hn, move.to, move.from);
+    }
+    DBG(dbg_refinement_parallel_kminusone_fm_commit,
+        "committed" << V(best_prefix) << "of" << V(moves.size()) << V(best_gain));
+    return best_gain;
+  }
+
+  Gain km1Gain(const HypernodeID hn, const PartitionID from, const PartitionID to) const {
+    Gain gain = 0;
+    for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+      if (_hg.pinCountInPart(he, from) == 1) {
+        gain += _hg.edgeWeight(he);
+      }
+      if (_hg.pinCountInPart(he, to) == 0) {
+        gain -= _hg.edgeWeight(he);
+      }
+    }
+    return gain;
+  }
+
+  void nextRound() {
+    if (++_round == 0) {
+      for (std::atomic<uint32_t>& owner : _owner) {
+        owner.store(0, std::memory_order_relaxed);
+      }
+      _round = 1;
+    }
+  }
+
+  std::string policyStringImpl() const override final {
+    return std::string(" RefinerStoppingPolicy=" + meta::templateToString<StoppingPolicy>() +
+                       " RefinerNumThreads=" + std::to_string(_searches.size()));
+  }
+
+  Hypergraph& _hg;
+  const Configuration& _config;
+  std::vector<std::unique_ptr<LocalizedSearch> > _searches;
+  std::vector<std::vector<HypernodeID> > _seeds;
+  std::vector<Move> _committed_moves;
+  // Round in which a hypernode was last claimed by one of the searches.
+  std::vector<std::atomic<uint32_t> > _owner;
+  uint32_t _round;
+  std::vector<std::thread> _workers;
+  std::mutex _mutex;
+  std::condition_variable _start_searches;
+  std::condition_variable _searches_done;
+  // Incremented for each call to runSearches() that uses the worker threads.
+  size_t _generation;
+  size_t _num_active_searches;
+  size_t _num_pending_workers;
+  size_t _max_moves_per_search;
+  HyperedgeWeight _initial_km1;
+  bool _terminate;
+};
+}  // namespace kahypar
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/meta/mandatory.h"
+#include "kahypar/partition/refinement/gain_cache_element.h"
+
+namespace kahypar {
+/*!
+ * Gain cache for k-way FM with the same interface and semantics as KwayGainCache,
+ * whose memory consumption is proportional to the number of blocks adjacent to
+ * each hypernode instead of k.
+ *
+ * The entries of all hypernodes are stored in a pooled arena. Each hypernode
+ * initially owns a slot of kInitialCapacity entries. If the slot is full, the
+ * entries are moved to a slot of twice the size at the end of the arena. The
+ * arena is compacted whenever the whole cache is cleared.
+ * The active entries of a hypernode (i.e., its adjacent parts) are stored at the
+ * front of its slot in the same order as in KwayGainCache. They are followed by
+ * entries that temporarily store a gain without being active during rollback.
+ */
+template <typename Gain = Mandatory>
+class KwaySparseGainCache {
+ private:
+  static constexpr PartitionID kInitialCapacity = 4;
+  static constexpr PartitionID kNotFound = -1;
+
+  using KFMCacheElement = CacheElement<Gain>;
+
+  struct Slot {
+    size_t offset;
+    PartitionID capacity;
+    // number of active entries
+    PartitionID size;
+    // number of active and inactive entries
+    PartitionID num_entries;
+  };
+
+ public:
+  static constexpr HyperedgeWeight kNotCached = KFMCacheElement::kNotCached;
+  static constexpr PartitionID kInvalidPart = KFMCacheElement::kInvalidPart;
+
+  class AdjacentParts {
+ public:
+    AdjacentParts(const PartitionID* begin, const PartitionID* end) :
+      _begin(begin),
+      _end(end) { }
+
+    const PartitionID* begin() const {
+      return _begin;
+    }
+
+    const PartitionID* end() const {
+      return _end;
+    }
+
+ private:
+    const PartitionID* _begin;
+    const PartitionID* _end;
+  };
+
+  KwaySparseGainCache(const HypernodeID num_hns, const PartitionID k) :
+    _k(k),
+    _num_hns(num_hns),
+    _initial_capacity(k < kInitialCapacity ? k : kInitialCapacity),
+    _slots(num_hns),
+    _parts(),
+    _gains(),
+    _deltas() {
+    clear();
+  }
+
+  KwaySparseGainCache(const KwaySparseGainCache&) = delete;
+  KwaySparseGainCache& operator= (const KwaySparseGainCache&) = delete;
+
+  KwaySparseGainCache(KwaySparseGainCache&&) = default;
+  KwaySparseGainCache& operator= (KwaySparseGainCache&&) = default;
+
+  Gain entry(const HypernodeID hn, const PartitionID part) const {
+    ASSERT(part < _k, V(part));
+    const PartitionID index = find(hn, part, _slots[hn].num_entries);
+    return index != kNotFound ? _gains[_slots[hn].offset + index] : kNotCached;
+  }
+
+  bool entryExists(const HypernodeID hn, const PartitionID part) const {
+    ASSERT(part < _k, V(part));
+    return find(hn, part, _slots[hn].size) != kNotFound;
+  }
+
+  void removeEntryDueToConnectivityDecrease(const HypernodeID hn, const PartitionID part) {
+    ASSERT(part < _k, V(part));
+    _deltas.emplace_back(hn, part, entry(hn, part), RollbackAction::do_add);
+    remove(hn, part);
+  }
+
+  void addEntryDueToConnectivityIncrease(const HypernodeID hn, const PartitionID part,
+                                         const Gain gain) {
+    ASSERT(part < _k, V(part));
+    ASSERT(!entryExists(hn, part), V(hn) << V(part));
+    add(hn, part, gain);
+    _deltas.emplace_back(hn, part, kNotCached - gain, RollbackAction::do_remove);
+  }
+
+  void updateFromAndToPartOfMovedHN(const HypernodeID moved_hn, const PartitionID from_part,
+                                    const PartitionID to_part,
+                                    const bool remains_connected_to_from_part) {
+    if (remains_connected_to_from_part) {
+      const Gain to_part_gain = entry(moved_hn, to_part);
+      _deltas.emplace_back(moved_hn, from_part,
+                           entry(moved_hn, from_part) + to_part_gain,
+                           RollbackAction::do_remove);
+      add(moved_hn, from_part, -to_part_gain);
+    } else {
+      ASSERT(entry(moved_hn, from_part) == kNotCached, V(moved_hn) << V(from_part));
+    }
+    removeEntryDueToConnectivityDecrease(moved_hn, to_part);
+  }
+
+  void clear(const HypernodeID hn) {
+    _slots[hn].size = 0;
+    _slots[hn].num_entries = 0;
+  }
+
+  void initializeEntry(const HypernodeID hn, const PartitionID part, const Gain value) {
+    ASSERT(part < _k, V(part));
+    add(hn, part, value);
+  }
+
+  void updateEntryIfItExists(const HypernodeID hn, const PartitionID part, const Gain delta) {
+    ASSERT(part < _k, V(part));
+    if (entryExists(hn, part)) {
+      updateExistingEntry(hn, part, delta);
+    }
+  }
+
+  void updateExistingEntry(const HypernodeID hn, const PartitionID part, const Gain delta) {
+    ASSERT(part < _k, V(part));
+    ASSERT(entryExists(hn, part), V(hn) << V(part));
+    ASSERT(entry(hn, part) != kNotCached, V(hn) << V(part));
+    update(hn, part, delta);
+    _deltas.emplace_back(hn, part, -delta, RollbackAction::do_nothing);
+  }
+
+  void rollbackDelta() {
+    for (auto rit = _deltas.crbegin(); rit != _deltas.crend(); ++rit) {
+      const HypernodeID hn = rit->hn;
+      const PartitionID part = rit->part;
+      const Gain delta = rit->delta;
+      if (entryExists(hn, part)) {
+        update(hn, part, delta);
+        if (rit->action == RollbackAction::do_remove) {
+          ASSERT(entry(hn, part) == kNotCached, V(hn));
+          remove(hn, part);
+        }
+      } else {
+        set(hn, part, delta);
+        if (rit->action == RollbackAction::do_add) {
+          addToActiveParts(hn, part);
+        }
+      }
+    }
+    _deltas.clear();
+  }
+
+  void resetDelta() {
+    _deltas.clear();
+  }
+
+  // The returned range is invalidated if entries are added to any hypernode.
+  AdjacentParts adjacentParts(const HypernodeID hn) const {
+    const PartitionID* begin = _parts.data() + _slots[hn].offset;
+    return AdjacentParts(begin, begin + _slots[hn].size);
+  }
+
+  void clear() {
+    _parts.resize(static_cast<size_t>(_num_hns) * _initial_capacity);
+    _gains.resize(_parts.size());
+    for (HypernodeID hn = 0; hn < _num_hns; ++hn) {
+      _slots[hn] = { static_cast<size_t>(hn) * _initial_capacity, _initial_capacity, 0, 0 };
+    }
+  }
+
+ private:
+  PartitionID find(const HypernodeID hn, const PartitionID part, const PartitionID end) const {
+    const PartitionID* parts = _parts.data() + _slots[hn].offset;
+    for (PartitionID i = 0; i < end; ++i) {
+      if (parts[i] == part) {
+        return i;
+      }
+    }
+    return kNotFound;
+  }
+
+  void move(const HypernodeID hn, const PartitionID from, const PartitionID to) {
+    _parts[_slots[hn].offset + to] = _parts[_slots[hn].offset + from];
+    _gains[_slots[hn].offset + to] = _gains[_slots[hn].offset + from];
+  }
+
+  void swap(const HypernodeID hn, const PartitionID i, const PartitionID j) {
+    std::swap(_parts[_slots[hn].offset + i], _parts[_slots[hn].offset + j]);
+    std::swap(_gains[_slots[hn].offset + i], _gains[_slots[hn].offset + j]);
+  }
+
+  // Appends a new inactive entry.
+  PartitionID append(const HypernodeID hn, const PartitionID part, const Gain gain) {
+    Slot& slot = _slots[hn];
+    if (slot.num_entries == slot.capacity) {
+      ASSERT(slot.capacity < _k, V(hn));
+      const PartitionID capacity = std::min(_k, 2 * slot.capacity);
+      const size_t offset = _parts.size();
+      _parts.resize(offset + capacity);
+      _gains.resize(offset + capacity);
+      std::copy(_parts.begin() + slot.offset, _parts.begin() + slot.offset + slot.num_entries,
+                _parts.begin() + offset);
+      std::copy(_gains.begin() + slot.offset, _gains.begin() + slot.offset + slot.num_entries,
+                _gains.begin() + offset);
+      slot.offset = offset;
+      slot.capacity = capacity;
+    }
+    _parts[slot.offset + slot.num_entries] = part;
+    _gains[slot.offset + slot.num_entries] = gain;
+    return slot.num_entries++;
+  }
+
+  void add(const HypernodeID hn, const PartitionID part, const Gain gain) {
+    ASSERT(!entryExists(hn, part), V(hn) << V(part));
+    PartitionID index = find(hn, part, _slots[hn].num_entries);
+    if (index == kNotFound) {
+      index = append(hn, part, gain);
+    } else {
+      _gains[_slots[hn].offset + index] = gain;
+    }
+    swap(hn, index, _slots[hn].size++);
+  }
+
+  void addToActiveParts(const HypernodeID hn, const PartitionID part) {
+    ASSERT(!entryExists(hn, part), V(hn) << V(part));
+    const PartitionID index = find(hn, part, _slots[hn].num_entries);
+    ASSERT(index != kNotFound, V(hn) << V(part));
+    swap(hn, index, _slots[hn].size++);
+  }
+
+  void remove(const HypernodeID hn, const PartitionID part) {
+    Slot& slot = _slots[hn];
+    const PartitionID index = find(hn, part, slot.size);
+    ASSERT(index != kNotFound, V(hn) << V(part));
+    move(hn, --slot.size, index);
+    move(hn, --slot.num_entries, slot.size);
+  }
+
+  void update(const HypernodeID hn, const PartitionID part, const Gain delta) {
+    const PartitionID index = find(hn, part, _slots[hn].num_entries);
+    ASSERT(index != kNotFound, V(hn) << V(part));
+    _gains[_slots[hn].offset + index] += delta;
+  }
+
+  void set(const HypernodeID hn, const PartitionID part, const Gain gain) {
+    const PartitionID index = find(hn, part, _slots[hn].num_entries);
+    if (index == kNotFound) {
+      append(hn, part, gain);
+    } else {
+      _gains[_slots[hn].offset + index] = gain;
+    }
+  }
+
+  PartitionID _k;
+  HypernodeID _num_hns;
+  PartitionID _initial_capacity;
+  std::vector<Slot> _slots;
+  std::vector<PartitionID> _parts;
+  std::vector<Gain> _gains;
+  std::vector<RollbackElement> _deltas;
+};
+}  // namespace kahypar
@@ -22,11 +22,13 @@
 #pragma once
 
 #include <limits>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "kahypar/datastructure/fast_reset_array.h"
 #include "kahypar/datastructure/fast_reset_flag_array.h"
 #include "kahypar/datastructure/sparse_map.h"
 #include "kahypar/definitions.h"
@@ -34,7 +36,9 @@
 #include "kahypar/partition/metrics.h"
 #include "kahypar/partition/refinement/i_refiner.h"
 #include "kahypar/partition/refinement/lp_gain_cache.h"
+#include "kahypar/partition/refinement/parallel_gain_cache_initialization.h"
 #include "kahypar/partition/refinement/policies/fm_improvement_policy.h"
+#include "kahypar/utils/float_compare.h"
 #include "kahypar/utils/randomize.h"
 
 namespace kahypar {
@@ -55,12 +59,18 @@ class LPRefiner final : public IRefiner {
     _max_score(),
     _tmp_connectivity_decrease(configuration.partition.k, std::numeric_limits<PartitionID>::min()),
     _tmp_gains(configuration.partition.k, { 0, 0 }),
+    _thread_tmp_gains(),
     _gain_cache(_hg.initialNumNodes(), _config.partition.k),
-    _already_processed_part(_hg.initialNumNodes(), Hypergraph::kInvalidPartition) {
+    _already_processed_part(_hg.initialNumNodes(), Hypergraph::kInvalidPartition),
+    _reject_km1_increasing_moves(false) {
     ASSERT(_config.partition.mode != Mode::direct_kway ||
            (_config.partition.max_part_weights[0] == _config.partition.max_part_weights[1]),
            "Lmax values should be equal for k-way partitioning");
     _max_score.reserve(configuration.partition.k);
+    for (unsigned int i = 1; i < configuration.local_search.num_threads; ++i) {
+      _thread_tmp_gains.emplace_back(
+        new ds::SparseMap<PartitionID, LPGain>(configuration.partition.k, { 0, 0 }));
+    }
   }
 
   virtual ~LPRefiner() { }
@@ -71,6 +81,12 @@ class LPRefiner final : public IRefiner {
   LPRefiner(LPRefiner&&) = delete;
   LPRefiner& operator= (LPRefiner&&) = delete;
 
+  // LP optimizes the cut directly. If it replaces a km1 refiner, moves that
+  // would increase km1 can be rejected.
+  void rejectKMinusOneIncreasingMoves(const bool reject) {
+    _reject_km1_increasing_moves = reject;
+  }
+
   bool refineImpl(std::vector<HypernodeID>& refinement_nodes,
                   const std::array<HypernodeWeight, 2>&,
                   const UncontractionGainChanges&,
@@ -95,7 +111,7 @@ class LPRefiner final : public IRefiner {
 
     for (const HypernodeID cur_node : refinement_nodes) {
       _gain_cache.clear(cur_node);
-      initializeGainCacheFor(cur_node);
+      initializeGainCacheFor(cur_node, _tmp_gains);
       if (!_contained_cur_queue[cur_node] && _hg.isBorderNode(cur_node)) {
         ASSERT(_hg.partWeight(_hg.partID(cur_node))
                <= _config.partition.max_part_weights[_hg.partID(cur_node) % 2],
@@ -119,17 +135,23 @@ class LPRefiner final : public IRefiner {
         const auto& gain_pair = computeMaxGainMove(hn);
         const PartitionID from_part = _hg.partID(hn);
         const PartitionID to_part = gain_pair.second;
+        const Gain km1_gain = from_part != to_part ? _gain_cache.entry(hn, to_part).km1 : 0;
 
         DBG(false, "cut=" << best_metrics.cut << " max_gain_node=" << hn
             << " gain=" << gain_pair.first << " source_part=" << from_part
             << " target_part=" << to_part);
 
+        if (km1_gain < 0 && _reject_km1_increasing_moves) {
+          continue;
+        }
+
         const bool move_successful = moveHypernode(hn, from_part, gain_pair.second);
         if (move_successful) {
           reCalculateHeaviestPartAndItsWeight(heaviest_part, heaviest_part_weight,
                                               from_part, to_part);
 
           best_metrics.cut -= gain_pair.first;
+          best_metrics.km1 -= km1_gain;
           best_metrics.imbalance = static_cast<double>(heaviest_part_weight) /
                                    ceil(static_cast<double>(_config.partition.total_graph_weight) /
                                         _config.partition.k) - 1.0;
@@ -391,9 +413,10 @@ class LPRefiner final : public IRefiner {
   }
 
   void initializeGainCache() {
-    for (const HypernodeID hn : _hg.nodes()) {
-      initializeGainCacheFor(hn);
-    }
+    initializeGainCacheInParallel(_hg, _thread_tmp_gains.size() + 1,
+                                  [&](const HypernodeID hn, const size_t thread) {
+          initializeGainCacheFor(hn, thread == 0 ? _tmp_gains : *_thread_tmp_gains[thread - 1]);
+        });
   }
 
   bool hypernodeIsConnectedToPart(const HypernodeID pin, const PartitionID part) const {
@@ -423,12 +446,13 @@ class LPRefiner final : public IRefiner {
     return gain;
   }
 
-  void initializeGainCacheFor(const HypernodeID hn) {
+  void initializeGainCacheFor(const HypernodeID hn,
+                              ds::SparseMap<PartitionID, LPGain>& tmp_gains) {
     const PartitionID source_part = _hg.partID(hn);
     HyperedgeWeight internal_weight = 0;
     HyperedgeWeight internal = 0;
 
-    _tmp_gains.clear();
+    tmp_gains.clear();
 
     for (const HyperedgeID he : _hg.incidentEdges(hn)) {
       const HyperedgeWeight he_weight = _hg.edgeWeight(he);
@@ -440,21 +464,21 @@ class LPRefiner final : public IRefiner {
           break;
         case 2:
           for (const PartitionID part : _hg.connectivitySet(he)) {
-            _tmp_gains[part].km1 += he_weight;
+            tmp_gains[part].km1 += he_weight;
             if (_hg.pinCountInPart(he, part) == _hg.edgeSize(he) - 1) {
-              _tmp_gains[part].cut += he_weight;
+              tmp_gains[part].cut += he_weight;
             }
           }
           break;
         default:
           for (const PartitionID part : _hg.connectivitySet(he)) {
-            _tmp_gains[part].km1 += he_weight;
+            tmp_gains[part].km1 += he_weight;
           }
           break;
       }
     }
 
-    for (const auto& target_part : _tmp_gains) {
+    for (const auto& target_part : tmp_gains) {
       if (target_part.key == source_part) {
         continue;
       }
@@ -618,9 +642,12 @@ class LPRefiner final : public IRefiner {
   std::vector<PartitionID> _max_score;
   std::vector<PartitionID> _tmp_connectivity_decrease;
   ds::SparseMap<PartitionID, LPGain> _tmp_gains;
+  // Scratch maps of the additional threads that initialize the gain cache.
+  std::vector<std::unique_ptr<ds::SparseMap<PartitionID, LPGain> > > _thread_tmp_gains;
 
   GainCache _gain_cache;
   // see KWayFMRefiner.h for documentation.
   ds::FastResetArray<PartitionID> _already_processed_part;
+  bool _reject_km1_increasing_moves;
 };
 }  // namespace kahypar
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2014 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "kahypar/definitions.h"
+
+namespace kahypar {
+// Hypergraphs with fewer enabled hypernodes per thread are initialized by the calling thread.
+static constexpr HypernodeID kMinNodesPerGainCacheInitThread = 1024;
+
+// Calls init_node(hn, thread) for all enabled hypernodes of the hypergraph. The range of
+// hypernode IDs is split into contiguous chunks that are processed by up to max_threads
+// threads concurrently. init_node therefore may only read the hypergraph and may only write
+// data that is private to hn or to the thread.
+template <typename InitNode>
+void initializeGainCacheInParallel(const Hypergraph& hypergraph, const size_t max_threads,
+                                   InitNode&& init_node) {
+  const HypernodeID num_ids = hypergraph.initialNumNodes();
+  const size_t num_threads = std::max(static_cast<size_t>(1),
+                                      std::min(max_threads, static_cast<size_t>(
+                                                 hypergraph.currentNumNodes() /
+                                                 kMinNodesPerGainCacheInitThread)));
+  const size_t chunk_size = (num_ids + num_threads - 1) / num_threads;
+  auto init_chunk = [&](const size_t thread) {
+                      const HypernodeID end = std::min(static_cast<size_t>(num_ids),
+                                                       (thread + 1) * chunk_size);
+                      for (HypernodeID hn = thread * chunk_size; hn < end; ++hn) {
+                        if (hypergraph.nodeIsEnabled(hn)) {
+                          init_node(hn, thread);
+                        }
+                      }
+                    };
+  if (num_threads == 1) {
+    init_chunk(0);
+  } else {
+    std::vector<std::thread> threads;
+    for (size_t thread = 1; thread < num_threads; ++thread) {
+      threads.emplace_back(init_chunk, thread);
+    }
+    init_chunk(0);
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+}
+}  // namespace kahypar
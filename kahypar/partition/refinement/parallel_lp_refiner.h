@@ -0,0 +1,337 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kahypar/datastructure/fast_reset_flag_array.h"
+#include "kahypar/datastructure/sparse_map.h"
+#include "kahypar/definitions.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/partition/refinement/lp_gain_cache.h"
+#include "kahypar/partition/refinement/policies/fm_improvement_policy.h"
+#include "kahypar/utils/float_compare.h"
+#include "kahypar/utils/randomize.h"
+
+namespace kahypar {
+/*!
+ * Synchronous size-constrained label propagation using several threads.
+ *
+ * In each round, the active border nodes are split into chunks and each thread
+ * computes the best move of the nodes in its chunk w.r.t. the partition at the
+ * beginning of the round, using thread-local scratch space for the gains.
+ * Unless deterministic mode is enabled, the target blocks are reserved
+ * atomically, so that a thread only proposes moves that keep all blocks within
+ * their weight limits. The proposed moves are then applied in queue order. Since
+ * neighbouring nodes are moved simultaneously, the gain of each move is recomputed
+ * before it is applied and moves that no longer improve the cut are dropped.
+ * In deterministic mode, no reservations are made and the balance constraint is
+ * only checked while applying the moves, which makes the result independent of
+ * the number of threads and their scheduling.
+ */
+class ParallelLPRefiner final : public IRefiner {
+  using FMImprovementPolicy = CutDecreasedOrInfeasibleImbalanceDecreased;
+
+  static constexpr size_t kMinNodesPerThread = 64;
+
+ public:
+  ParallelLPRefiner(Hypergraph& hg, const Configuration& configuration) :
+    _hg(hg),
+    _config(configuration),
+    _cur_queue(),
+    _next_queue(),
+    _contained_next_queue(hg.initialNumNodes()),
+    _moved_nodes(),
+    _target_parts(),
+    _reserved_part_weights(configuration.partition.k),
+    _tmp_gains() {
+    ASSERT(_config.partition.mode != Mode::direct_kway ||
+           (_config.partition.max_part_weights[0] == _config.partition.max_part_weights[1]),
+           "Lmax values should be equal for k-way partitioning");
+    const size_t num_threads = std::max(1u, configuration.local_search.num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+      _tmp_gains.emplace_back(new ds::SparseMap<PartitionID, LPGain>(configuration.partition.k,
+                                                                  { 0, 0 }));
+    }
+  }
+
+  ~ParallelLPRefiner() override = default;
+
+  ParallelLPRefiner(const ParallelLPRefiner&) = delete;
+  ParallelLPRefiner& operator= (const ParallelLPRefiner&) = delete;
+
+  ParallelLPRefiner(ParallelLPRefiner&&) = delete;
+  ParallelLPRefiner& operator= (ParallelLPRefiner&&) = delete;
+
+  bool refineImpl(std::vector<HypernodeID>& refinement_nodes,
+                  const std::array<HypernodeWeight, 2>&,
+                  const UncontractionGainChanges&,
+                  Metrics& best_metrics) override final {
+    ASSERT(best_metrics.cut == metrics::hyperedgeCut(_hg),
+           V(best_metrics.cut) << V(metrics::hyperedgeCut(_hg)));
+    ASSERT(best_metrics.km1 == metrics::km1(_hg),
+           V(best_metrics.km1) << V(metrics::km1(_hg)));
+    ASSERT(FloatingPoint<double>(best_metrics.imbalance).AlmostEquals(
+             FloatingPoint<double>(metrics::imbalance(_hg, _config))),
+           V(best_metrics.imbalance) << V(metrics::imbalance(_hg, _config)));
+
+    _cur_queue.clear();
+    _next_queue.clear();
+    _contained_next_queue.reset();
+
+    const HyperedgeWeight initial_cut = best_metrics.cut;
+    const double initial_imbalance = best_metrics.imbalance;
+    HyperedgeWeight current_cut = best_metrics.cut;
+    double current_imbalance = best_metrics.imbalance;
+
+    for (const HypernodeID& hn : refinement_nodes) {
+      if (!_contained_next_queue[hn] && _hg.isBorderNode(hn)) {
+        _cur_queue.push_back(hn);
+        _contained_next_queue.set(hn, true);
+      }
+    }
+    _contained_next_queue.reset();
+
+    for (int i = 0;
+         (i == 0 || best_metrics.cut < current_cut || best_metrics.imbalance < current_imbalance) &&
+         !_cur_queue.empty() && i < _config.local_search.sclap.max_number_iterations; ++i) {
+      current_cut = best_metrics.cut;
+      current_imbalance = best_metrics.imbalance;
+
+      Randomize::instance().shuffleVector(_cur_queue, _cur_queue.size());
+      computeMoves();
+      applyMoves(best_metrics);
+
+      for (const HypernodeID& hn : _moved_nodes) {
+        for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+          for (const HypernodeID& pin : _hg.pins(he)) {
+            if (!_contained_next_queue[pin] && _hg.isBorderNode(pin)) {
+              _contained_next_queue.set(pin, true);
+              _next_queue.push_back(pin);
+            }
+          }
+        }
+      }
+      _contained_next_queue.reset();
+      _cur_queue.clear();
+      _cur_queue.swap(_next_queue);
+    }
+
+    ASSERT(best_metrics.cut == metrics::hyperedgeCut(_hg),
+           V(best_metrics.cut) << V(metrics::hyperedgeCut(_hg)));
+    ASSERT(best_metrics.km1 == metrics::km1(_hg),
+           V(best_metrics.km1) << V(metrics::km1(_hg)));
+    return FMImprovementPolicy::improvementFound(best_metrics.cut, initial_cut,
+                                                 best_metrics.imbalance,
+                                                 initial_imbalance, _config.partition.epsilon);
+  }
+
+  std::string policyStringImpl() const override final {
+    return " lp_refiner_max_iterations=" +
+           std::to_string(_config.local_search.sclap.max_number_iterations) +
+           " lp_refiner_num_threads=" + std::to_string(_tmp_gains.size()) +
+           " lp_refiner_deterministic=" +
+           (_config.local_search.sclap.deterministic ? "true" : "false");
+  }
+
+ private:
+  void initializeImpl(const HyperedgeWeight) override final {
+    if (!_is_initialized) {
+      _is_initialized = true;
+      _cur_queue.reserve(_hg.initialNumNodes());
+      _next_queue.reserve(_hg.initialNumNodes());
+    }
+  }
+
+  HypernodeWeight maxPartWeight(const PartitionID part) const {
+    return _config.partition.max_part_weights[part % 2];
+  }
+
+  // Computes the target part of each node in the current queue w.r.t. the partition
+  // at the beginning of the round. kInvalidPartition denotes that a node stays in its part.
+  void computeMoves() {
+    _target_parts.assign(_cur_queue.size(), Hypergraph::kInvalidPartition);
+    for (PartitionID part = 0; part < _config.partition.k; ++part) {
+      _reserved_part_weights[part].store(_hg.partWeight(part), std::memory_order_relaxed);
+    }
+
+    const size_t num_threads = std::max(static_cast<size_t>(1),
+                                        std::min(_tmp_gains.size(),
+                                                 _cur_queue.size() / kMinNodesPerThread));
+    const size_t chunk_size = (_cur_queue.size() + num_threads - 1) / num_threads;
+    auto compute_chunk = [&](const size_t thread) {
+                           const size_t end = std::min(_cur_queue.size(), (thread + 1) * chunk_size);
+                           for (size_t pos = thread * chunk_size; pos < end; ++pos) {
+                             _target_parts[pos] = computeMaxGainMove(_cur_queue[pos],
+                                                                     *_tmp_gains[thread]);
+                           }
+                         };
+    if (num_threads == 1) {
+      compute_chunk(0);
+    } else {
+      std::vector<std::thread> threads;
+      for (size_t thread = 1; thread < num_threads; ++thread) {
+        threads.emplace_back(compute_chunk, thread);
+      }
+      compute_chunk(0);
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+    }
+  }
+
+  PartitionID computeMaxGainMove(const HypernodeID hn,
+                                 ds::SparseMap<PartitionID, LPGain>& tmp_gains) {
+    const PartitionID source_part = _hg.partID(hn);
+    HyperedgeWeight internal_weight = 0;
+    HyperedgeWeight internal = 0;
+
+    tmp_gains.clear();
+    for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+      const HyperedgeWeight he_weight = _hg.edgeWeight(he);
+      internal += _hg.pinCountInPart(he, source_part) != 1 ? he_weight : 0;
+      if (_hg.connectivity(he) == 1) {
+        internal_weight += he_weight;
+        continue;
+      }
+      for (const PartitionID& part : _hg.connectivitySet(he)) {
+        tmp_gains[part].km1 += he_weight;
+        if (_hg.connectivity(he) == 2 && _hg.pinCountInPart(he, part) == _hg.edgeSize(he) - 1) {
+          tmp_gains[part].cut += he_weight;
+        }
+      }
+    }
+
+    const HypernodeWeight node_weight = _hg.nodeWeight(hn);
+    const bool source_part_imbalanced = _hg.partWeight(source_part) > maxPartWeight(source_part);
+    PartitionID best_part = Hypergraph::kInvalidPartition;
+    LPGain best_gain(0, 0);
+    for (const auto& target : tmp_gains) {
+      if (target.key == source_part ||
+          _hg.partWeight(target.key) + node_weight > maxPartWeight(target.key)) {
+        continue;
+      }
+      // Ties are broken by block ID, since the order of the connectivity sets
+      // depends on the order of previous moves.
+      const LPGain gain(target.value.cut - internal_weight, target.value.km1 - internal);
+      if (increasesKm1(gain)) {
+        continue;
+      }
+      if (best_part == Hypergraph::kInvalidPartition ?
+          (isImprovement(gain) || source_part_imbalanced) :
+          (gain.cut > best_gain.cut ||
+           (gain.cut == best_gain.cut && (gain.km1 > best_gain.km1 ||
+                                          (gain.km1 == best_gain.km1 &&
+                                           target.key < best_part))))) {
+        best_part = target.key;
+        best_gain = gain;
+      }
+    }
+
+    if (best_part != Hypergraph::kInvalidPartition && !_config.local_search.sclap.deterministic &&
+        !reserve(best_part, node_weight)) {
+      return Hypergraph::kInvalidPartition;
+    }
+    return best_part;
+  }
+
+  bool reserve(const PartitionID part, const HypernodeWeight weight) {
+    if (_reserved_part_weights[part].fetch_add(weight, std::memory_order_relaxed) + weight >
+        maxPartWeight(part)) {
+      _reserved_part_weights[part].fetch_sub(weight, std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  static bool isImprovement(const LPGain& gain) {
+    return gain.cut > 0 || (gain.cut == 0 && gain.km1 > 0);
+  }
+
+  // The cut is optimized directly. If km1 is the objective of direct k-way
+  // partitioning, moves that would increase km1 are not performed.
+  bool increasesKm1(const LPGain& gain) const {
+    return gain.km1 < 0 && _config.partition.mode == Mode::direct_kway &&
+           _config.partition.objective == Objective::km1;
+  }
+
+  void applyMoves(Metrics& best_metrics) {
+    _moved_nodes.clear();
+    for (size_t pos = 0; pos < _cur_queue.size(); ++pos) {
+      const HypernodeID hn = _cur_queue[pos];
+      const PartitionID from_part = _hg.partID(hn);
+      const PartitionID to_part = _target_parts[pos];
+      if (to_part == Hypergraph::kInvalidPartition || _hg.partSize(from_part) == 1 ||
+          _hg.partWeight(to_part) + _hg.nodeWeight(hn) > maxPartWeight(to_part)) {
+        continue;
+      }
+      // Neighbours moved in the same round might have changed the gain.
+      const LPGain gain = gainInducedByHypergraph(hn, from_part, to_part);
+      if ((!isImprovement(gain) && _hg.partWeight(from_part) <= maxPartWeight(from_part)) ||
+          increasesKm1(gain)) {
+        continue;
+      }
+      _hg.changeNodePart(hn, from_part, to_part);
+      _moved_nodes.push_back(hn);
+      best_metrics.cut -= gain.cut;
+      best_metrics.km1 -= gain.km1;
+    }
+    best_metrics.imbalance = metrics::imbalance(_hg, _config);
+  }
+
+  LPGain gainInducedByHypergraph(const HypernodeID hn, const PartitionID source_part,
+                                 const PartitionID target_part) const {
+    LPGain gain(0, 0);
+    for (const HyperedgeID& he : _hg.incidentEdges(hn)) {
+      const HyperedgeWeight he_weight = _hg.edgeWeight(he);
+      const HypernodeID pins_in_source_part = _hg.pinCountInPart(he, source_part);
+      const HypernodeID pins_in_target_part = _hg.pinCountInPart(he, target_part);
+      if (pins_in_source_part == _hg.edgeSize(he)) {
+        gain.cut -= he_weight;
+      } else if (pins_in_source_part == 1 && pins_in_target_part == _hg.edgeSize(he) - 1) {
+        gain.cut += he_weight;
+      }
+      gain.km1 += pins_in_source_part == 1 ? he_weight : 0;
+      gain.km1 -= pins_in_target_part == 0 ? he_weight : 0;
+    }
+    return gain;
+  }
+
+  Hypergraph& _hg;
+  const Configuration& _config;
+  std::vector<HypernodeID> _cur_queue;
+  std::vector<HypernodeID> _next_queue;
+  ds::FastResetFlagArray<> _contained_next_queue;
+  std::vector<HypernodeID> _moved_nodes;
+  std::vector<PartitionID> _target_parts;
+  std::vector<std::atomic<HypernodeWeight> > _reserved_part_weights;
+  // Thread-local scratch space for the gain computation.
+  std::vector<std::unique_ptr<ds::SparseMap<PartitionID, LPGain> > > _tmp_gains;
+};
+}  // namespace kahypar
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2014 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include "kahypar/definitions.h"
+#include "kahypar/meta/policy_registry.h"
+#include "kahypar/meta/typelist.h"
+#include "kahypar/partition/refinement/kway_fm_gain_cache.h"
+#include "kahypar/partition/refinement/kway_fm_sparse_gain_cache.h"
+
+namespace kahypar {
+struct GainCachePolicy : meta::PolicyBase {
+ protected:
+  GainCachePolicy() { }
+};
+
+// Stores k gain entries per hypernode.
+class DenseGainCache : public GainCachePolicy {
+ public:
+  using Cache = KwayGainCache<Gain>;
+  // Entries of different hypernodes are stored disjointly and can be initialized concurrently.
+  static constexpr bool concurrent_initialization = true;
+};
+
+// Stores gain entries only for the blocks adjacent to each hypernode.
+class SparseGainCache : public GainCachePolicy {
+ public:
+  using Cache = KwaySparseGainCache<Gain>;
+  // Entries are appended to a shared arena and have to be initialized sequentially.
+  static constexpr bool concurrent_initialization = false;
+};
+
+using GainCachePolicyClasses = meta::Typelist<DenseGainCache, SparseGainCache>;
+}  // namespace kahypar
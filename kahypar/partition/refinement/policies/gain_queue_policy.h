@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#pragma once
+
+#include <limits>
+
+#include "kahypar/datastructure/bucket_queue.h"
+#include "kahypar/datastructure/kway_priority_queue.h"
+#include "kahypar/definitions.h"
+#include "kahypar/meta/policy_registry.h"
+#include "kahypar/meta/typelist.h"
+
+namespace kahypar {
+struct GainQueuePolicy : meta::PolicyBase {
+ protected:
+  GainQueuePolicy() { }
+};
+
+// Stores gains in binary heaps.
+class HeapGainQueue : public GainQueuePolicy {
+ public:
+  template <bool UseRandomTieBreaking>
+  using KWayPQ = ds::KWayPriorityQueue<HypernodeID, Gain, std::numeric_limits<Gain>,
+                                       UseRandomTieBreaking>;
+  // Queue of the greedy hypergraph growing IP
+  using PQ = KWayPQ<true>;
+
+  template <class GainComputation>
+  static inline void initialize(PQ& pq, const Hypergraph& hg) {
+    pq.initialize(hg.initialNumNodes());
+  }
+
+  template <class Queue>
+  static inline void initialize(Queue& pq, const HypernodeID num_hypernodes,
+                                const HyperedgeWeight) {
+    pq.initialize(num_hypernodes);
+  }
+};
+
+// Stores gains in bucket queues, whose key range is bounded by the maximum gain.
+// For the greedy hypergraph growing IP, the bound is given by the GainComputation
+// policy. The FM refiners are initialized with max. node degree * max. edge weight.
+class BucketGainQueue : public GainQueuePolicy {
+ public:
+  template <bool UseRandomTieBreaking>
+  using KWayPQ = ds::KWayPriorityQueue<HypernodeID, Gain, std::numeric_limits<Gain>,
+                                       UseRandomTieBreaking,
+                                       ds::EnhancedBucketQueue<HypernodeID, Gain,
+                                                               std::numeric_limits<Gain> > >;
+  // Queue of the greedy hypergraph growing IP
+  using PQ = KWayPQ<true>;
+
+  template <class GainComputation>
+  static inline void initialize(PQ& pq, const Hypergraph& hg) {
+    pq.initialize(hg.initialNumNodes(), GainComputation::maxGain(hg));
+  }
+
+  template <class Queue>
+  static inline void initialize(Queue& pq, const HypernodeID num_hypernodes,
+                                const HyperedgeWeight max_gain) {
+    pq.initialize(num_hypernodes, max_gain);
+  }
+};
+
+using GainQueuePolicyClasses = meta::Typelist<HeapGainQueue, BucketGainQueue>;
+}  // namespace kahypar
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2014 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/configuration.h"
+
+namespace kahypar {
+// Distributes the time that remains until config.partition.deadline among the
+// uncoarsening levels. Each level gets a share of the remaining time that is proportional
+// to its number of hypernodes. The time of a level is converted into a move budget for
+// the FM stopping policies based on the time per move observed on the previous levels.
+// If the average time per level observed so far does not suffice to refine all remaining
+// levels in time, the scheduler is behind schedule.
+class RefinementScheduler {
+ public:
+  static constexpr int kUnlimitedMoves = std::numeric_limits<int>::max();
+  static constexpr uint64_t kMinObservedLevels = 100;
+
+  explicit RefinementScheduler(const Configuration& config) :
+    _config(config),
+    _num_nodes_of_finest_level(0),
+    _refinement_seconds(0.0),
+    _num_moves(0),
+    _num_refined_levels(0) { }
+
+  RefinementScheduler(const RefinementScheduler&) = delete;
+  RefinementScheduler& operator= (const RefinementScheduler&) = delete;
+
+  RefinementScheduler(RefinementScheduler&&) = delete;
+  RefinementScheduler& operator= (RefinementScheduler&&) = delete;
+
+  static bool hasDeadline(const Configuration& config) {
+    return config.partition.time_limit > 0.0;
+  }
+
+  static bool deadlinePassed(const Configuration& config) {
+    return hasDeadline(config) &&
+           std::chrono::high_resolution_clock::now() >= config.partition.deadline;
+  }
+
+  static HighResClockTimepoint deadlineAfter(const double seconds) {
+    return std::chrono::high_resolution_clock::now() +
+           std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+             std::chrono::duration<double>(seconds));
+  }
+
+  // Starts the uncoarsening of a hypergraph that has num_nodes_of_finest_level hypernodes
+  // once all contractions are undone.
+  void reset(const HypernodeID num_nodes_of_finest_level) {
+    _num_nodes_of_finest_level = num_nodes_of_finest_level;
+    _refinement_seconds = 0.0;
+    _num_moves = 0;
+    _num_refined_levels = 0;
+  }
+
+  // Returns the number of moves the local search on the current level may perform.
+  // Before any move has been observed, the budget is unlimited.
+  int moveBudget(const HypernodeID num_nodes) const {
+    ASSERT(num_nodes <= _num_nodes_of_finest_level, V(num_nodes));
+    if (_num_moves == 0 || _refinement_seconds <= 0.0) {
+      return kUnlimitedMoves;
+    }
+    const double remaining_seconds = remainingSeconds();
+    if (remaining_seconds <= 0.0) {
+      return 0;
+    }
+    const double level_seconds = remaining_seconds * num_nodes /
+                                 (numRemainingLevels(num_nodes) *
+                                  (num_nodes + _num_nodes_of_finest_level) / 2.0);
+    const double move_budget = level_seconds * _num_moves / _refinement_seconds;
+    return move_budget >= kUnlimitedMoves ? kUnlimitedMoves : static_cast<int>(move_budget);
+  }
+
+  // Returns true if refining the current and all finer levels at the average time per
+  // level observed so far would exceed the deadline. Single levels can take much longer
+  // than the average, so the first kMinObservedLevels levels are never behind schedule.
+  bool isBehindSchedule(const HypernodeID num_nodes) const {
+    ASSERT(num_nodes <= _num_nodes_of_finest_level, V(num_nodes));
+    if (_num_refined_levels < kMinObservedLevels) {
+      return false;
+    }
+    const double seconds_per_level = _refinement_seconds / _num_refined_levels;
+    return seconds_per_level * numRemainingLevels(num_nodes) > remainingSeconds();
+  }
+
+  void update(const double refinement_seconds, const int num_moves) {
+    _refinement_seconds += refinement_seconds;
+    _num_moves += num_moves;
+    ++_num_refined_levels;
+  }
+
+ private:
+  double remainingSeconds() const {
+    return std::chrono::duration<double>(_config.partition.deadline -
+                                         std::chrono::high_resolution_clock::now()).count();
+  }
+
+  // The levels that remain to be refined have num_nodes, num_nodes + batch_size, ...,
+  // _num_nodes_of_finest_level hypernodes.
+  double numRemainingLevels(const HypernodeID num_nodes) const {
+    return std::ceil(static_cast<double>(_num_nodes_of_finest_level - num_nodes) /
+                     _config.local_search.uncontraction_batch_size) + 1.0;
+  }
+
+  const Configuration& _config;
+  HypernodeID _num_nodes_of_finest_level;
+  double _refinement_seconds;
+  uint64_t _num_moves;
+  uint64_t _num_refined_levels;
+};
+}  // namespace kahypar
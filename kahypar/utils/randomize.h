@@ -29,8 +29,10 @@
 namespace kahypar {
 class Randomize {
  public:
+  // Each thread uses its own random number generator. Threads other than the
+  // main thread have to be seeded explicitly via setSeed.
   static Randomize & instance() {
-    static Randomize instance;
+    static thread_local Randomize instance;
     return instance;
   }
 
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+namespace kahypar {
+namespace serialization {
+// Raw binary (de-)serialization of trivially copyable values and vectors thereof.
+// The resulting format is neither portable across architectures nor across builds
+// that use different type definitions and is therefore only suited for caching.
+template <typename T>
+static inline void write(std::ostream& out, const T& value) {
+  static_assert(std::is_trivially_copyable<T>::value, "Type has to be trivially copyable");
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static inline bool read(std::istream& in, T& value) {
+  static_assert(std::is_trivially_copyable<T>::value, "Type has to be trivially copyable");
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return static_cast<bool>(in);
+}
+
+template <typename T>
+static inline void writeVector(std::ostream& out, const std::vector<T>& vec) {
+  static_assert(std::is_trivially_copyable<T>::value, "Type has to be trivially copyable");
+  write(out, static_cast<uint64_t>(vec.size()));
+  out.write(reinterpret_cast<const char*>(vec.data()), sizeof(T) * vec.size());
+}
+
+// Reads a vector that was written via writeVector. If expected_size is given,
+// the stored vector has to have exactly this size.
+template <typename T>
+static inline bool readVector(std::istream& in, std::vector<T>& vec,
+                              const uint64_t expected_size = UINT64_MAX) {
+  static_assert(std::is_trivially_copyable<T>::value, "Type has to be trivially copyable");
+  uint64_t size = 0;
+  if (!read(in, size) || (expected_size != UINT64_MAX && size != expected_size)) {
+    return false;
+  }
+  vec.resize(size);
+  in.read(reinterpret_cast<char*>(vec.data()), sizeof(T) * size);
+  return static_cast<bool>(in);
+}
+}  // namespace serialization
+}  // namespace kahypar
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -42,6 +43,7 @@ class Stats {
 
   void add(const Configuration& config, const std::string& key, double value) {
     if (config.partition.collect_stats) {
+      std::lock_guard<std::mutex> lock(_mutex);
       _stats["v" + std::to_string(config.partition.current_v_cycle)
              + "_lk_" + std::to_string(config.partition.rb_lower_k)
              + "_uk_" + std::to_string(config.partition.rb_upper_k)
@@ -51,6 +53,7 @@ class Stats {
 
   void addToTotal(bool collect_stats, const std::string& key, double value) {
     if (collect_stats) {
+      std::lock_guard<std::mutex> lock(_mutex);
       _stats[key] += value;
     }
   }
@@ -90,8 +93,11 @@ class Stats {
 
  private:
   Stats() :
-    _stats() { }
+    _stats(),
+    _mutex() { }
   StatsMap _stats;
+  // Recursive bisection can partition several subproblems concurrently.
+  std::mutex _mutex;
 };
 
 #ifdef GATHER_STATS
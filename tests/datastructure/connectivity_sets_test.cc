@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/datastructure/connectivity_sets.h"
+#include "kahypar/definitions.h"
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::Eq;
+using ::testing::Test;
+
+namespace kahypar {
+namespace ds {
+using Sets = ConnectivitySets<PartitionID, HyperedgeID>;
+
+template <typename Set>
+std::vector<PartitionID> blocks(const Set& set) {
+  return std::vector<PartitionID>(set.begin(), set.end());
+}
+
+class ConnectivitySetsForLargeK : public Test {
+ public:
+  ConnectivitySetsForLargeK() :
+    sets(3, 1024) { }
+
+  Sets sets;
+};
+
+TEST_F(ConnectivitySetsForLargeK, AreInitiallyEmpty) {
+  for (HyperedgeID he = 0; he < 3; ++he) {
+    ASSERT_THAT(sets[he].size(), Eq(0));
+    ASSERT_THAT(sets[he].begin() == sets[he].end(), Eq(true));
+  }
+}
+
+TEST_F(ConnectivitySetsForLargeK, ReplaceRemovedBlocksByTheLastBlock) {
+  sets.add(1, 7);
+  sets.add(1, 1000);
+  sets.add(1, 3);
+  sets.add(1, 512);
+  sets.remove(1, 1000);
+  ASSERT_THAT(blocks(sets[1]), ElementsAre(7, 512, 3));
+  ASSERT_THAT(sets.contains(1, 1000), Eq(false));
+  ASSERT_THAT(sets.contains(1, 512), Eq(true));
+  ASSERT_THAT(sets[0].size(), Eq(0));
+  ASSERT_THAT(sets[2].size(), Eq(0));
+}
+
+TEST_F(ConnectivitySetsForLargeK, GrowBeyondTheirInlineStorage) {
+  std::vector<PartitionID> expected;
+  for (PartitionID part = 1023; part >= 0; part -= 3) {
+    sets.add(0, part);
+    sets.add(2, part / 2);
+    expected.push_back(part);
+  }
+  ASSERT_THAT(blocks(sets[0]), ElementsAreArray(expected));
+  ASSERT_THAT(sets[1].size(), Eq(0));
+
+  sets.clear(0);
+  ASSERT_THAT(sets[0].size(), Eq(0));
+  sets.add(0, 42);
+  ASSERT_THAT(blocks(sets[0]), ElementsAre(42));
+}
+
+TEST_F(ConnectivitySetsForLargeK, KeepViewsOfOtherSetsValidWhileGrowing) {
+  for (PartitionID part = 0; part < 10; ++part) {
+    sets.add(0, part);
+  }
+  const auto view = sets[0];
+  for (PartitionID part = 0; part < 1024; ++part) {
+    sets.add(1, part);
+  }
+  ASSERT_THAT(blocks(view), ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(ConnectivitySets, UseLessMemoryThanDenseSetsForLargeK) {
+  const PartitionID k = 1024;
+  Sets sets(1000, k);
+  for (HyperedgeID he = 0; he < 1000; ++he) {
+    for (PartitionID i = 0; i < static_cast<PartitionID>(he % 8); ++i) {
+      sets.add(he, (he + 17 * i) % k);
+    }
+  }
+  ASSERT_THAT(sets.sizeInBytes() < 1000 * 2 * k * sizeof(PartitionID) / 64, Eq(true));
+}
+
+TEST(ConnectivitySets, SupportBlockIDsThatDoNotFitIntoSixteenBits) {
+  Sets sets(2, 100000);
+  sets.add(1, 99999);
+  sets.add(1, 65536);
+  sets.add(1, 0);
+  sets.add(1, 70000);
+  ASSERT_THAT(blocks(sets[1]), ElementsAre(99999, 65536, 0, 70000));
+  sets.remove(1, 99999);
+  ASSERT_THAT(blocks(sets[1]), ElementsAre(70000, 65536, 0));
+}
+}  // namespace ds
+}  // namespace kahypar
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#include <limits>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/datastructure/fast_reset_hash_set.h"
+
+using::testing::Eq;
+using::testing::Test;
+
+namespace kahypar {
+namespace ds {
+TEST(AFastResetHashSet, ContainsOnlyAddedKeys) {
+  FastResetHashSet<> set;
+  set.add(5);
+  set.add(42);
+  set.add(5);
+  ASSERT_TRUE(set.contains(5));
+  ASSERT_TRUE(set.contains(42));
+  ASSERT_FALSE(set.contains(6));
+  ASSERT_THAT(set.size(), Eq(2));
+}
+
+TEST(AFastResetHashSet, IsEmptyAfterClear) {
+  FastResetHashSet<> set;
+  set.add(5);
+  set.add(42);
+  set.clear();
+  ASSERT_FALSE(set.contains(5));
+  ASSERT_FALSE(set.contains(42));
+  ASSERT_THAT(set.size(), Eq(0));
+  set.add(42);
+  ASSERT_TRUE(set.contains(42));
+}
+
+TEST(AFastResetHashSet, GrowsWithTheNumberOfContainedKeys) {
+  FastResetHashSet<> set;
+  for (uint64_t key = 0; key < 1000; ++key) {
+    set.add(key * 256);
+  }
+  ASSERT_THAT(set.size(), Eq(1000));
+  ASSERT_THAT(set.capacity(), Eq(2048));
+  for (uint64_t key = 0; key < 256000; ++key) {
+    ASSERT_THAT(set.contains(key), Eq(key % 256 == 0));
+  }
+}
+
+TEST(AFastResetHashSet, DoesNotGrowIfClearedRegularly) {
+  FastResetHashSet<> set;
+  for (uint64_t round = 0; round < 100; ++round) {
+    for (uint64_t key = 0; key < 8; ++key) {
+      set.add(round * 1000 + key);
+    }
+    set.clear();
+  }
+  ASSERT_THAT(set.capacity(), Eq(16));
+}
+
+TEST(AFastResetHashSet, HandlesTimestampOverflow) {
+  FastResetHashSet<> set;
+  set.add(5);
+  set._timestamp = std::numeric_limits<uint32_t>::max() - 1;
+  set.add(6);
+  set.clear();
+  ASSERT_THAT(set._timestamp, Eq(1));
+  ASSERT_FALSE(set.contains(5));
+  ASSERT_FALSE(set.contains(6));
+}
+}  // namespace ds
+}  // namespace kahypar
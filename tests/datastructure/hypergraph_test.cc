@@ -18,6 +18,7 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <stack>
 #include <tuple>
@@ -359,7 +360,8 @@ TEST_F(AnUncontractedHypergraph, EqualsTheInitialHypergraphBeforeContraction) {
   std::vector<std::pair<HypernodeID, HypernodeID> > contractions { { 4, 6 }, { 3, 4 }, { 0, 2 },
                                                                    { 0, 1 }, { 0, 5 }, { 0, 3 } };
   std::stack<CoarseningMemento> contraction_history;
-  HypergraphPruner hypergraph_pruner(modified_hypergraph.initialNumNodes());
+  HypergraphPruner hypergraph_pruner(modified_hypergraph.initialNumNodes(),
+                                     modified_hypergraph.initialNumEdges());
   for (const auto& contraction : contractions) {
     contraction_history.emplace(modified_hypergraph.contract(contraction.first,
                                                              contraction.second));
@@ -471,7 +473,7 @@ TEST_F(AHypergraph, InvalidatesPartitionPinCountsOnHyperedgeRemoval) {
 
   for (PartitionID part = 0; part < hypergraph._k; ++part) {
     // bypass pinCountInPart because of assertions
-    const HypernodeID num_pins = hypergraph._pins_in_part[1 * hypergraph._k + part];
+    const HypernodeID num_pins = hypergraph._pins_in_part.value(1, part);
     ASSERT_THAT(num_pins, Eq(hypergraph.kInvalidCount));
   }
 }
@@ -776,6 +778,39 @@ TEST_F(AHypergraph, CreatedViaReindexingIsACopyOfTheOriginalHypergraph) {
   verifyEquivalenceWithoutPartitionInfo(hypergraph, *reindex(hypergraph).first);
 }
 
+TEST(AHypergraphWithManyBlocks, UpdatesPinCountsInTheCompactLayout) {
+  const PartitionID k = PinCountsInPart<HypernodeID, HyperedgeID,
+                                        PartitionID>::kCompactLayoutMinK;
+  Hypergraph hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                        HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 }, k);
+  const Memento memento = hypergraph.contract(3, 4);
+  for (const HypernodeID& hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, hn == 3 || hn == 6 ? k - 1 : 0);
+  }
+  hypergraph.initializeNumCutHyperedges();
+  ASSERT_THAT(hypergraph.pinCountInPart(1, 0), Eq(2));
+  ASSERT_THAT(hypergraph.pinCountInPart(1, k - 1), Eq(1));
+  ASSERT_THAT(hypergraph.pinCountInPart(2, k - 1), Eq(2));
+
+  hypergraph.uncontract(memento);
+  ASSERT_THAT(hypergraph.pinCountInPart(1, k - 1), Eq(2));
+  ASSERT_THAT(hypergraph.pinCountInPart(2, 0), Eq(0));
+  ASSERT_THAT(hypergraph.pinCountInPart(2, k - 1), Eq(3));
+
+  hypergraph.changeNodePart(0, 0, k - 1);
+  ASSERT_THAT(hypergraph.pinCountInPart(0, 0), Eq(1));
+  ASSERT_THAT(hypergraph.pinCountInPart(1, k - 1), Eq(3));
+  ASSERT_THAT(hypergraph.connectivity(1), Eq(2));
+}
+
+TEST(AReindexedHypergraph, IsACopyOfTheOriginalHypergraphForMoreThanTwoBlocks) {
+  Hypergraph hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                        HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 }, 4);
+
+  ASSERT_THAT(verifyEquivalenceWithoutPartitionInfo(hypergraph, *reindex(hypergraph).first),
+              Eq(true));
+}
+
 TEST_F(AHypergraph, WithContractedHypernodesCanBeReindexed) {
   hypergraph.contract(1, 4);
   hypergraph.contract(0, 2);
@@ -789,11 +824,87 @@ TEST_F(AHypergraph, WithContractedHypernodesCanBeReindexed) {
   ASSERT_THAT(reindexed.second, ContainerEq(std::vector<HypernodeID>{ 0, 1, 3, 5, 6 }));
 }
 
+TEST_F(AHypergraph, WithContractedHypernodesCanBeCompactedInPlace) {
+  hypergraph.contract(1, 4);
+  hypergraph.contract(0, 2);
+  hypergraph.removeEdge(1);
+  auto reindexed = reindex(hypergraph);
+  Hypergraph& copy = *reindexed.first;
+
+  CompactHypergraphView<Hypergraph> view(hypergraph);
+  Hypergraph& compacted = view.hypergraph();
+
+  ASSERT_THAT(compacted.initialNumNodes(), Eq(5));
+  ASSERT_THAT(compacted.initialNumEdges(), Eq(3));
+  ASSERT_THAT(compacted.initialNumPins(), Eq(copy.initialNumPins()));
+  for (const HypernodeID hn : copy.nodes()) {
+    ASSERT_THAT(view.originalID(hn), Eq(reindexed.second[hn]));
+    ASSERT_THAT(compacted.nodeWeight(hn), Eq(copy.nodeWeight(hn)));
+    ASSERT_THAT(std::vector<HyperedgeID>(compacted.incidentEdges(hn).first,
+                                         compacted.incidentEdges(hn).second),
+                ContainerEq(std::vector<HyperedgeID>(copy.incidentEdges(hn).first,
+                                                     copy.incidentEdges(hn).second)));
+  }
+  for (const HyperedgeID he : copy.edges()) {
+    ASSERT_THAT(std::vector<HypernodeID>(compacted.pins(he).first, compacted.pins(he).second),
+                ContainerEq(std::vector<HypernodeID>(copy.pins(he).first, copy.pins(he).second)));
+  }
+}
+
+TEST_F(AHypergraph, RestoresItsOriginalIDsAndKeepsThePartitionOfTheCompactedHypergraph) {
+  Hypergraph original(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                      HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 });
+  for (Hypergraph* hg : { &hypergraph, &original }) {
+    hg->contract(1, 4);
+    hg->contract(0, 2);
+    hg->removeEdge(1);
+  }
+
+  {
+    CompactHypergraphView<Hypergraph> view(hypergraph);
+    for (const HypernodeID hn : view.hypergraph().nodes()) {
+      view.hypergraph().setNodePart(hn, hn % 2);
+      original.setNodePart(view.originalID(hn), hn % 2);
+    }
+  }
+  hypergraph.initializeNumCutHyperedges();
+  original.initializeNumCutHyperedges();
+
+  ASSERT_THAT(verifyEquivalenceWithPartitionInfo(original, hypergraph), Eq(true));
+  for (const HyperedgeID he : original.edges()) {
+    ASSERT_THAT(hypergraph.edgeHash(he), Eq(original.edgeHash(he)));
+  }
+}
+
 TEST_F(APartitionedHypergraph, CanBeResetToUnpartitionedState) {
   hypergraph.resetPartitioning();
   ASSERT_THAT(verifyEquivalenceWithPartitionInfo(hypergraph, original_hypergraph), Eq(true));
 }
 
+TEST_F(APartitionedHypergraph, CanBeRestoredFromAPartitionSnapshot) {
+  Hypergraph::PartitionSnapshot snapshot;
+  hypergraph.createPartitionSnapshot(snapshot);
+  hypergraph.changeNodePart(0, 0, 1);
+  hypergraph.changeNodePart(5, 1, 0);
+  hypergraph.restorePartitionSnapshot(snapshot);
+
+  original_hypergraph.setNodePart(0, 0);
+  original_hypergraph.setNodePart(1, 0);
+  original_hypergraph.setNodePart(2, 1);
+  original_hypergraph.setNodePart(3, 0);
+  original_hypergraph.setNodePart(4, 0);
+  original_hypergraph.setNodePart(5, 1);
+  original_hypergraph.setNodePart(6, 1);
+  ASSERT_THAT(verifyEquivalenceWithPartitionInfo(hypergraph, original_hypergraph), Eq(true));
+}
+
+TEST_F(APartitionedHypergraph, CanBeRestoredFromASnapshotOfTheUnpartitionedState) {
+  Hypergraph::PartitionSnapshot snapshot;
+  original_hypergraph.createPartitionSnapshot(snapshot);
+  hypergraph.restorePartitionSnapshot(snapshot);
+  ASSERT_THAT(verifyEquivalenceWithPartitionInfo(hypergraph, original_hypergraph), Eq(true));
+}
+
 
 TEST_F(APartitionedHypergraph, IdentifiesBorderHypernodes) {
   hypergraph.initializeNumCutHyperedges();
@@ -806,6 +917,27 @@ TEST_F(APartitionedHypergraph, IdentifiesBorderHypernodes) {
   ASSERT_THAT(hypergraph.isBorderNode(6), Eq(true));
 }
 
+TEST_F(APartitionedHypergraph, MaintainsTheSetOfBorderHypernodes) {
+  hypergraph.initializeNumCutHyperedges();
+  std::vector<HypernodeID> border_nodes(hypergraph.borderNodes().begin(),
+                                        hypergraph.borderNodes().end());
+  std::sort(border_nodes.begin(), border_nodes.end());
+  ASSERT_THAT(border_nodes, ContainerEq(std::vector<HypernodeID>{ 0, 2, 3, 4, 6 }));
+
+  hypergraph.changeNodePart(6, 1, 0);
+  border_nodes.assign(hypergraph.borderNodes().begin(), hypergraph.borderNodes().end());
+  std::sort(border_nodes.begin(), border_nodes.end());
+  ASSERT_THAT(border_nodes, ContainerEq(std::vector<HypernodeID>{ 0, 2, 5, 6 }));
+
+  hypergraph.changeNodePart(2, 1, 0);
+  border_nodes.assign(hypergraph.borderNodes().begin(), hypergraph.borderNodes().end());
+  std::sort(border_nodes.begin(), border_nodes.end());
+  ASSERT_THAT(border_nodes, ContainerEq(std::vector<HypernodeID>{ 2, 5, 6 }));
+
+  hypergraph.resetPartitioning();
+  ASSERT_THAT(hypergraph.borderNodes().size(), Eq(0));
+}
+
 TEST_F(AHypergraph, SupportsIsolationOfHypernodes) {
   ASSERT_THAT(hypergraph.nodeDegree(0), Eq(2));
   ASSERT_THAT(hypergraph.edgeSize(0), Eq(2));
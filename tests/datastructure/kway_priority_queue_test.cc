@@ -20,246 +20,244 @@
 
 #include "gmock/gmock.h"
 
-#include "kahypar/datastructure/kway_priority_queue.h"
 #include "kahypar/definitions.h"
+#include "kahypar/partition/refinement/policies/gain_queue_policy.h"
 
 using::testing::Eq;
 using::testing::Test;
 
 namespace kahypar {
 namespace ds {
+template <typename GainQueue>
 class AKWayPriorityQueue : public Test {
  public:
   AKWayPriorityQueue() :
     prio_queue(4) {
-#ifdef USE_BUCKET_PQ
-    prio_queue.initialize(100, 200);
-#else
-    prio_queue.initialize(100);
-#endif
+    GainQueue::initialize(prio_queue, 100, 200);
   }
 
-  KWayPriorityQueue<HypernodeID, HyperedgeWeight,
-                    std::numeric_limits<HyperedgeWeight> > prio_queue;
+  typename GainQueue::template KWayPQ<false> prio_queue;
 };
 
-using AKWayPriorityQueueDeathTest = AKWayPriorityQueue;
+typedef::testing::Types<HeapGainQueue, BucketGainQueue> Implementations;
 
-TEST_F(AKWayPriorityQueue, IsEmptyIfItContainsNoElements) {
-  ASSERT_THAT(prio_queue.empty(), Eq(true));
+TYPED_TEST_CASE(AKWayPriorityQueue, Implementations);
+
+TYPED_TEST(AKWayPriorityQueue, IsEmptyIfItContainsNoElements) {
+  ASSERT_THAT(this->prio_queue.empty(), Eq(true));
 }
 
-TEST_F(AKWayPriorityQueue, IsEmptyIfNoInternalHeapsAreEnabled) {
-  prio_queue.insert(1, 2, 25);
-  ASSERT_THAT(prio_queue.empty(), Eq(true));
+TYPED_TEST(AKWayPriorityQueue, IsEmptyIfNoInternalHeapsAreEnabled) {
+  this->prio_queue.insert(1, 2, 25);
+  ASSERT_THAT(this->prio_queue.empty(), Eq(true));
 }
 
-TEST_F(AKWayPriorityQueue, IsNotEmptyIfThereExistsANonemptyAndEnabledInternalHeap) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.enablePart(2);
-  ASSERT_THAT(prio_queue.empty(), Eq(false));
+TYPED_TEST(AKWayPriorityQueue, IsNotEmptyIfThereExistsANonemptyAndEnabledInternalHeap) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.enablePart(2);
+  ASSERT_THAT(this->prio_queue.empty(), Eq(false));
 }
 
-TEST_F(AKWayPriorityQueue, MustEnableAnInternalHeapInOrderToConsiderItDuringDeleteMax) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.enablePart(2);
+TYPED_TEST(AKWayPriorityQueue, MustEnableAnInternalHeapInOrderToConsiderItDuringDeleteMax) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.enablePart(2);
   HypernodeID max_id = -1;
   HyperedgeWeight max_gain = -1;
   PartitionID max_part = -1;
 
-  prio_queue.deleteMax(max_id, max_gain, max_part);
+  this->prio_queue.deleteMax(max_id, max_gain, max_part);
 
   ASSERT_THAT(max_id, Eq(1));
   ASSERT_THAT(max_gain, Eq(25));
   ASSERT_THAT(max_part, Eq(2));
 }
 
-TEST_F(AKWayPriorityQueue, MustEnableAnInternalHeapInOrderToConsiderItDuringDeleteMaxFromPartition) {
-  prio_queue.insert(0, 1, 20);
-  prio_queue.enablePart(1);
-  prio_queue.insert(1, 2, 25);
-  prio_queue.enablePart(2);
+TYPED_TEST(AKWayPriorityQueue, MustEnableAnInternalHeapInOrderToConsiderItDuringDeleteMaxFromPartition) {
+  this->prio_queue.insert(0, 1, 20);
+  this->prio_queue.enablePart(1);
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.enablePart(2);
   HypernodeID max_id = -1;
   HyperedgeWeight max_gain = -1;
   PartitionID part = 2;
 
-  prio_queue.deleteMaxFromPartition(max_id, max_gain, part);
+  this->prio_queue.deleteMaxFromPartition(max_id, max_gain, part);
 
   ASSERT_THAT(max_id, Eq(1));
   ASSERT_THAT(max_gain, Eq(25));
 }
 
-TEST_F(AKWayPriorityQueue, IsEmptyIfLastEnabledInternalHeapBecomesEmpty) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.enablePart(2);
+TYPED_TEST(AKWayPriorityQueue, IsEmptyIfLastEnabledInternalHeapBecomesEmpty) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.enablePart(2);
   HypernodeID max_id = -1;
   HyperedgeWeight max_gain = -1;
   PartitionID max_part = -1;
 
-  prio_queue.deleteMax(max_id, max_gain, max_part);
+  this->prio_queue.deleteMax(max_id, max_gain, max_part);
 
-  ASSERT_THAT(prio_queue.empty(), Eq(true));
+  ASSERT_THAT(this->prio_queue.empty(), Eq(true));
 }
 
-TEST_F(AKWayPriorityQueue, PQIsUnusedAndDisableIfItBecomesEmptyAfterDeleteMaxFromPartition) {
-  prio_queue.insert(0, 1, 20);
-  prio_queue.enablePart(1);
-  prio_queue.insert(1, 2, 25);
-  prio_queue.enablePart(2);
+TYPED_TEST(AKWayPriorityQueue, PQIsUnusedAndDisableIfItBecomesEmptyAfterDeleteMaxFromPartition) {
+  this->prio_queue.insert(0, 1, 20);
+  this->prio_queue.enablePart(1);
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.enablePart(2);
   HypernodeID max_id = -1;
   HyperedgeWeight max_gain = -1;
   PartitionID part = 2;
 
-  prio_queue.deleteMaxFromPartition(max_id, max_gain, part);
+  this->prio_queue.deleteMaxFromPartition(max_id, max_gain, part);
 
-  ASSERT_FALSE(prio_queue.contains(1, 2));
-  ASSERT_TRUE(prio_queue.empty(2));
-  ASSERT_FALSE(prio_queue.isEnabled(2));
-  ASSERT_TRUE(prio_queue.isUnused(2));
+  ASSERT_FALSE(this->prio_queue.contains(1, 2));
+  ASSERT_TRUE(this->prio_queue.empty(2));
+  ASSERT_FALSE(this->prio_queue.isEnabled(2));
+  ASSERT_TRUE(this->prio_queue.isUnused(2));
 }
 
-TEST_F(AKWayPriorityQueue, IsEmptyIfLastEnabledInternalHeapBecomesDisabled) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.enablePart(2);
+TYPED_TEST(AKWayPriorityQueue, IsEmptyIfLastEnabledInternalHeapBecomesDisabled) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.enablePart(2);
 
-  prio_queue.disablePart(2);
+  this->prio_queue.disablePart(2);
 
-  ASSERT_THAT(prio_queue.empty(), Eq(true));
+  ASSERT_THAT(this->prio_queue.empty(), Eq(true));
 }
 
-TEST_F(AKWayPriorityQueue, ChoosesMaxKeyAmongAllEnabledInternalHeaps) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.insert(4, 1, 6);
-  prio_queue.insert(0, 3, 42);
-  prio_queue.insert(3, 0, 23);
+TYPED_TEST(AKWayPriorityQueue, ChoosesMaxKeyAmongAllEnabledInternalHeaps) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.insert(4, 1, 6);
+  this->prio_queue.insert(0, 3, 42);
+  this->prio_queue.insert(3, 0, 23);
 
-  prio_queue.enablePart(1);
-  ASSERT_THAT(prio_queue.max(), Eq(4));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(6));
+  this->prio_queue.enablePart(1);
+  ASSERT_THAT(this->prio_queue.max(), Eq(4));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(6));
 
-  prio_queue.enablePart(2);
-  ASSERT_THAT(prio_queue.max(), Eq(1));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(25));
+  this->prio_queue.enablePart(2);
+  ASSERT_THAT(this->prio_queue.max(), Eq(1));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(25));
 
-  prio_queue.enablePart(3);
-  ASSERT_THAT(prio_queue.max(), Eq(0));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(42));
+  this->prio_queue.enablePart(3);
+  ASSERT_THAT(this->prio_queue.max(), Eq(0));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(42));
 
-  prio_queue.enablePart(0);
-  ASSERT_THAT(prio_queue.max(), Eq(0));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(42));
+  this->prio_queue.enablePart(0);
+  ASSERT_THAT(this->prio_queue.max(), Eq(0));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(42));
 }
 
-TEST_F(AKWayPriorityQueue, DoesNotConsiderDisabledHeapForChoosingMax) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.insert(4, 1, 6);
-  prio_queue.insert(0, 3, 42);
-  prio_queue.insert(3, 0, 23);
-  prio_queue.enablePart(0);
-  prio_queue.enablePart(1);
-  prio_queue.enablePart(2);
-  prio_queue.enablePart(3);
-  ASSERT_THAT(prio_queue.max(), Eq(0));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(42));
-
-  prio_queue.disablePart(3);
-  ASSERT_THAT(prio_queue.isEnabled(3), Eq(false));
-  ASSERT_THAT(prio_queue.max(), Eq(1));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(25));
+TYPED_TEST(AKWayPriorityQueue, DoesNotConsiderDisabledHeapForChoosingMax) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.insert(4, 1, 6);
+  this->prio_queue.insert(0, 3, 42);
+  this->prio_queue.insert(3, 0, 23);
+  this->prio_queue.enablePart(0);
+  this->prio_queue.enablePart(1);
+  this->prio_queue.enablePart(2);
+  this->prio_queue.enablePart(3);
+  ASSERT_THAT(this->prio_queue.max(), Eq(0));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(42));
+
+  this->prio_queue.disablePart(3);
+  ASSERT_THAT(this->prio_queue.isEnabled(3), Eq(false));
+  ASSERT_THAT(this->prio_queue.max(), Eq(1));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(25));
 }
 
-TEST_F(AKWayPriorityQueue, ReconsidersDisabledHeapAgainAfterEnabling) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.insert(4, 1, 6);
-  prio_queue.insert(0, 3, 42);
-  prio_queue.insert(3, 0, 23);
-  prio_queue.enablePart(0);
-  prio_queue.enablePart(1);
-  prio_queue.enablePart(2);
-  prio_queue.enablePart(3);
-  ASSERT_THAT(prio_queue.max(), Eq(0));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(42));
-  prio_queue.disablePart(3);
-  ASSERT_THAT(prio_queue.max(), Eq(1));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(25));
-
-  prio_queue.enablePart(3);
-  ASSERT_THAT(prio_queue.max(), Eq(0));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(42));
+TYPED_TEST(AKWayPriorityQueue, ReconsidersDisabledHeapAgainAfterEnabling) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.insert(4, 1, 6);
+  this->prio_queue.insert(0, 3, 42);
+  this->prio_queue.insert(3, 0, 23);
+  this->prio_queue.enablePart(0);
+  this->prio_queue.enablePart(1);
+  this->prio_queue.enablePart(2);
+  this->prio_queue.enablePart(3);
+  ASSERT_THAT(this->prio_queue.max(), Eq(0));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(42));
+  this->prio_queue.disablePart(3);
+  ASSERT_THAT(this->prio_queue.max(), Eq(1));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(25));
+
+  this->prio_queue.enablePart(3);
+  ASSERT_THAT(this->prio_queue.max(), Eq(0));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(42));
 }
 
-TEST_F(AKWayPriorityQueue, DisablesInternalHeapIfItBecomesEmptyDueToRemoval) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.insert(0, 3, 42);
-  prio_queue.enablePart(2);
-  prio_queue.enablePart(3);
-  ASSERT_THAT(prio_queue.max(), Eq(0));
-  ASSERT_THAT(prio_queue.maxKey(), Eq(42));
+TYPED_TEST(AKWayPriorityQueue, DisablesInternalHeapIfItBecomesEmptyDueToRemoval) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.insert(0, 3, 42);
+  this->prio_queue.enablePart(2);
+  this->prio_queue.enablePart(3);
+  ASSERT_THAT(this->prio_queue.max(), Eq(0));
+  ASSERT_THAT(this->prio_queue.maxKey(), Eq(42));
 
-  prio_queue.remove(0, 3);
-  ASSERT_THAT(prio_queue.isEnabled(3), Eq(false));
+  this->prio_queue.remove(0, 3);
+  ASSERT_THAT(this->prio_queue.isEnabled(3), Eq(false));
 }
 
-TEST_F(AKWayPriorityQueue, ReturnsFalseIfUnusedHeapIsEmpty) {
-  prio_queue.insert(1, 2, 25);
-  ASSERT_THAT(prio_queue.empty(0), Eq(true));
+TYPED_TEST(AKWayPriorityQueue, ReturnsFalseIfUnusedHeapIsEmpty) {
+  this->prio_queue.insert(1, 2, 25);
+  ASSERT_THAT(this->prio_queue.empty(0), Eq(true));
 }
 
-TEST_F(AKWayPriorityQueue, ReturnsSizeZeroForUnusedInternalHeaps) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.insert(0, 0, 42);
-  ASSERT_THAT(prio_queue.size(3), Eq(0));
+TYPED_TEST(AKWayPriorityQueue, ReturnsSizeZeroForUnusedInternalHeaps) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.insert(0, 0, 42);
+  ASSERT_THAT(this->prio_queue.size(3), Eq(0));
 }
 
-TEST_F(AKWayPriorityQueue, ReturnsCorrectSizeForUsedInternalHeaps) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.insert(2, 2, 23);
-  prio_queue.insert(0, 0, 42);
-  ASSERT_THAT(prio_queue.size(2), Eq(2));
-  ASSERT_THAT(prio_queue.size(0), Eq(1));
+TYPED_TEST(AKWayPriorityQueue, ReturnsCorrectSizeForUsedInternalHeaps) {
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.insert(2, 2, 23);
+  this->prio_queue.insert(0, 0, 42);
+  ASSERT_THAT(this->prio_queue.size(2), Eq(2));
+  ASSERT_THAT(this->prio_queue.size(0), Eq(1));
 }
 
-TEST_F(AKWayPriorityQueue, AnswersContainmentChecksForAllNonEmptyPQs) {
-  prio_queue.insert(1, 2, 25);
+TYPED_TEST(AKWayPriorityQueue, AnswersContainmentChecksForAllNonEmptyPQs) {
+  this->prio_queue.insert(1, 2, 25);
   // disabled part
-  ASSERT_THAT(prio_queue.contains(1, 2), Eq(true));
+  ASSERT_THAT(this->prio_queue.contains(1, 2), Eq(true));
 
-  prio_queue.insert(0, 0, 1);
-  prio_queue.enablePart(0);
+  this->prio_queue.insert(0, 0, 1);
+  this->prio_queue.enablePart(0);
   // enabled part
-  ASSERT_THAT(prio_queue.contains(0, 0), Eq(true));
+  ASSERT_THAT(this->prio_queue.contains(0, 0), Eq(true));
 
   // unused part
-  ASSERT_THAT(prio_queue.contains(1, 1), Eq(false));
+  ASSERT_THAT(this->prio_queue.contains(1, 1), Eq(false));
 }
 
-TEST_F(AKWayPriorityQueue, ReturnsNumberOfEnabledParts) {
-  ASSERT_THAT(prio_queue.numEnabledParts(), Eq(0));
-  prio_queue.insert(1, 2, 25);
-  prio_queue.enablePart(2);
-  ASSERT_THAT(prio_queue.numEnabledParts(), Eq(1));
+TYPED_TEST(AKWayPriorityQueue, ReturnsNumberOfEnabledParts) {
+  ASSERT_THAT(this->prio_queue.numEnabledParts(), Eq(0));
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.enablePart(2);
+  ASSERT_THAT(this->prio_queue.numEnabledParts(), Eq(1));
 }
 
-TEST_F(AKWayPriorityQueue, EnsuresThatEmptyPartsCannotBeEnabled) {
-  prio_queue.enablePart(2);
-  ASSERT_THAT(prio_queue.numEnabledParts(), Eq(0));
+TYPED_TEST(AKWayPriorityQueue, EnsuresThatEmptyPartsCannotBeEnabled) {
+  this->prio_queue.enablePart(2);
+  ASSERT_THAT(this->prio_queue.numEnabledParts(), Eq(0));
 }
 
-TEST_F(AKWayPriorityQueue, ReturnsNumberOfNonEmptyParts) {
-  ASSERT_THAT(prio_queue.numNonEmptyParts(), Eq(0));
-  prio_queue.insert(1, 2, 25);
-  ASSERT_THAT(prio_queue.numNonEmptyParts(), Eq(1));
+TYPED_TEST(AKWayPriorityQueue, ReturnsNumberOfNonEmptyParts) {
+  ASSERT_THAT(this->prio_queue.numNonEmptyParts(), Eq(0));
+  this->prio_queue.insert(1, 2, 25);
+  ASSERT_THAT(this->prio_queue.numNonEmptyParts(), Eq(1));
 }
 
-TEST_F(AKWayPriorityQueue,
+TYPED_TEST(AKWayPriorityQueue,
        DoesNotDecreaseTheNumberOfEnabledHeapsIfTheLastElementOfADisabledHeapIsRemoved) {
-  prio_queue.insert(1, 2, 25);
-  prio_queue.insert(0, 3, 23);
-  prio_queue.enablePart(2);
+  this->prio_queue.insert(1, 2, 25);
+  this->prio_queue.insert(0, 3, 23);
+  this->prio_queue.enablePart(2);
 
-  prio_queue.remove(0, 3);
+  this->prio_queue.remove(0, 3);
 
-  ASSERT_THAT(prio_queue.numEnabledParts(), Eq(1));
+  ASSERT_THAT(this->prio_queue.numEnabledParts(), Eq(1));
 }
 }  // namespace ds
 }  // namespace kahypar
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/datastructure/pin_counts_in_part.h"
+#include "kahypar/definitions.h"
+
+using ::testing::Eq;
+using ::testing::Test;
+
+namespace kahypar {
+namespace ds {
+using PinCounts = PinCountsInPart<HypernodeID, HyperedgeID, PartitionID>;
+
+class PinCountsWithMixedWidths : public Test {
+ public:
+  static constexpr PartitionID kNumParts = 16;
+
+  PinCountsWithMixedWidths() :
+    edge_sizes({ 2, 300, 70000, 100 }),
+    pin_counts() {
+    pin_counts.initialize(edge_sizes.size(), kNumParts, [&](const HyperedgeID he) {
+        return edge_sizes[he];
+      }, true);
+  }
+
+  std::vector<HypernodeID> edge_sizes;
+  PinCounts pin_counts;
+};
+
+TEST_F(PinCountsWithMixedWidths, AreInitializedWithZero) {
+  for (HyperedgeID he = 0; he < edge_sizes.size(); ++he) {
+    for (PartitionID part = 0; part < kNumParts; ++part) {
+      ASSERT_THAT(pin_counts.get(he, part), Eq(0));
+    }
+  }
+}
+
+TEST_F(PinCountsWithMixedWidths, CountUpToTheEdgeSizeOfEachHyperedge) {
+  for (HyperedgeID he = 0; he < edge_sizes.size(); ++he) {
+    for (HypernodeID i = 0; i < edge_sizes[he]; ++i) {
+      pin_counts.increment(he, 2);
+    }
+    pin_counts.increment(he, 3);
+  }
+  for (HyperedgeID he = 0; he < edge_sizes.size(); ++he) {
+    ASSERT_THAT(pin_counts.get(he, 0), Eq(0));
+    ASSERT_THAT(pin_counts.get(he, 1), Eq(0));
+    ASSERT_THAT(pin_counts.get(he, 2), Eq(edge_sizes[he]));
+    ASSERT_THAT(pin_counts.get(he, 3), Eq(1));
+  }
+  ASSERT_THAT(pin_counts.decrement(1, 2), Eq(299));
+  ASSERT_THAT(pin_counts.get(1, 2), Eq(299));
+}
+
+TEST_F(PinCountsWithMixedWidths, InvalidateAndResetSingleHyperedges) {
+  pin_counts.increment(0, 1);
+  pin_counts.increment(1, 1);
+  pin_counts.increment(2, 1);
+  pin_counts.invalidate(1);
+
+  ASSERT_THAT(pin_counts.get(0, 1), Eq(1));
+  ASSERT_THAT(pin_counts.get(2, 1), Eq(1));
+  for (PartitionID part = 0; part < kNumParts; ++part) {
+    ASSERT_THAT(pin_counts.isValid(1, part), Eq(false));
+    ASSERT_THAT(pin_counts.value(1, part), Eq(PinCounts::kInvalidCount));
+  }
+
+  pin_counts.reset(1);
+  for (PartitionID part = 0; part < kNumParts; ++part) {
+    ASSERT_THAT(pin_counts.isValid(1, part), Eq(true));
+    ASSERT_THAT(pin_counts.get(1, part), Eq(0));
+  }
+}
+
+TEST_F(PinCountsWithMixedWidths, UseLessMemoryThanOneHypernodeIDPerCounter) {
+  ASSERT_THAT(pin_counts.size(), Eq(4 * 16));
+  ASSERT_THAT(pin_counts.sizeInBytes() < 4 * 16 * sizeof(HypernodeID), Eq(true));
+}
+
+TEST(PinCounts, UseOneByteCountersIfAllHyperedgesAreSmall) {
+  PinCounts pin_counts;
+  pin_counts.initialize(1000, 32, [](const HyperedgeID) {
+      return 10;
+    }, true);
+  ASSERT_THAT(pin_counts.sizeInBytes(), Eq(1000 * 32));
+}
+
+TEST(PinCounts, UseTheCompactLayoutOnlyForLargeK) {
+  PinCounts pin_counts;
+  pin_counts.initialize(1000, PinCounts::kCompactLayoutMinK - 1, [](const HyperedgeID) {
+      return 10;
+    });
+  ASSERT_THAT(pin_counts.isCompact(), Eq(false));
+  ASSERT_THAT(pin_counts.sizeInBytes(),
+              Eq(1000 * (PinCounts::kCompactLayoutMinK - 1) * sizeof(HypernodeID)));
+
+  pin_counts.initialize(1000, PinCounts::kCompactLayoutMinK, [](const HyperedgeID) {
+      return 10;
+    });
+  ASSERT_THAT(pin_counts.isCompact(), Eq(true));
+  ASSERT_THAT(pin_counts.sizeInBytes(), Eq(1000 * PinCounts::kCompactLayoutMinK));
+}
+
+TEST(PinCounts, InvalidateAndResetSingleHyperedgesInTheDenseLayout) {
+  PinCounts pin_counts;
+  pin_counts.initialize(3, 4, [](const HyperedgeID) {
+      return 10;
+    }, false);
+  pin_counts.increment(0, 1);
+  pin_counts.increment(1, 1);
+  pin_counts.increment(2, 1);
+  ASSERT_THAT(pin_counts.decrement(2, 1), Eq(0));
+  pin_counts.invalidate(1);
+
+  ASSERT_THAT(pin_counts.get(0, 1), Eq(1));
+  for (PartitionID part = 0; part < 4; ++part) {
+    ASSERT_THAT(pin_counts.isValid(1, part), Eq(false));
+    ASSERT_THAT(pin_counts.value(1, part), Eq(PinCounts::kInvalidCount));
+  }
+
+  pin_counts.reset(1);
+  for (PartitionID part = 0; part < 4; ++part) {
+    ASSERT_THAT(pin_counts.isValid(1, part), Eq(true));
+    ASSERT_THAT(pin_counts.get(1, part), Eq(0));
+  }
+}
+
+TEST(PinCounts, AreEqualIfAllCountersAreEqualIndependentOfTheirWidth) {
+  PinCounts small;
+  PinCounts large;
+  small.initialize(2, 2, [](const HyperedgeID) {
+      return 10;
+    }, true);
+  large.initialize(2, 2, [](const HyperedgeID he) {
+      return he == 0 ? 10 : 1000;
+    }, false);
+  small.increment(1, 0);
+  large.increment(1, 0);
+  ASSERT_THAT(small == large, Eq(true));
+
+  small.invalidate(0);
+  large.invalidate(0);
+  ASSERT_THAT(small == large, Eq(true));
+
+  large.increment(1, 1);
+  ASSERT_THAT(small == large, Eq(false));
+}
+}  // namespace ds
+}  // namespace kahypar
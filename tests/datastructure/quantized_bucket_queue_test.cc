@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "kahypar/datastructure/quantized_bucket_queue.h"
+#include "kahypar/definitions.h"
+
+using::testing::Eq;
+using::testing::DoubleEq;
+using::testing::Test;
+
+namespace kahypar {
+namespace ds {
+using QueueType = QuantizedBucketMaxQueue<HypernodeID, RatingType>;
+
+class AQuantizedBucketQueue : public Test {
+ public:
+  AQuantizedBucketQueue() :
+    queue(20) { }
+
+  QueueType queue;
+};
+
+TEST_F(AQuantizedBucketQueue, IsEmptyWhenCreated) {
+  ASSERT_THAT(queue.empty(), Eq(true));
+}
+
+TEST_F(AQuantizedBucketQueue, HasSizeOneAfterOneInsertion) {
+  queue.push(0, 1.5);
+  ASSERT_THAT(queue.size(), Eq(1));
+  ASSERT_THAT(queue.contains(0), Eq(true));
+}
+
+TEST_F(AQuantizedBucketQueue, ReturnsTheMaximumElement) {
+  queue.push(0, 0.25);
+  queue.push(1, 4.0);
+  queue.push(2, 1.0);
+  ASSERT_THAT(queue.top(), Eq(1));
+  ASSERT_THAT(queue.topKey(), DoubleEq(4.0));
+}
+
+TEST_F(AQuantizedBucketQueue, ReturnsTheExactKeyOfAnElement) {
+  queue.push(0, 0.3333);
+  ASSERT_THAT(queue.getKey(0), DoubleEq(0.3333));
+}
+
+TEST_F(AQuantizedBucketQueue, PopsElementsInDecreasingBucketOrder) {
+  queue.push(0, 0.5);
+  queue.push(1, 8.0);
+  queue.push(2, 2.0);
+  queue.pop();
+  ASSERT_THAT(queue.top(), Eq(2));
+  queue.pop();
+  ASSERT_THAT(queue.top(), Eq(0));
+  queue.pop();
+  ASSERT_THAT(queue.empty(), Eq(true));
+}
+
+TEST_F(AQuantizedBucketQueue, BehavesAsExpectedOnUpdate) {
+  queue.push(0, 1.0);
+  queue.push(1, 2.0);
+  queue.updateKey(0, 16.0);
+  ASSERT_THAT(queue.top(), Eq(0));
+  queue.updateKey(0, 0.125);
+  ASSERT_THAT(queue.top(), Eq(1));
+  ASSERT_THAT(queue.getKey(0), DoubleEq(0.125));
+}
+
+TEST_F(AQuantizedBucketQueue, BehavesAsExpectedOnRemoval) {
+  queue.push(0, 1.0);
+  queue.push(1, 2.0);
+  queue.push(2, 2.0);
+  queue.remove(1);
+  ASSERT_THAT(queue.contains(1), Eq(false));
+  ASSERT_THAT(queue.top(), Eq(2));
+  queue.remove(2);
+  ASSERT_THAT(queue.top(), Eq(0));
+  ASSERT_THAT(queue.size(), Eq(1));
+}
+
+TEST_F(AQuantizedBucketQueue, IsEmptyAfterClear) {
+  queue.push(0, 1.0);
+  queue.push(1, 2.0);
+  queue.clear();
+  ASSERT_THAT(queue.empty(), Eq(true));
+  ASSERT_THAT(queue.contains(0), Eq(false));
+  ASSERT_THAT(queue.contains(1), Eq(false));
+  queue.push(1, 0.5);
+  ASSERT_THAT(queue.top(), Eq(1));
+}
+
+TEST_F(AQuantizedBucketQueue, ClampsKeysOutsideOfTheQuantizedRange) {
+  queue.push(0, 0.0);
+  queue.push(1, 1e-20);
+  queue.push(2, 1e20);
+  ASSERT_THAT(queue.top(), Eq(2));
+  ASSERT_THAT(QueueType::bucketOf(0.0), Eq(QueueType::bucketOf(1e-20)));
+  ASSERT_THAT(QueueType::bucketOf(1e20), Eq(QueueType::bucketOf(1e30)));
+}
+
+TEST_F(AQuantizedBucketQueue, MapsLargerKeysToHigherOrEqualBuckets) {
+  double key = 1e-12;
+  while (key < 1e12) {
+    ASSERT_THAT(QueueType::bucketOf(key) <= QueueType::bucketOf(key * 1.01), Eq(true));
+    key *= 1.01;
+  }
+  ASSERT_THAT(QueueType::bucketOf(1.0) < QueueType::bucketOf(1.25), Eq(true));
+}
+}  // namespace ds
+}  // namespace kahypar
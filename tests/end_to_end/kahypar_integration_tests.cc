@@ -193,4 +193,66 @@ TEST_F(KaHyParR, ComputesRecursiveBisectionKm1Partitioning) {
   ASSERT_EQ(metrics::soed(hypergraph), metrics::soed(verification_hypergraph));
   ASSERT_EQ(metrics::km1(hypergraph), metrics::km1(verification_hypergraph));
 }
+TEST_F(KaHyParR, ComputesTheSameParallelRecursiveBisectionPartitionForAnyNumberOfThreads) {
+  config.partition.k = 8;
+  config.partition.epsilon = 0.03;
+  config.partition.objective = Objective::km1;
+  config.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+
+  std::vector<std::vector<PartitionID> > partitions;
+  for (const unsigned int num_threads : { 2, 4 }) {
+    Configuration thread_config(config);
+    thread_config.partition.rb_num_threads = num_threads;
+    kahypar::Randomize::instance().setSeed(thread_config.partition.seed);
+
+    Hypergraph hypergraph(
+      kahypar::io::createHypergraphFromFile(thread_config.partition.graph_filename,
+                                            thread_config.partition.k));
+
+    Partitioner partitioner;
+    partitioner.partition(hypergraph, thread_config);
+
+    Hypergraph verification_hypergraph(
+      kahypar::io::createHypergraphFromFile(thread_config.partition.graph_filename,
+                                            thread_config.partition.k));
+
+    partitions.emplace_back();
+    for (const HypernodeID hn : hypergraph.nodes()) {
+      verification_hypergraph.setNodePart(hn, hypergraph.partID(hn));
+      partitions.back().push_back(hypergraph.partID(hn));
+    }
+
+    ASSERT_EQ(metrics::hyperedgeCut(hypergraph), metrics::hyperedgeCut(verification_hypergraph));
+    ASSERT_EQ(metrics::km1(hypergraph), metrics::km1(verification_hypergraph));
+    for (PartitionID part = 0; part < thread_config.partition.k; ++part) {
+      ASSERT_GT(hypergraph.partSize(part), 0);
+    }
+  }
+  ASSERT_EQ(partitions[0], partitions[1]);
+}
+
+TEST_F(KaHyParR, PutsAllHypernodesIntoTheSameBlockIfKIsOne) {
+  config.partition.k = 1;
+  config.partition.objective = Objective::km1;
+  config.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+
+  for (const unsigned int num_threads : { 1, 2 }) {
+    Configuration thread_config(config);
+    thread_config.partition.rb_num_threads = num_threads;
+    kahypar::Randomize::instance().setSeed(thread_config.partition.seed);
+
+    Hypergraph hypergraph(
+      kahypar::io::createHypergraphFromFile(thread_config.partition.graph_filename,
+                                            thread_config.partition.k));
+
+    Partitioner partitioner;
+    partitioner.partition(hypergraph, thread_config);
+
+    for (const HypernodeID hn : hypergraph.nodes()) {
+      ASSERT_EQ(hypergraph.partID(hn), 0);
+    }
+    ASSERT_EQ(metrics::hyperedgeCut(hypergraph), 0);
+    ASSERT_EQ(metrics::km1(hypergraph), 0);
+  }
+}
 }  // namespace kahypar
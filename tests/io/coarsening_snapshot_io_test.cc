@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/coarsening_snapshot_io.h"
+#include "kahypar/partition/coarsening/heavy_edge_rater.h"
+#include "kahypar/partition/coarsening/lazy_vertex_pair_coarsener.h"
+#include "kahypar/partition/coarsening/policies/rating_tie_breaking_policy.h"
+#include "kahypar/partition/refinement/do_nothing_refiner.h"
+
+using::testing::Eq;
+using::testing::Test;
+
+namespace kahypar {
+namespace io {
+using CoarsenerType = LazyVertexPairCoarsener<HeavyEdgeRater<RatingType, FirstRatingWins> >;
+
+class ACoarseningSnapshot : public Test {
+ public:
+  ACoarseningSnapshot() :
+    config(),
+    hypergraph(createHypergraph()),
+    coarsener(hypergraph, config,  /* heaviest_node_weight */ 1),
+    restored_hypergraph(createHypergraph()),
+    restored_coarsener(restored_hypergraph, config,  /* heaviest_node_weight */ 1),
+    refiner(),
+    filename("coarsening_snapshot_test.snapshot") {
+    config.partition.epsilon = 0.3;
+    config.partition.perfect_balance_part_weights[0] = ceil(7.0 / 2);
+    config.partition.perfect_balance_part_weights[1] = ceil(7.0 / 2);
+    config.partition.max_part_weights[0] = (1 + config.partition.epsilon)
+                                           * config.partition.perfect_balance_part_weights[0];
+    config.partition.max_part_weights[1] = (1 + config.partition.epsilon)
+                                           * config.partition.perfect_balance_part_weights[1];
+    config.coarsening.max_allowed_node_weight = 5;
+    config.coarsening.contraction_limit = 2;
+    refiner.initialize(999999);
+  }
+
+  ~ACoarseningSnapshot() {
+    std::remove(filename.c_str());
+  }
+
+  static Hypergraph createHypergraph() {
+    return Hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                      HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 });
+  }
+
+  void coarsenAndWriteSnapshot() {
+    const CoarseningSnapshotHeader header = createCoarseningSnapshotHeader(hypergraph, config);
+    coarsener.coarsen(config.coarsening.contraction_limit);
+    writeCoarseningSnapshot(filename, header, coarsener);
+  }
+
+  std::string readSnapshotFile() const {
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  void writeSnapshotFile(const std::string& content) const {
+    std::ofstream out(filename.c_str(), std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size());
+  }
+
+  Configuration config;
+  Hypergraph hypergraph;
+  CoarsenerType coarsener;
+  Hypergraph restored_hypergraph;
+  CoarsenerType restored_coarsener;
+  DoNothingRefiner refiner;
+  std::string filename;
+};
+
+TEST_F(ACoarseningSnapshot, RestoresTheCoarsestHypergraph) {
+  coarsenAndWriteSnapshot();
+
+  ASSERT_THAT(readCoarseningSnapshot(filename, restored_hypergraph, restored_coarsener, config),
+              Eq(CoarseningSnapshotStatus::restored));
+  ASSERT_THAT(restored_hypergraph.currentNumNodes(), Eq(hypergraph.currentNumNodes()));
+  ASSERT_THAT(ds::verifyEquivalenceWithoutPartitionInfo(hypergraph, restored_hypergraph),
+              Eq(true));
+}
+
+TEST_F(ACoarseningSnapshot, CanBeUncoarsenedLikeTheOriginalHierarchy) {
+  coarsenAndWriteSnapshot();
+  ASSERT_THAT(readCoarseningSnapshot(filename, restored_hypergraph, restored_coarsener, config),
+              Eq(CoarseningSnapshotStatus::restored));
+
+  PartitionID part = 0;
+  for (const HypernodeID hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, part);
+    restored_hypergraph.setNodePart(hn, part);
+    part = 1 - part;
+  }
+  hypergraph.initializeNumCutHyperedges();
+  restored_hypergraph.initializeNumCutHyperedges();
+
+  coarsener.uncoarsen(refiner);
+  restored_coarsener.uncoarsen(refiner);
+
+  ASSERT_THAT(restored_hypergraph.currentNumNodes(), Eq(7));
+  ASSERT_THAT(restored_hypergraph.currentNumEdges(), Eq(4));
+  ASSERT_THAT(ds::verifyEquivalenceWithPartitionInfo(hypergraph, restored_hypergraph), Eq(true));
+}
+
+TEST_F(ACoarseningSnapshot, IsRejectedIfTheCoarseningConfigurationDiffers) {
+  coarsenAndWriteSnapshot();
+  Configuration other_config(config);
+  other_config.coarsening.max_allowed_node_weight = 3;
+
+  ASSERT_THAT(readCoarseningSnapshot(filename, restored_hypergraph, restored_coarsener,
+                                     other_config), Eq(CoarseningSnapshotStatus::mismatch));
+  ASSERT_THAT(restored_hypergraph.currentNumNodes(), Eq(7));
+}
+
+TEST_F(ACoarseningSnapshot, IsRejectedIfTheHypergraphDiffers) {
+  coarsenAndWriteSnapshot();
+  Hypergraph other_hypergraph(7, 3, HyperedgeIndexVector { 0, 2, 6,  /*sentinel*/ 9 },
+                              HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6 });
+  CoarsenerType other_coarsener(other_hypergraph, config,  /* heaviest_node_weight */ 1);
+
+  ASSERT_THAT(readCoarseningSnapshot(filename, other_hypergraph, other_coarsener, config),
+              Eq(CoarseningSnapshotStatus::mismatch));
+  ASSERT_THAT(other_hypergraph.currentNumNodes(), Eq(7));
+}
+
+TEST_F(ACoarseningSnapshot, IsRejectedIfAHypergraphOfTheSameSizeDiffers) {
+  coarsenAndWriteSnapshot();
+  Hypergraph other_hypergraph(7, 4, HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+                              HyperedgeVector { 0, 1, 0, 2, 3, 4, 3, 4, 6, 2, 5, 6 });
+  CoarsenerType other_coarsener(other_hypergraph, config,  /* heaviest_node_weight */ 1);
+
+  ASSERT_THAT(readCoarseningSnapshot(filename, other_hypergraph, other_coarsener, config),
+              Eq(CoarseningSnapshotStatus::mismatch));
+  ASSERT_THAT(other_hypergraph.currentNumNodes(), Eq(7));
+}
+
+TEST_F(ACoarseningSnapshot, IsRejectedIfTheWeightsOfTheHypergraphDiffer) {
+  coarsenAndWriteSnapshot();
+  restored_hypergraph.setEdgeWeight(1, 2);
+
+  ASSERT_THAT(readCoarseningSnapshot(filename, restored_hypergraph, restored_coarsener, config),
+              Eq(CoarseningSnapshotStatus::mismatch));
+  ASSERT_THAT(restored_hypergraph.currentNumNodes(), Eq(7));
+}
+
+TEST_F(ACoarseningSnapshot, DoesNotModifyTheHypergraphIfTheFileIsTruncated) {
+  coarsenAndWriteSnapshot();
+  std::string content = readSnapshotFile();
+  content.resize(content.size() - 8);
+  writeSnapshotFile(content);
+
+  ASSERT_THAT(readCoarseningSnapshot(filename, restored_hypergraph, restored_coarsener, config),
+              Eq(CoarseningSnapshotStatus::corrupted));
+  ASSERT_THAT(restored_hypergraph.currentNumNodes(), Eq(7));
+  ASSERT_THAT(restored_hypergraph.currentNumPins(), Eq(12));
+}
+
+TEST_F(ACoarseningSnapshot, DoesNotModifyTheHypergraphIfTheFileIsDamaged) {
+  coarsenAndWriteSnapshot();
+  std::string content = readSnapshotFile();
+  content[content.size() - 1] ^= 0x1;
+  writeSnapshotFile(content);
+
+  ASSERT_THAT(readCoarseningSnapshot(filename, restored_hypergraph, restored_coarsener, config),
+              Eq(CoarseningSnapshotStatus::corrupted));
+  ASSERT_THAT(restored_hypergraph.currentNumNodes(), Eq(7));
+  ASSERT_THAT(restored_hypergraph.currentNumPins(), Eq(12));
+}
+
+TEST_F(ACoarseningSnapshot, IsNotReadIfTheFileDoesNotExist) {
+  ASSERT_THAT(readCoarseningSnapshot(filename, restored_hypergraph, restored_coarsener, config),
+              Eq(CoarseningSnapshotStatus::not_found));
+}
+}  // namespace io
+}  // namespace kahypar
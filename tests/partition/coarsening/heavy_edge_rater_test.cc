@@ -144,4 +144,34 @@ TEST_F(ARater, ReturnsInvalidRatingIfTargetNotIsNotInSamePartition) {
   ASSERT_THAT(rater.rate(0).value, Eq(std::numeric_limits<RatingType>::min()));
   ASSERT_THAT(rater.rate(0).valid, Eq(false));
 }
+
+TEST_F(ARater, RescalesScoresOfSampledHyperedges) {
+  hypergraph.reset(new Hypergraph(9, 1, HyperedgeIndexVector { 0, 9 },
+                                  HyperedgeVector { 0, 1, 2, 3, 4, 5, 6, 7, 8 }));
+  config.coarsening.rating_sample_size = 3;
+  FirstWinsRater rater(*hypergraph, config);
+
+  // w(e) / (|e| - 1) * |e| / sample_size
+  ASSERT_THAT(rater.rate(0).value, DoubleEq(1.0 / 8 * 9 / 3));
+  ASSERT_THAT(rater.rate(0).valid, Eq(true));
+}
+
+TEST_F(ARater, ChoosesTheSameSampleWhenRatingAHypernodeTwice) {
+  hypergraph.reset(new Hypergraph(9, 1, HyperedgeIndexVector { 0, 9 },
+                                  HyperedgeVector { 0, 1, 2, 3, 4, 5, 6, 7, 8 }));
+  config.coarsening.rating_sample_size = 3;
+  FirstWinsRater rater(*hypergraph, config);
+
+  const HypernodeID target = rater.rate(4).target;
+  ASSERT_THAT(rater.rate(4).target, Eq(target));
+}
+
+TEST_F(ARater, DoesNotSampleHyperedgesThatAreNotLargerThanTheSampleSize) {
+  hypergraph.reset(new Hypergraph(9, 1, HyperedgeIndexVector { 0, 9 },
+                                  HyperedgeVector { 0, 1, 2, 3, 4, 5, 6, 7, 8 }));
+  config.coarsening.rating_sample_size = 9;
+  FirstWinsRater rater(*hypergraph, config);
+
+  ASSERT_THAT(rater.rate(0).value, DoubleEq(1.0 / 8));
+}
 }  // namespace kahypar
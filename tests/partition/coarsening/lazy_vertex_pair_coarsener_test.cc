@@ -20,6 +20,7 @@
 
 #include "gmock/gmock.h"
 
+#include "kahypar/datastructure/quantized_bucket_queue.h"
 #include "kahypar/definitions.h"
 #include "kahypar/io/hypergraph_io.h"
 #include "kahypar/partition/coarsening/lazy_vertex_pair_coarsener.h"
@@ -29,6 +30,9 @@
 namespace kahypar {
 using FirstWinsRater = HeavyEdgeRater<RatingType, FirstRatingWins>;
 using CoarsenerType = LazyVertexPairCoarsener<FirstWinsRater>;
+using BucketQueueCoarsenerType = LazyVertexPairCoarsener<FirstWinsRater,
+                                                         ds::QuantizedBucketMaxQueue<HypernodeID,
+                                                                                     RatingType> >;
 
 class ACoarsener : public ACoarsenerBase<CoarsenerType>{
  public:
@@ -36,6 +40,12 @@ class ACoarsener : public ACoarsenerBase<CoarsenerType>{
     ACoarsenerBase() { }
 };
 
+class ABucketQueueCoarsener : public ACoarsenerBase<BucketQueueCoarsenerType>{
+ public:
+  explicit ABucketQueueCoarsener() :
+    ACoarsenerBase() { }
+};
+
 TEST_F(ACoarsener, RemovesHyperedgesOfSizeOneDuringCoarsening) {
   removesHyperedgesOfSizeOneDuringCoarsening(coarsener, hypergraph);
 }
@@ -67,6 +77,22 @@ TEST_F(ACoarsener, RestoresParallelHyperedgesDuringUncoarsening) {
   restoresParallelHyperedgesDuringUncoarsening(coarsener, hypergraph, refiner);
 }
 
+TEST_F(ACoarsener, RemovesParallelHyperedgesOncePerPassIfDetectionIsBatched) {
+  config.coarsening.batch_parallel_net_detection = true;
+  removesParallelHyperedgesDuringCoarsening(coarsener, hypergraph);
+  ASSERT_THAT(hypergraph->currentNumEdges(), Eq(1));
+  ASSERT_THAT(hypergraph->currentNumPins(), Eq(2));
+}
+
+TEST_F(ACoarsener, RestoresBatchedParallelHyperedgesDuringUncoarsening) {
+  config.coarsening.batch_parallel_net_detection = true;
+  restoresParallelHyperedgesDuringUncoarsening(coarsener, hypergraph, refiner);
+}
+
+TEST_F(ACoarsener, UncoarsensInBatchesUsingTwoWayFM) {
+  uncoarsensInBatchesUsingTwoWayFM(coarsener, hypergraph, config);
+}
+
 TEST(AnUncoarseningOperation, RestoresParallelHyperedgesInReverseOrder) {
   restoresParallelHyperedgesInReverseOrder<CoarsenerType>();
 }
@@ -95,4 +121,16 @@ TEST(ALazyUpdateCoarsener, InvalidatesAdjacentHypernodesInsteadOfReratingThem) {
   ASSERT_THAT(coarsener._outdated_rating[3], Eq(true));
   ASSERT_THAT(coarsener._outdated_rating[4], Eq(true));
 }
+
+TEST_F(ABucketQueueCoarsener, RemovesParallelHyperedgesDuringCoarsening) {
+  removesParallelHyperedgesDuringCoarsening(coarsener, hypergraph);
+}
+
+TEST_F(ABucketQueueCoarsener, RestoresParallelHyperedgesDuringUncoarsening) {
+  restoresParallelHyperedgesDuringUncoarsening(coarsener, hypergraph, refiner);
+}
+
+TEST_F(ABucketQueueCoarsener, DoesNotCoarsenUntilCoarseningLimit) {
+  doesNotCoarsenUntilCoarseningLimit(coarsener, hypergraph, config);
+}
 }  // namespace kahypar
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/coarsening/i_coarsener.h"
+#include "kahypar/partition/coarsening/vertex_pair_coarsener_base.h"
+
+// Like kahypar.h, the ML coarsener has to be included after its base classes.
+#include "kahypar/partition/coarsening/ml_coarsener.h"
+#include "kahypar/partition/refinement/do_nothing_refiner.h"
+
+using::testing::Eq;
+using::testing::Test;
+
+namespace kahypar {
+class AStarHypergraph : public Test {
+ public:
+  // Hypernode 0 is the center, hypernodes 1-8 are connected to the center via graph edges.
+  AStarHypergraph() :
+    config(),
+    hypergraph(9, 8, HyperedgeIndexVector { 0, 2, 4, 6, 8, 10, 12, 14,  /*sentinel*/ 16 },
+               HyperedgeVector { 0, 1, 0, 2, 0, 3, 0, 4, 0, 5, 0, 6, 0, 7, 0, 8 }) {
+    config.coarsening.max_allowed_node_weight = 2;
+  }
+
+  Configuration config;
+  Hypergraph hypergraph;
+};
+
+TEST_F(AStarHypergraph, StallsIfOnlyHeavyEdgeMatchingIsUsed) {
+  MLCoarsener coarsener(hypergraph, config,  /* heaviest_node_weight */ 1);
+  coarsener.coarsen(1);
+  // Only one leaf can be contracted with the center.
+  ASSERT_THAT(hypergraph.currentNumNodes(), Eq(8));
+}
+
+TEST_F(AStarHypergraph, ContractsLeavesSharingTheCenterIfTwoHopContractionIsEnabled) {
+  config.coarsening.two_hop_contraction = true;
+  MLCoarsener coarsener(hypergraph, config,  /* heaviest_node_weight */ 1);
+  coarsener.coarsen(1);
+  // The remaining seven leaves are contracted pairwise.
+  ASSERT_THAT(hypergraph.currentNumNodes(), Eq(5));
+  for (const HypernodeID hn : hypergraph.nodes()) {
+    ASSERT_THAT(hypergraph.nodeWeight(hn) <= 2, Eq(true));
+  }
+}
+
+TEST_F(AStarHypergraph, CanBeUncoarsenedAfterTwoHopContractions) {
+  config.coarsening.two_hop_contraction = true;
+  config.partition.k = 2;
+  config.partition.epsilon = 1.0;
+  config.partition.perfect_balance_part_weights[0] = 5;
+  config.partition.perfect_balance_part_weights[1] = 5;
+  config.partition.max_part_weights[0] = 10;
+  config.partition.max_part_weights[1] = 10;
+  MLCoarsener coarsener(hypergraph, config,  /* heaviest_node_weight */ 1);
+  coarsener.coarsen(1);
+  for (const HypernodeID hn : hypergraph.nodes()) {
+    hypergraph.setNodePart(hn, 0);
+  }
+  hypergraph.initializeNumCutHyperedges();
+
+  DoNothingRefiner refiner;
+  refiner.initialize(0);
+  coarsener.uncoarsen(refiner);
+  ASSERT_THAT(hypergraph.currentNumNodes(), Eq(9));
+  ASSERT_THAT(hypergraph.currentNumEdges(), Eq(8));
+}
+}  // namespace kahypar
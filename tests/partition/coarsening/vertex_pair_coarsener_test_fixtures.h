@@ -28,8 +28,12 @@
 
 #include "kahypar/definitions.h"
 #include "kahypar/partition/configuration.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/2way_fm_refiner.h"
 #include "kahypar/partition/refinement/do_nothing_refiner.h"
 #include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/partition/refinement/policies/2fm_rebalancing_policy.h"
+#include "kahypar/partition/refinement/policies/fm_stop_policy.h"
 
 using::testing::AnyOf;
 using::testing::DoubleEq;
@@ -176,6 +180,38 @@ void restoresParallelHyperedgesDuringUncoarsening(Coarsener& coarsener, Hypergra
   ASSERT_THAT(hypergraph->edgeWeight(3), Eq(1));
 }
 
+template <class Coarsener, class HypergraphT, class Config>
+void uncoarsensInBatchesUsingTwoWayFM(Coarsener& coarsener, HypergraphT& hypergraph,
+                                      Config& config) {
+  config.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+  config.local_search.uncontraction_batch_size = 3;
+  config.local_search.fm.max_number_of_fruitless_moves = 50;
+  coarsener.coarsen(2);
+  // Lazy-Update Coarsener coarsens slightly differently, thus we have to distinguish this case.
+  if (hypergraph->nodeIsEnabled(1)) {
+    hypergraph->setNodePart(1, 0);
+  } else {
+    ASSERT_THAT(hypergraph->nodeIsEnabled(5), Eq(true));
+    hypergraph->setNodePart(5, 0);
+  }
+  if (hypergraph->nodeIsEnabled(3)) {
+    hypergraph->setNodePart(3, 1);
+  } else {
+    ASSERT_THAT(hypergraph->nodeIsEnabled(4), Eq(true));
+    hypergraph->setNodePart(4, 1);
+  }
+  hypergraph->initializeNumCutHyperedges();
+
+  std::unique_ptr<IRefiner> refiner(
+    new TwoWayFMRefiner<NumberOfFruitlessMovesStopsSearch, GlobalRebalancing>(*hypergraph, config));
+  coarsener.uncoarsen(*refiner);
+  ASSERT_THAT(hypergraph->currentNumNodes(), Eq(7));
+  ASSERT_THAT(hypergraph->currentNumEdges(), Eq(4));
+  ASSERT_THAT(hypergraph->edgeSize(1), Eq(4));
+  ASSERT_THAT(hypergraph->edgeSize(3), Eq(3));
+  ASSERT_THAT(metrics::imbalance(*hypergraph, config), Le(config.partition.epsilon));
+}
+
 template <class CoarsenerType>
 void restoresParallelHyperedgesInReverseOrder() {
   // Artificially constructed hypergraph that enforces the successive removal of
@@ -196,6 +196,15 @@ TEST_F(AGainComputationPolicy, ComputesCorrectMaxPinDeltaGains) {
   ASSERT_EQ(pq.key(6, 0), 2);
 }
 
+TEST_F(AGainComputationPolicy, BoundsMaxPinGainsByTheWeightOfTheLargestNeighborhood) {
+  Hypergraph hypergraph(7, 3, HyperedgeIndexVector { 0, 2, 4,  /*sentinel*/ 8 },
+                        HyperedgeVector { 0, 1, 1, 2, 3, 4, 5, 6 });
+  hypergraph.setNodeWeight(6, 2);
+
+  ASSERT_EQ(MaxPinGainComputationPolicy::maxGain(hypergraph), 5);
+  ASSERT_LT(MaxPinGainComputationPolicy::maxGain(hypergraph), hypergraph.totalWeight());
+}
+
 TEST_F(AGainComputationPolicy, ComputesCorrectMaxNetGainGains) {
   pushAllHypernodesIntoQueue<MaxNetGainComputationPolicy>(true, false);
   ASSERT_EQ(MaxNetGainComputationPolicy::calculateGain(hypergraph, 0, 1, visit), 1);
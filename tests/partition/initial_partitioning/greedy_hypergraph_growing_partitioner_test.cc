@@ -35,6 +35,7 @@
 #include "kahypar/partition/initial_partitioning/policies/ip_greedy_queue_selection_policy.h"
 #include "kahypar/partition/initial_partitioning/policies/ip_start_node_selection_policy.h"
 #include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/policies/gain_queue_policy.h"
 
 using::testing::Eq;
 using::testing::Test;
@@ -74,11 +75,12 @@ void initializeConfiguration(Hypergraph& hg, Configuration& config,
 }
 
 template <typename StartNodeSelection, typename GainComputation,
-          typename QueueSelection>
+          typename QueueSelection, typename GainQueue = HeapGainQueue>
 struct GreedyTemplateStruct {
   typedef StartNodeSelection Type1;
   typedef GainComputation Type2;
   typedef QueueSelection Type3;
+  typedef GainQueue Type4;
 };
 
 template <class T>
@@ -107,12 +109,14 @@ class AKWayGreedyHypergraphGrowingPartitionerTest : public Test {
     initializeConfiguration(*hypergraph, config, k);
 
     ghg = std::make_shared<GreedyHypergraphGrowingInitialPartitioner<typename T::Type1,
-                                                                     typename T::Type2, typename T::Type3> >
+                                                                     typename T::Type2, typename T::Type3,
+                                                                     typename T::Type4> >
             (*hypergraph, config);
   }
 
   std::shared_ptr<GreedyHypergraphGrowingInitialPartitioner<typename T::Type1,
-                                                            typename T::Type2, typename T::Type3> > ghg;
+                                                            typename T::Type2, typename T::Type3,
+                                                            typename T::Type4> > ghg;
   std::shared_ptr<Hypergraph> hypergraph;
   Configuration config;
 };
@@ -135,7 +139,29 @@ typedef::testing::Types<
     GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
                          MaxNetGainComputationPolicy, RoundRobinQueueSelectionPolicy>,
     GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
-                         MaxNetGainComputationPolicy, SequentialQueueSelectionPolicy> > GreedyTestTemplates;
+                         MaxNetGainComputationPolicy, SequentialQueueSelectionPolicy>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         FMGainComputationPolicy, GlobalQueueSelectionPolicy, BucketGainQueue>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         FMGainComputationPolicy, RoundRobinQueueSelectionPolicy, BucketGainQueue>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         FMGainComputationPolicy, SequentialQueueSelectionPolicy, BucketGainQueue>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         MaxPinGainComputationPolicy, GlobalQueueSelectionPolicy, BucketGainQueue>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         MaxPinGainComputationPolicy, RoundRobinQueueSelectionPolicy,
+                         BucketGainQueue>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         MaxPinGainComputationPolicy, SequentialQueueSelectionPolicy,
+                         BucketGainQueue>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         MaxNetGainComputationPolicy, GlobalQueueSelectionPolicy, BucketGainQueue>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         MaxNetGainComputationPolicy, RoundRobinQueueSelectionPolicy,
+                         BucketGainQueue>,
+    GreedyTemplateStruct<BFSStartNodeSelectionPolicy<>,
+                         MaxNetGainComputationPolicy, SequentialQueueSelectionPolicy,
+                         BucketGainQueue> > GreedyTestTemplates;
 
 TYPED_TEST_CASE(AKWayGreedyHypergraphGrowingPartitionerTest,
                 GreedyTestTemplates);
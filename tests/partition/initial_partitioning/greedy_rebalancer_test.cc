@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/initial_partitioning/greedy_rebalancer.h"
+#include "kahypar/partition/initial_partitioning/policies/ip_gain_computation_policy.h"
+#include "kahypar/partition/metrics.h"
+
+using::testing::Eq;
+using::testing::Test;
+
+namespace kahypar {
+using Rebalancer = GreedyRebalancer<FMGainComputationPolicy>;
+
+class AGreedyRebalancer : public Test {
+ public:
+  AGreedyRebalancer() :
+    hypergraph(7, 4,
+               HyperedgeIndexVector { 0, 2, 6, 9,  /*sentinel*/ 12 },
+               HyperedgeVector { 0, 2, 0, 1, 3, 4, 3, 4, 6, 2, 5, 6 }),
+    config() {
+    config.partition.k = 2;
+    config.partition.max_part_weights[0] = 4;
+    config.partition.max_part_weights[1] = 4;
+    for (const HypernodeID hn : { 0, 1, 2, 3, 4, 5 }) {
+      hypergraph.setNodePart(hn, 0);
+    }
+    hypergraph.setNodePart(6, 1);
+  }
+
+  Hypergraph hypergraph;
+  Configuration config;
+};
+
+TEST_F(AGreedyRebalancer, RepairsTheBalanceOfAnOverloadedBlock) {
+  Rebalancer rebalancer(hypergraph, config);
+
+  ASSERT_THAT(rebalancer.rebalance(), Eq(true));
+  ASSERT_THAT(hypergraph.partWeight(0), Eq(4));
+  ASSERT_THAT(hypergraph.partWeight(1), Eq(3));
+}
+
+TEST_F(AGreedyRebalancer, MovesTheHypernodesWithTheLowestLossFirst) {
+  Rebalancer rebalancer(hypergraph, config);
+  rebalancer.rebalance();
+
+  ASSERT_THAT(hypergraph.partID(5), Eq(1));
+  ASSERT_THAT(hypergraph.partID(2), Eq(1));
+  ASSERT_THAT(metrics::hyperedgeCut(hypergraph), Eq(2));
+}
+
+TEST_F(AGreedyRebalancer, ReportsFailureIfTheBalanceCannotBeRepaired) {
+  config.partition.max_part_weights[0] = 3;
+  config.partition.max_part_weights[1] = 3;
+  Rebalancer rebalancer(hypergraph, config);
+
+  ASSERT_THAT(rebalancer.rebalance(), Eq(false));
+}
+}  // namespace kahypar
@@ -22,7 +22,9 @@
 
 #include "gmock/gmock.h"
 
+#include "kahypar/kahypar.h"
 #include "kahypar/partition/initial_partitioning/initial_partitioner_base.h"
+#include "kahypar/partition/initial_partitioning/refiner_pool.h"
 
 using::testing::Eq;
 using::testing::Test;
@@ -61,6 +63,22 @@ class InitialPartitionerBaseTest : public Test {
     }
   }
 
+  void bisectAndEnableRefinement() {
+    config.initial_partitioning.refinement = true;
+    config.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+    config.partition.perfect_balance_part_weights[0] =
+      config.initial_partitioning.perfect_balance_partition_weight[0];
+    config.partition.perfect_balance_part_weights[1] =
+      config.initial_partitioning.perfect_balance_partition_weight[1];
+    for (const HypernodeID hn : { 0, 1, 2, 3 }) {
+      hypergraph.setNodePart(hn, 0);
+    }
+    for (const HypernodeID hn : { 4, 5, 6 }) {
+      hypergraph.setNodePart(hn, 1);
+    }
+    hypergraph.initializeNumCutHyperedges();
+  }
+
   std::shared_ptr<InitialPartitionerBase> partitioner;
   Hypergraph hypergraph;
   Configuration config;
@@ -123,4 +141,51 @@ TEST_F(InitialPartitionerBaseTest, ResetPartitionToPartitionOne) {
     ASSERT_EQ(hypergraph.partID(hn), 0);
   }
 }
+
+TEST_F(InitialPartitionerBaseTest, ReusesTheRefinerOfPreviousFMRefinements) {
+  bisectAndEnableRefinement();
+  RefinerPool& pool = RefinerPool::instance();
+
+  partitioner->performFMRefinement();
+  ASSERT_THAT(pool.size(hypergraph, config), Eq(1));
+  std::unique_ptr<IRefiner> refiner = pool.borrow(config.local_search.algorithm, hypergraph,
+                                                  config);
+  const IRefiner* pooled_refiner = refiner.get();
+  pool.giveBack(config.local_search.algorithm, hypergraph, config, std::move(refiner));
+
+  partitioner->performFMRefinement();
+  ASSERT_THAT(pool.size(hypergraph, config), Eq(1));
+  refiner = pool.borrow(config.local_search.algorithm, hypergraph, config);
+  ASSERT_THAT(refiner.get(), Eq(pooled_refiner));
+}
+
+TEST_F(InitialPartitionerBaseTest, DoesNotReusePooledRefinersForOtherConfigurations) {
+  bisectAndEnableRefinement();
+  RefinerPool& pool = RefinerPool::instance();
+  partitioner->performFMRefinement();
+
+  Configuration other_config(config);
+  ASSERT_THAT(pool.size(hypergraph, other_config), Eq(0));
+  std::unique_ptr<IRefiner> refiner = pool.borrow(config.local_search.algorithm, hypergraph,
+                                                  other_config);
+  ASSERT_THAT(pool.size(hypergraph, config), Eq(1));
+}
+
+TEST_F(InitialPartitionerBaseTest, ReleasesPooledRefinersIfItIsTheLastInitialPartitioner) {
+  bisectAndEnableRefinement();
+
+  partitioner->performFMRefinement();
+  ASSERT_THAT(RefinerPool::instance().size(hypergraph, config), Eq(1));
+  partitioner.reset();
+  ASSERT_THAT(RefinerPool::instance().size(hypergraph, config), Eq(0));
+}
+
+TEST_F(InitialPartitionerBaseTest, KeepsPooledRefinersAsLongAsAnotherUserExists) {
+  bisectAndEnableRefinement();
+  InitialPartitionerBase other_partitioner(hypergraph, config);
+
+  partitioner->performFMRefinement();
+  partitioner.reset();
+  ASSERT_THAT(RefinerPool::instance().size(hypergraph, config), Eq(1));
+}
 }  // namespace kahypar
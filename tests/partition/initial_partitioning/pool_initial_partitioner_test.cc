@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/initial_partitioning/pool_initial_partitioner.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/utils/randomize.h"
+#include "kahypar/utils/stats.h"
+
+using::testing::Eq;
+using::testing::Test;
+
+namespace kahypar {
+class APoolInitialPartitioner : public Test {
+ public:
+  APoolInitialPartitioner() :
+    hypergraph(io::createHypergraphFromFile("test_instances/test_instance.hgr", 4)),
+    config() {
+    config.initial_partitioning.k = 4;
+    config.partition.k = 4;
+    config.initial_partitioning.epsilon = 0.05;
+    config.partition.epsilon = 0.05;
+    config.initial_partitioning.refinement = false;
+    const HypernodeWeight perfect_weight = ceil(hypergraph.totalWeight() / 4.0);
+    for (PartitionID i = 0; i < 4; ++i) {
+      config.initial_partitioning.perfect_balance_partition_weight.push_back(perfect_weight);
+      config.initial_partitioning.upper_allowed_partition_weight.push_back(
+        perfect_weight * (1.0 + config.initial_partitioning.epsilon));
+    }
+    config.partition.perfect_balance_part_weights[0] = perfect_weight;
+    config.partition.perfect_balance_part_weights[1] = perfect_weight;
+    config.partition.max_part_weights[0] =
+      config.initial_partitioning.upper_allowed_partition_weight[0];
+    config.partition.max_part_weights[1] =
+      config.initial_partitioning.upper_allowed_partition_weight[1];
+  }
+
+  std::vector<PartitionID> partitionWithThreads(const unsigned int num_threads) {
+    // The pool initial partitioner modifies its configuration.
+    Configuration pool_config(config);
+    pool_config.initial_partitioning.pool_num_threads = num_threads;
+    Randomize::instance().setSeed(42);
+    hypergraph.resetPartitioning();
+    PoolInitialPartitioner partitioner(hypergraph, pool_config);
+    partitioner.partition(hypergraph, pool_config);
+    std::vector<PartitionID> partition;
+    for (const HypernodeID hn : hypergraph.nodes()) {
+      partition.push_back(hypergraph.partID(hn));
+    }
+    return partition;
+  }
+
+  Hypergraph hypergraph;
+  Configuration config;
+};
+
+TEST_F(APoolInitialPartitioner, LeavesNoHypernodeUnassignedIfAlgorithmsRunInParallel) {
+  partitionWithThreads(4);
+
+  for (const HypernodeID hn : hypergraph.nodes()) {
+    ASSERT_NE(hypergraph.partID(hn), -1);
+  }
+}
+
+TEST_F(APoolInitialPartitioner, ComputesTheSamePartitionIndependentOfTheNumberOfThreads) {
+  const std::vector<PartitionID> two_threads = partitionWithThreads(2);
+  const HyperedgeWeight cut = metrics::hyperedgeCut(hypergraph);
+  const std::vector<PartitionID> eight_threads = partitionWithThreads(8);
+
+  ASSERT_THAT(eight_threads, Eq(two_threads));
+  ASSERT_THAT(metrics::hyperedgeCut(hypergraph), Eq(cut));
+}
+
+TEST_F(APoolInitialPartitioner, SpendsTheSameNumberOfRunsAsTheStaticPoolIfItIsAdaptive) {
+  // pool_type 1975 selects seven algorithms (the maxpin algorithms are skipped)
+  const std::vector<InitialPartitionerAlgorithm> algorithms = {
+    InitialPartitionerAlgorithm::greedy_round, InitialPartitionerAlgorithm::greedy_sequential,
+    InitialPartitionerAlgorithm::greedy_global_maxnet,
+    InitialPartitionerAlgorithm::greedy_round_maxnet, InitialPartitionerAlgorithm::lp,
+    InitialPartitionerAlgorithm::bfs, InitialPartitionerAlgorithm::random };
+  config.initial_partitioning.nruns = 4;
+  config.initial_partitioning.pool_adaptive = true;
+  config.initial_partitioning.pool_warmup_runs = 2;
+  config.partition.collect_stats = true;
+  config.partition.current_v_cycle = 42;
+
+  partitionWithThreads(1);
+
+  double total_runs = 0;
+  double max_runs = 0;
+  for (const InitialPartitionerAlgorithm algo : algorithms) {
+    const double runs = Stats::instance().get("v42_lk_0_uk_1_ipPoolRuns_" + toString(algo));
+    ASSERT_GE(runs, 2);
+    total_runs += runs;
+    max_runs = std::max(max_runs, runs);
+  }
+  ASSERT_THAT(total_runs, Eq(4 * algorithms.size()));
+  ASSERT_GT(max_runs, 4);
+  for (const HypernodeID hn : hypergraph.nodes()) {
+    ASSERT_NE(hypergraph.partID(hn), -1);
+  }
+}
+}  // namespace kahypar
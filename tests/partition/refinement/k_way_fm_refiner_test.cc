@@ -18,14 +18,23 @@
  *
 ******************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
 #include "gmock/gmock.h"
 
 #include "kahypar/definitions.h"
+#include "kahypar/partition/metrics.h"
 #include "kahypar/partition/refinement/kway_fm_cut_refiner.h"
+#include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/parallel_gain_cache_initialization.h"
 #include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+#include "kahypar/partition/refinement/policies/gain_queue_policy.h"
+#include "tests/partition/refinement/refiner_test_fixtures.h"
 
 using::testing::Test;
 using::testing::Eq;
+using::testing::ContainerEq;
 
 namespace kahypar {
 using KWayFMRefinerSimpleStopping = KWayFMRefiner<NumberOfFruitlessMovesStopsSearch>;
@@ -91,4 +100,46 @@ TEST_F(AKwayFMRefiner, KnowsIfAHyperedgeIsFullyActive) {
   refiner->fullUpdate(0, 0, 1, 0);
   ASSERT_THAT(refiner->_he_fully_active[0], Eq(true));
 }
+
+class AKWayKMinusOneRefiner : public ARandomlyPartitionedHypergraph {
+ public:
+  AKWayKMinusOneRefiner() {
+    createHypergraph(500, 400, 8);
+  }
+};
+
+TEST_F(AKWayKMinusOneRefiner, ImprovesThePartitionWithBothGainQueues) {
+  HyperedgeID max_degree = 0;
+  for (const HypernodeID& hn : hypergraph->nodes()) {
+    max_degree = std::max(max_degree, hypergraph->nodeDegree(hn));
+  }
+  const HyperedgeWeight initial_km1 = metrics::km1(*hypergraph);
+
+  Metrics metrics = refine<KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch,
+                                                DenseGainCache, HeapGainQueue> >(max_degree);
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  ASSERT_LT(metrics.km1, initial_km1);
+
+  resetPartition();
+  metrics = refine<KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch,
+                                        DenseGainCache, BucketGainQueue> >(max_degree);
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  ASSERT_LT(metrics.km1, initial_km1);
+}
+
+TEST_F(AKWayKMinusOneRefiner, ComputesTheSamePartitionWithParallelGainCacheInitialization) {
+  const HypernodeID num_hypernodes = 4 * kMinNodesPerGainCacheInitThread;
+  createHypergraph(num_hypernodes, 4 * num_hypernodes / 5, 8);
+
+  config.local_search.num_threads = 1;
+  Metrics metrics = refine<KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch> >();
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  const std::vector<PartitionID> sequential_partition = partition();
+
+  resetPartition();
+  config.local_search.num_threads = 4;
+  metrics = refine<KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch> >();
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  ASSERT_THAT(partition(), ContainerEq(sequential_partition));
+}
 }  // namespace kahypar
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2015 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/kway_fm_cut_refiner.h"
+#include "kahypar/partition/refinement/kway_fm_gain_cache.h"
+#include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/kway_fm_sparse_gain_cache.h"
+#include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+#include "tests/partition/refinement/refiner_test_fixtures.h"
+
+using::testing::Test;
+using::testing::Eq;
+using::testing::ContainerEq;
+
+namespace kahypar {
+template <typename Cache>
+std::vector<PartitionID> adjacentParts(const Cache& cache, const HypernodeID hn) {
+  std::vector<PartitionID> parts;
+  for (const PartitionID part : cache.adjacentParts(hn)) {
+    parts.push_back(part);
+  }
+  return parts;
+}
+
+class ASparseGainCache : public Test {
+ public:
+  ASparseGainCache() :
+    dense(kNumHNs, kK),
+    sparse(kNumHNs, kK) { }
+
+  void verifyEquivalence() {
+    for (HypernodeID hn = 0; hn < kNumHNs; ++hn) {
+      ASSERT_THAT(adjacentParts(sparse, hn), ContainerEq(adjacentParts(dense, hn)));
+      for (PartitionID part = 0; part < kK; ++part) {
+        ASSERT_THAT(sparse.entryExists(hn, part), Eq(dense.entryExists(hn, part)));
+        ASSERT_THAT(sparse.entry(hn, part), Eq(dense.entry(hn, part)));
+      }
+    }
+  }
+
+  static constexpr HypernodeID kNumHNs = 20;
+  static constexpr PartitionID kK = 16;
+  KwayGainCache<Gain> dense;
+  KwaySparseGainCache<Gain> sparse;
+};
+
+TEST_F(ASparseGainCache, BehavesLikeTheDenseGainCache) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<HypernodeID> node(0, kNumHNs - 1);
+  std::uniform_int_distribution<PartitionID> part(0, kK - 1);
+  std::uniform_int_distribution<Gain> gain(-10, 10);
+
+  for (HypernodeID hn = 0; hn < kNumHNs; ++hn) {
+    for (int i = 0; i < 3; ++i) {
+      const PartitionID p = part(gen);
+      if (!dense.entryExists(hn, p)) {
+        const Gain g = gain(gen);
+        dense.initializeEntry(hn, p, g);
+        sparse.initializeEntry(hn, p, g);
+      }
+    }
+  }
+  verifyEquivalence();
+
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 200; ++i) {
+      const HypernodeID hn = node(gen);
+      const PartitionID p = part(gen);
+      const Gain g = gain(gen);
+      if (dense.entryExists(hn, p)) {
+        if (g % 3 == 0) {
+          dense.removeEntryDueToConnectivityDecrease(hn, p);
+          sparse.removeEntryDueToConnectivityDecrease(hn, p);
+        } else {
+          dense.updateExistingEntry(hn, p, g);
+          sparse.updateExistingEntry(hn, p, g);
+        }
+      } else {
+        dense.addEntryDueToConnectivityIncrease(hn, p, g);
+        sparse.addEntryDueToConnectivityIncrease(hn, p, g);
+      }
+      verifyEquivalence();
+    }
+    if (round % 2 == 0) {
+      dense.rollbackDelta();
+      sparse.rollbackDelta();
+    } else {
+      dense.resetDelta();
+      sparse.resetDelta();
+    }
+    verifyEquivalence();
+  }
+}
+
+TEST_F(ASparseGainCache, GrowsBeyondItsInitialCapacity) {
+  for (PartitionID p = 0; p < kK; ++p) {
+    sparse.addEntryDueToConnectivityIncrease(0, p, p);
+    dense.addEntryDueToConnectivityIncrease(0, p, p);
+  }
+  verifyEquivalence();
+
+  sparse.rollbackDelta();
+  dense.rollbackDelta();
+  verifyEquivalence();
+  ASSERT_THAT(adjacentParts(sparse, 0).size(), Eq(0));
+}
+
+class AKWayKMinusOneRefiner : public ARandomlyPartitionedHypergraph {
+ public:
+  AKWayKMinusOneRefiner() {
+    createHypergraph(500, 400, 8);
+  }
+};
+
+TEST_F(AKWayKMinusOneRefiner, ComputesTheSamePartitionWithBothGainCaches) {
+  Metrics metrics = refine<KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch,
+                                                DenseGainCache> >();
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  const std::vector<PartitionID> dense_partition = partition();
+
+  resetPartition();
+  metrics = refine<KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch, SparseGainCache> >();
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  ASSERT_THAT(partition(), ContainerEq(dense_partition));
+}
+
+class AKWayFMRefiner : public ARandomlyPartitionedHypergraph {
+ public:
+  AKWayFMRefiner() {
+    createHypergraph(500, 400, 8);
+  }
+};
+
+TEST_F(AKWayFMRefiner, ComputesTheSamePartitionWithBothGainCaches) {
+  Metrics metrics = refine<KWayFMRefiner<NumberOfFruitlessMovesStopsSearch, DenseGainCache> >();
+  ASSERT_THAT(metrics.cut, Eq(metrics::hyperedgeCut(*hypergraph)));
+  const std::vector<PartitionID> dense_partition = partition();
+
+  resetPartition();
+  metrics = refine<KWayFMRefiner<NumberOfFruitlessMovesStopsSearch, SparseGainCache> >();
+  ASSERT_THAT(metrics.cut, Eq(metrics::hyperedgeCut(*hypergraph)));
+  ASSERT_THAT(partition(), ContainerEq(dense_partition));
+}
+}  // namespace kahypar
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2015 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/kway_fm_parallel_km1_refiner.h"
+#include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+#include "tests/partition/refinement/refiner_test_fixtures.h"
+
+using::testing::Eq;
+using::testing::Gt;
+using::testing::Le;
+using::testing::Lt;
+
+namespace kahypar {
+using KWayParallelKMinusOneRefinerSimpleStopping =
+        KWayParallelKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch>;
+
+class AKWayParallelKMinusOneRefiner : public ARandomlyPartitionedHypergraph {
+ public:
+  AKWayParallelKMinusOneRefiner() {
+    createHypergraph(1000, 800, 4);
+    config.local_search.fm.max_number_of_fruitless_moves = 50;
+  }
+
+  Metrics refine(const unsigned int num_threads) {
+    config.local_search.num_threads = num_threads;
+    return ARandomlyPartitionedHypergraph::refine<KWayParallelKMinusOneRefinerSimpleStopping>();
+  }
+};
+
+TEST_F(AKWayParallelKMinusOneRefiner, ImprovesTheKMinusOneMetric) {
+  const HyperedgeWeight initial_km1 = metrics::km1(*hypergraph);
+  const Metrics metrics = refine(1);
+
+  ASSERT_THAT(metrics.km1, Lt(initial_km1));
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+}
+
+TEST_F(AKWayParallelKMinusOneRefiner, ImprovesTheKMinusOneMetricUsingSeveralThreads) {
+  const HyperedgeWeight initial_km1 = metrics::km1(*hypergraph);
+  const Metrics metrics = refine(4);
+
+  ASSERT_THAT(metrics.km1, Lt(initial_km1));
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+}
+
+TEST_F(AKWayParallelKMinusOneRefiner, KeepsThePartitionBalancedUsingSeveralThreads) {
+  const Metrics metrics = refine(4);
+
+  ASSERT_THAT(metrics.imbalance, Le(config.partition.epsilon));
+  for (PartitionID part = 0; part < config.partition.k; ++part) {
+    ASSERT_THAT(hypergraph->partWeight(part), Le(config.partition.max_part_weights[0]));
+  }
+}
+
+TEST_F(AKWayParallelKMinusOneRefiner, NeverWorsensTheKMinusOneMetric) {
+  HyperedgeWeight km1 = metrics::km1(*hypergraph);
+  for (int i = 0; i < 5; ++i) {
+    const Metrics metrics = refine(4);
+    ASSERT_THAT(metrics.km1, Le(km1));
+    km1 = metrics.km1;
+  }
+}
+
+TEST_F(AKWayParallelKMinusOneRefiner, ReusesItsWorkerThreadsInSubsequentCalls) {
+  config.local_search.num_threads = 4;
+  KWayParallelKMinusOneRefinerSimpleStopping refiner(*hypergraph, config);
+  Metrics metrics = ARandomlyPartitionedHypergraph::refine(refiner);
+  for (int i = 0; i < 5; ++i) {
+    const HyperedgeWeight km1 = metrics.km1;
+    UncontractionGainChanges changes;
+    refiner.refine(refinement_nodes, { { 0, 0 } }, changes, metrics);
+    ASSERT_THAT(metrics.km1, Le(km1));
+    ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  }
+}
+
+TEST_F(AKWayParallelKMinusOneRefiner, RespectsTheMoveBudget) {
+  config.local_search.num_threads = 4;
+  KWayParallelKMinusOneRefinerSimpleStopping refiner(*hypergraph, config);
+  refiner.setMoveBudget(40);
+  const HyperedgeWeight initial_km1 = metrics::km1(*hypergraph);
+  const Metrics metrics = ARandomlyPartitionedHypergraph::refine(refiner);
+
+  ASSERT_THAT(refiner.numPerformedMoves(), Le(40));
+  ASSERT_THAT(refiner.numPerformedMoves(), Gt(0));
+  ASSERT_THAT(metrics.km1, Lt(initial_km1));
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+}
+}  // namespace kahypar
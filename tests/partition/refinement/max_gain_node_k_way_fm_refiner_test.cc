@@ -174,11 +174,7 @@ TEST_F(AMaxGainNodeKWayFMRefiner, PerformsMovesThatDontLeadToImbalancedPartition
   config.partition.max_part_weights[1] = 0;
 
   refiner.reset(new KWayFMRefinerSimpleStopping(*hypergraph, config));
-#ifdef USE_BUCKET_QUEUE
-  refiner->initialize(100);
-#else
-  refiner->initialize();
-#endif
+  refiner->initialize(0);
 
   double old_imbalance = metrics::imbalance(*hypergraph, config);
   HyperedgeWeight old_cut = metrics::hyperedgeCut(*hypergraph);
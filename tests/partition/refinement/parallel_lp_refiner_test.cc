@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2015 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/parallel_lp_refiner.h"
+#include "tests/partition/refinement/refiner_test_fixtures.h"
+
+using::testing::Eq;
+using::testing::Le;
+using::testing::Lt;
+
+namespace kahypar {
+class AParallelLPRefiner : public ARandomlyPartitionedHypergraph {
+ public:
+  AParallelLPRefiner() {
+    createHypergraph(1000, 800, 4);
+  }
+
+  Metrics refine(const unsigned int num_threads) {
+    config.local_search.num_threads = num_threads;
+    return ARandomlyPartitionedHypergraph::refine<ParallelLPRefiner>();
+  }
+};
+
+TEST_F(AParallelLPRefiner, ImprovesTheCutUsingSeveralThreads) {
+  const HyperedgeWeight initial_cut = metrics::hyperedgeCut(*hypergraph);
+  const Metrics metrics = refine(4);
+
+  ASSERT_THAT(metrics.cut, Lt(initial_cut));
+  ASSERT_THAT(metrics.cut, Eq(metrics::hyperedgeCut(*hypergraph)));
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+}
+
+TEST_F(AParallelLPRefiner, KeepsThePartitionBalancedUsingSeveralThreads) {
+  const Metrics metrics = refine(4);
+
+  ASSERT_THAT(metrics.imbalance, Le(config.partition.epsilon));
+  for (PartitionID part = 0; part < config.partition.k; ++part) {
+    ASSERT_THAT(hypergraph->partWeight(part), Le(config.partition.max_part_weights[0]));
+  }
+}
+
+TEST_F(AParallelLPRefiner, DoesNotWorsenTheKMinusOneMetricIfItIsTheObjective) {
+  createKMinusOneTradeOff();
+  config.partition.mode = Mode::direct_kway;
+  config.partition.objective = Objective::km1;
+  const HyperedgeWeight initial_km1 = metrics::km1(*hypergraph);
+
+  const Metrics metrics = refine(1);
+
+  ASSERT_THAT(metrics.km1, Eq(initial_km1));
+  ASSERT_THAT(hypergraph->partID(0), Eq(0));
+}
+
+TEST_F(AParallelLPRefiner, NeverWorsensTheKMinusOneMetricIfItIsTheObjective) {
+  config.partition.mode = Mode::direct_kway;
+  config.partition.objective = Objective::km1;
+  HyperedgeWeight km1 = metrics::km1(*hypergraph);
+  for (int i = 0; i < 5; ++i) {
+    const Metrics metrics = refine(4);
+    ASSERT_THAT(metrics.km1, Le(km1));
+    km1 = metrics.km1;
+  }
+}
+
+TEST_F(AParallelLPRefiner, MovesNodesThatWorsenTheKMinusOneMetricIfTheCutIsTheObjective) {
+  createKMinusOneTradeOff();
+  config.partition.mode = Mode::direct_kway;
+  config.partition.objective = Objective::cut;
+  const HyperedgeWeight initial_cut = metrics::hyperedgeCut(*hypergraph);
+
+  const Metrics metrics = refine(1);
+
+  ASSERT_THAT(metrics.cut, Eq(initial_cut - 1));
+  ASSERT_THAT(hypergraph->partID(0), Eq(1));
+}
+
+TEST_F(AParallelLPRefiner, ComputesTheSamePartitionIndependentOfTheNumberOfThreadsIfDeterministic) {
+  config.local_search.sclap.deterministic = true;
+  refine(1);
+  const std::vector<PartitionID> sequential_partition = partition();
+
+  resetPartition();
+  refine(4);
+
+  ASSERT_THAT(partition(), Eq(sequential_partition));
+}
+}  // namespace kahypar
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2014 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/kway_fm_km1_refiner.h"
+#include "kahypar/partition/refinement/lp_refiner.h"
+#include "kahypar/partition/refinement/policies/fm_stop_policy.h"
+#include "kahypar/partition/refinement/refinement_scheduler.h"
+#include "tests/partition/refinement/refiner_test_fixtures.h"
+
+using::testing::Test;
+using::testing::Eq;
+using::testing::Lt;
+using::testing::Gt;
+
+namespace kahypar {
+class ARefinementScheduler : public Test {
+ public:
+  ARefinementScheduler() :
+    config(),
+    scheduler(config) {
+    config.partition.time_limit = 100.0;
+    config.partition.deadline = RefinementScheduler::deadlineAfter(config.partition.time_limit);
+    config.local_search.uncontraction_batch_size = 1;
+    scheduler.reset(1000);
+  }
+
+  Configuration config;
+  RefinementScheduler scheduler;
+};
+
+TEST_F(ARefinementScheduler, IsOnlyActiveIfATimeLimitIsGiven) {
+  Configuration unlimited_config;
+  ASSERT_THAT(RefinementScheduler::hasDeadline(unlimited_config), Eq(false));
+  ASSERT_THAT(RefinementScheduler::deadlinePassed(unlimited_config), Eq(false));
+  ASSERT_THAT(RefinementScheduler::hasDeadline(config), Eq(true));
+  ASSERT_THAT(RefinementScheduler::deadlinePassed(config), Eq(false));
+}
+
+TEST_F(ARefinementScheduler, DoesNotLimitMovesBeforeTheTimePerMoveIsKnown) {
+  ASSERT_THAT(scheduler.moveBudget(500), Eq(RefinementScheduler::kUnlimitedMoves));
+}
+
+TEST_F(ARefinementScheduler, DistributesTheRemainingTimeAmongTheLevelsByTheirNodeCount) {
+  scheduler.update(1.0, 1000);
+
+  // The finest level is the last one and gets all of the remaining time.
+  const int finest_level_budget = scheduler.moveBudget(1000);
+  ASSERT_THAT(finest_level_budget, Gt(99000));
+  ASSERT_THAT(finest_level_budget, Lt(100001));
+
+  // 501 levels with 500, ..., 1000 hypernodes remain.
+  const int coarse_level_budget = scheduler.moveBudget(500);
+  ASSERT_THAT(coarse_level_budget, Gt(131));
+  ASSERT_THAT(coarse_level_budget, Lt(134));
+}
+
+TEST_F(ARefinementScheduler, DoesNotAllowMovesOnceTheDeadlineHasPassed) {
+  scheduler.update(1.0, 1000);
+  config.partition.deadline = RefinementScheduler::deadlineAfter(-1.0);
+  ASSERT_THAT(RefinementScheduler::deadlinePassed(config), Eq(true));
+  ASSERT_THAT(scheduler.moveBudget(1000), Eq(0));
+}
+
+TEST_F(ARefinementScheduler, IsBehindScheduleIfTheRemainingLevelsCannotBeRefinedInTime) {
+  ASSERT_THAT(scheduler.isBehindSchedule(500), Eq(false));
+
+  // At 0.01 seconds per level, the 501 levels with 500, ..., 1000 hypernodes need about
+  // 5 seconds.
+  for (uint64_t i = 0; i < RefinementScheduler::kMinObservedLevels; ++i) {
+    scheduler.update(0.01, 10);
+  }
+  ASSERT_THAT(scheduler.isBehindSchedule(500), Eq(false));
+  config.partition.deadline = RefinementScheduler::deadlineAfter(1.0);
+  ASSERT_THAT(scheduler.isBehindSchedule(500), Eq(true));
+
+  // Only the finest level with 1000 hypernodes remains.
+  ASSERT_THAT(scheduler.isBehindSchedule(1000), Eq(false));
+}
+
+class ARefinerWithAMoveBudget : public ARandomlyPartitionedHypergraph {
+ public:
+  ARefinerWithAMoveBudget() {
+    createHypergraph(500, 400, 8);
+  }
+};
+
+TEST_F(ARefinerWithAMoveBudget, DoesNotExceedItsMoveBudget) {
+  KWayKMinusOneRefiner<NumberOfFruitlessMovesStopsSearch> refiner(*hypergraph, config);
+  refiner.setMoveBudget(10);
+  const HyperedgeWeight initial_km1 = metrics::km1(*hypergraph);
+  const Metrics metrics = refine(refiner);
+  ASSERT_THAT(refiner.numPerformedMoves(), Eq(10));
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  ASSERT_LE(metrics.km1, initial_km1);
+}
+
+class ALabelPropagationFallback : public ARandomlyPartitionedHypergraph {
+ public:
+  ALabelPropagationFallback() {
+    createKMinusOneTradeOff();
+    config.partition.mode = Mode::direct_kway;
+    config.partition.objective = Objective::km1;
+  }
+};
+
+TEST_F(ALabelPropagationFallback, RejectsMovesThatIncreaseKMinusOneIfItReplacesAKMinusOneRefiner) {
+  LPRefiner refiner(*hypergraph, config);
+  refiner.rejectKMinusOneIncreasingMoves(true);
+  const HyperedgeWeight initial_km1 = metrics::km1(*hypergraph);
+  const Metrics metrics = refine(refiner);
+  ASSERT_THAT(metrics.km1, Eq(initial_km1));
+  ASSERT_THAT(hypergraph->partID(0), Eq(0));
+}
+
+TEST_F(ALabelPropagationFallback, MovesNodesThatIncreaseKMinusOneByDefault) {
+  LPRefiner refiner(*hypergraph, config);
+  const Metrics metrics = refine(refiner);
+  ASSERT_THAT(metrics.km1, Eq(metrics::km1(*hypergraph)));
+  ASSERT_THAT(hypergraph->partID(0), Eq(1));
+}
+}  // namespace kahypar
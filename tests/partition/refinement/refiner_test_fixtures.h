@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "kahypar/definitions.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/partition/refinement/i_refiner.h"
+#include "kahypar/utils/randomize.h"
+
+using::testing::Test;
+
+namespace kahypar {
+// Random hypergraph with nets of size 2 to 6, whose hypernodes are assigned
+// to the k blocks in a round-robin fashion. All hypernodes are refinement nodes.
+class ARandomlyPartitionedHypergraph : public Test {
+ public:
+  ARandomlyPartitionedHypergraph() :
+    config(),
+    hypergraph(),
+    refinement_nodes() { }
+
+  void createHypergraph(const HypernodeID num_hypernodes, const HyperedgeID num_hyperedges,
+                        const PartitionID k) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<HypernodeID> node(0, num_hypernodes - 1);
+    std::uniform_int_distribution<HypernodeID> size(2, 6);
+
+    HyperedgeIndexVector index_vector = { 0 };
+    HyperedgeVector edge_vector;
+    for (HyperedgeID he = 0; he < num_hyperedges; ++he) {
+      const HypernodeID he_size = size(gen);
+      while (edge_vector.size() < index_vector.back() + he_size) {
+        const HypernodeID pin = node(gen);
+        if (std::find(edge_vector.begin() + index_vector.back(), edge_vector.end(), pin) ==
+            edge_vector.end()) {
+          edge_vector.push_back(pin);
+        }
+      }
+      index_vector.push_back(edge_vector.size());
+    }
+
+    config.partition.k = k;
+    config.partition.epsilon = 0.03;
+    config.partition.total_graph_weight = num_hypernodes;
+    config.partition.perfect_balance_part_weights[0] = ceil(
+      config.partition.total_graph_weight / static_cast<double>(config.partition.k));
+    config.partition.perfect_balance_part_weights[1] =
+      config.partition.perfect_balance_part_weights[0];
+    config.partition.max_part_weights[0] = (1 + config.partition.epsilon)
+                                           * config.partition.perfect_balance_part_weights[0];
+    config.partition.max_part_weights[1] = config.partition.max_part_weights[0];
+
+    hypergraph.reset(new Hypergraph(num_hypernodes, num_hyperedges, index_vector, edge_vector,
+                                    config.partition.k));
+    resetPartition();
+  }
+
+  // Moving hypernode 0 to block 1 removes net 0 from the cut, but adds block 1
+  // to the connectivity sets of nets 1 and 2. Heavy nets 3 to 5 keep all other
+  // hypernodes in their blocks. Replaces the random hypergraph.
+  void createKMinusOneTradeOff() {
+    config.partition.k = 3;
+    config.partition.total_graph_weight = 9;
+    config.partition.perfect_balance_part_weights[0] = 3;
+    config.partition.perfect_balance_part_weights[1] = 3;
+    config.partition.max_part_weights[0] = 5;
+    config.partition.max_part_weights[1] = 5;
+    hypergraph.reset(new Hypergraph(9, 6,
+                                    HyperedgeIndexVector { 0, 2, 5, 8, 10, 12,  /*sentinel*/ 14 },
+                                    HyperedgeVector { 0, 1, 0, 2, 3, 0, 4, 5, 3, 6, 5, 7, 1, 8 },
+                                    config.partition.k));
+    for (const HyperedgeID he : { 3, 4, 5 }) {
+      hypergraph->setEdgeWeight(he, 5);
+    }
+    const std::vector<PartitionID> parts = { 0, 1, 0, 2, 0, 2, 2, 2, 1 };
+    refinement_nodes.clear();
+    for (const HypernodeID& hn : hypergraph->nodes()) {
+      hypergraph->setNodePart(hn, parts[hn]);
+      refinement_nodes.push_back(hn);
+    }
+    hypergraph->initializeNumCutHyperedges();
+  }
+
+  // Refiners may reorder the refinement nodes, so they are restored as well.
+  void resetPartition() {
+    hypergraph->resetPartitioning();
+    refinement_nodes.clear();
+    for (const HypernodeID& hn : hypergraph->nodes()) {
+      hypergraph->setNodePart(hn, hn % config.partition.k);
+      refinement_nodes.push_back(hn);
+    }
+    hypergraph->initializeNumCutHyperedges();
+  }
+
+  // Performs one refine() call on all hypernodes and returns the resulting metrics.
+  Metrics refine(IRefiner& refiner, const HyperedgeWeight max_gain = 0) {
+    refiner.initialize(max_gain);
+    Metrics metrics = { metrics::hyperedgeCut(*hypergraph), metrics::km1(*hypergraph),
+                        metrics::imbalance(*hypergraph, config) };
+    UncontractionGainChanges changes;
+    refiner.refine(refinement_nodes, { { 0, 0 } }, changes, metrics);
+    return metrics;
+  }
+
+  template <class Refiner>
+  Metrics refine(const HyperedgeWeight max_gain = 0) {
+    Randomize::instance().setSeed(42);
+    Refiner refiner(*hypergraph, config);
+    return refine(refiner, max_gain);
+  }
+
+  std::vector<PartitionID> partition() const {
+    std::vector<PartitionID> parts;
+    for (const HypernodeID& hn : hypergraph->nodes()) {
+      parts.push_back(hypergraph->partID(hn));
+    }
+    return parts;
+  }
+
+  Configuration config;
+  std::unique_ptr<Hypergraph> hypergraph;
+  std::vector<HypernodeID> refinement_nodes;
+};
+}  // namespace kahypar
@@ -179,6 +179,20 @@ TEST_F(ATwoWayFMRefiner, RollsBackAllNodeMovementsIfCutCouldNotBeImproved) {
   ASSERT_THAT(hypergraph->partID(5), Eq(1));
 }
 
+TEST_F(ATwoWayFMRefiner, KeepsUncontractionPairsOfABatchIntact) {
+  Metrics old_metrics = { metrics::hyperedgeCut(*hypergraph),
+                          metrics::km1(*hypergraph),
+                          metrics::imbalance(*hypergraph, config) };
+  std::vector<HypernodeID> refinement_nodes = { 6, 1, 6, 5 };
+  changes.representative.assign(2, 0);
+  changes.contraction_partner.assign(2, 0);
+
+  refiner->initialize(100);
+  refiner->refine(refinement_nodes, { 42, 42 }, changes, old_metrics);
+
+  ASSERT_THAT(refinement_nodes, Eq(std::vector<HypernodeID>({ 6, 1, 6, 5 })));
+}
+
 // Ugly: We could seriously need Mocks here!
 TEST_F(AGainUpdateMethod, RespectsPositiveGainUpdateSpecialCaseForHyperedgesOfSize2) {
   Hypergraph hypergraph(2, 1, HyperedgeIndexVector { 0, 2 }, HyperedgeVector { 0, 1 });
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2016 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+// Runs each greedy hypergraph growing initial partitioner on the input hypergraph
+// with binary heaps and with bucket queues and reports the running time and
+// solution quality of both backends (--i-gain-queue).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/utils/randomize.h"
+
+using namespace kahypar;
+
+static inline void setupConfiguration(Configuration& config, const Hypergraph& hypergraph,
+                                      const PartitionID k) {
+  config.partition.k = k;
+  config.partition.epsilon = 0.03;
+  config.partition.total_graph_weight = hypergraph.totalWeight();
+  config.initial_partitioning.k = k;
+  config.initial_partitioning.epsilon = config.partition.epsilon;
+  config.initial_partitioning.unassigned_part = 1;
+  config.initial_partitioning.nruns = 1;
+  config.initial_partitioning.refinement = false;
+  config.initial_partitioning.perfect_balance_partition_weight.assign(
+    k, ceil(hypergraph.totalWeight() / static_cast<double>(k)));
+  config.initial_partitioning.upper_allowed_partition_weight.assign(
+    k, config.initial_partitioning.perfect_balance_partition_weight[0]
+    * (1.0 + config.partition.epsilon));
+  config.partition.perfect_balance_part_weights[0] =
+    config.initial_partitioning.perfect_balance_partition_weight[0];
+  config.partition.perfect_balance_part_weights[1] =
+    config.initial_partitioning.perfect_balance_partition_weight[0];
+  config.partition.max_part_weights[0] =
+    config.initial_partitioning.upper_allowed_partition_weight[0];
+  config.partition.max_part_weights[1] =
+    config.initial_partitioning.upper_allowed_partition_weight[0];
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cout << "Usage: GreedyIPGainQueueBenchmark <.hgr> <k> [repetitions]" << std::endl;
+    exit(0);
+  }
+  const std::string hgr_filename(argv[1]);
+  const PartitionID k = std::atoi(argv[2]);
+  const int repetitions = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 5;
+
+  Hypergraph hypergraph(io::createHypergraphFromFile(hgr_filename, k));
+
+  for (const InitialPartitionerAlgorithm algo : { InitialPartitionerAlgorithm::greedy_sequential,
+                                                  InitialPartitionerAlgorithm::greedy_global,
+                                                  InitialPartitionerAlgorithm::greedy_round,
+                                                  InitialPartitionerAlgorithm::greedy_sequential_maxpin,
+                                                  InitialPartitionerAlgorithm::greedy_global_maxpin,
+                                                  InitialPartitionerAlgorithm::greedy_round_maxpin,
+                                                  InitialPartitionerAlgorithm::greedy_sequential_maxnet,
+                                                  InitialPartitionerAlgorithm::greedy_global_maxnet,
+                                                  InitialPartitionerAlgorithm::greedy_round_maxnet }) {
+    for (const GainQueueType gain_queue : { GainQueueType::heap, GainQueueType::bucket }) {
+      Configuration config;
+      setupConfiguration(config, hypergraph, k);
+      config.initial_partitioning.algo = algo;
+      config.initial_partitioning.gain_queue = gain_queue;
+
+      double time = 0.0;
+      double cut = 0.0;
+      double km1 = 0.0;
+      double imbalance = 0.0;
+      for (int seed = 1; seed <= repetitions; ++seed) {
+        Randomize::instance().setSeed(seed);
+        hypergraph.resetPartitioning();
+        std::unique_ptr<IInitialPartitioner> partitioner(
+          InitialPartitioningFactory::getInstance().createObject(algo, hypergraph, config));
+
+        const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+        partitioner->partition(hypergraph, config);
+        const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+
+        time += std::chrono::duration<double>(end - start).count();
+        cut += metrics::hyperedgeCut(hypergraph);
+        km1 += metrics::km1(hypergraph);
+        imbalance += metrics::imbalance(hypergraph, config);
+      }
+
+      std::cout << "algo=" << toString(algo)
+                << " gain_queue=" << toString(gain_queue)
+                << " time=" << time / repetitions
+                << " cut=" << cut / repetitions
+                << " km1=" << km1 / repetitions
+                << " imbalance=" << imbalance / repetitions << std::endl;
+    }
+  }
+  return 0;
+}
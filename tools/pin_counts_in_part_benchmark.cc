@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2017 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+// Compares memory consumption and access time of the dense and the compact layout
+// of the pin counts in part for a synthetic hypergraph in which 1% of the hyperedges
+// are large. Each operation increments or reads the counter of a random hyperedge
+// and block.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "kahypar/datastructure/pin_counts_in_part.h"
+#include "kahypar/definitions.h"
+
+using namespace kahypar;
+
+using PinCounts = ds::PinCountsInPart<HypernodeID, HyperedgeID, PartitionID>;
+
+struct Operation {
+  HyperedgeID he;
+  PartitionID part;
+  bool increment;
+};
+
+static inline double run(PinCounts& pin_counts, const std::vector<Operation>& operations,
+                         const std::vector<HypernodeID>& edge_sizes, HypernodeID& checksum) {
+  const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+  for (const Operation& op : operations) {
+    if (op.increment && pin_counts.get(op.he, op.part) < edge_sizes[op.he]) {
+      checksum += pin_counts.increment(op.he, op.part);
+    } else {
+      checksum += pin_counts.get(op.he, op.part);
+    }
+  }
+  const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char* argv[]) {
+  const HyperedgeID num_hyperedges = argc > 1 ? std::atoi(argv[1]) : 200000;
+  const size_t num_operations = argc > 2 ? std::atoll(argv[2]) : 20000000;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<HypernodeID> small_size(2, 20);
+  std::uniform_int_distribution<HypernodeID> large_size(300, 2300);
+  std::uniform_real_distribution<double> coin(0.0, 1.0);
+  std::vector<HypernodeID> edge_sizes(num_hyperedges);
+  for (HypernodeID& size : edge_sizes) {
+    size = coin(gen) < 0.01 ? large_size(gen) : small_size(gen);
+  }
+
+  for (const PartitionID k : { 2, 32, 128, 256, 1024 }) {
+    std::uniform_int_distribution<HyperedgeID> he(0, num_hyperedges - 1);
+    std::uniform_int_distribution<PartitionID> part(0, k - 1);
+    std::vector<Operation> operations(num_operations);
+    for (Operation& op : operations) {
+      op = { he(gen), part(gen), coin(gen) < 0.5 };
+    }
+
+    for (const bool compact : { false, true }) {
+      PinCounts pin_counts;
+      pin_counts.initialize(num_hyperedges, k, [&](const HyperedgeID e) {
+          return edge_sizes[e];
+        }, compact);
+      HypernodeID checksum = 0;
+      const double time = run(pin_counts, operations, edge_sizes, checksum);
+      std::cout << "k=" << k
+                << " layout=" << (compact ? "compact" : "dense")
+                << " size_mb=" << pin_counts.sizeInBytes() / 1000000.0
+                << " time_ms=" << time
+                << " checksum=" << checksum << std::endl;
+    }
+  }
+  return 0;
+}
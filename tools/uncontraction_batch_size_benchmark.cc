@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2016 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+// Partitions a hypergraph once for each given uncontraction batch size and
+// reports running time and solution quality, i.e. the time-vs-cut trade-off
+// of --r-uncontraction-batch-size.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/utils/randomize.h"
+
+using namespace kahypar;
+
+static inline void setupConfiguration(Configuration& config, const std::string& hgr_filename,
+                                      const PartitionID k) {
+  config.partition.mode = Mode::recursive_bisection;
+  config.partition.objective = Objective::cut;
+  config.partition.k = k;
+  config.partition.epsilon = 0.03;
+  config.partition.seed = 1;
+  config.partition.graph_filename = hgr_filename;
+  config.coarsening.algorithm = CoarseningAlgorithm::heavy_lazy;
+  config.coarsening.max_allowed_weight_multiplier = 3.25;
+  config.coarsening.contraction_limit_multiplier = 160;
+  config.initial_partitioning.mode = Mode::direct_kway;
+  config.initial_partitioning.technique = InitialPartitioningTechnique::flat;
+  config.initial_partitioning.algo = InitialPartitionerAlgorithm::pool;
+  config.initial_partitioning.nruns = 20;
+  config.initial_partitioning.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+  config.initial_partitioning.local_search.iterations_per_level = std::numeric_limits<int>::max();
+  config.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+  config.local_search.iterations_per_level = std::numeric_limits<int>::max();
+  config.local_search.fm.stopping_rule = RefinementStoppingRule::simple;
+  config.local_search.fm.max_number_of_fruitless_moves = 50;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cout << "Usage: UncontractionBatchSizeBenchmark <.hgr> <k> [batch sizes...]" << std::endl;
+    exit(0);
+  }
+  const std::string hgr_filename(argv[1]);
+  const PartitionID k = std::atoi(argv[2]);
+
+  std::vector<HypernodeID> batch_sizes;
+  for (int i = 3; i < argc; ++i) {
+    batch_sizes.push_back(std::max(std::atoi(argv[i]), 1));
+  }
+  if (batch_sizes.empty()) {
+    batch_sizes = { 1, 2, 4, 8, 16, 32 };
+  }
+
+  for (const HypernodeID batch_size : batch_sizes) {
+    Configuration config;
+    setupConfiguration(config, hgr_filename, k);
+    config.local_search.uncontraction_batch_size = batch_size;
+    Randomize::instance().setSeed(config.partition.seed);
+
+    Hypergraph hypergraph(io::createHypergraphFromFile(hgr_filename, k));
+
+    Partitioner partitioner;
+    const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+    partitioner.partition(hypergraph, config);
+    const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double> elapsed_seconds = end - start;
+
+    std::cout << "batch_size=" << batch_size
+              << " time=" << elapsed_seconds.count()
+              << " cut=" << metrics::hyperedgeCut(hypergraph)
+              << " km1=" << metrics::km1(hypergraph)
+              << " imbalance=" << metrics::imbalance(hypergraph, config) << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * This file is part of KaHyPar.
+ *
+ * Copyright (C) 2016 Sebastian Schlag <sebastian.schlag@kit.edu>
+ *
+ * KaHyPar is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * KaHyPar is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with KaHyPar.  If not, see <http://www.gnu.org/licenses/>.
+ *
+******************************************************************************/
+
+// Partitions a hypergraph with the heavy_full and heavy_lazy coarseners, each with
+// the binary heap and with the quantized bucket queue as rating priority queue, and
+// reports coarsening time, total time and solution quality of each variant.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "kahypar/definitions.h"
+#include "kahypar/io/hypergraph_io.h"
+#include "kahypar/kahypar.h"
+#include "kahypar/partition/configuration.h"
+#include "kahypar/partition/metrics.h"
+#include "kahypar/utils/randomize.h"
+#include "kahypar/utils/stats.h"
+
+using namespace kahypar;
+
+static inline void setupConfiguration(Configuration& config, const std::string& hgr_filename,
+                                      const PartitionID k, const int seed) {
+  config.partition.mode = Mode::recursive_bisection;
+  config.partition.objective = Objective::cut;
+  config.partition.k = k;
+  config.partition.epsilon = 0.03;
+  config.partition.seed = seed;
+  config.partition.graph_filename = hgr_filename;
+  config.coarsening.max_allowed_weight_multiplier = 3.25;
+  config.coarsening.contraction_limit_multiplier = 160;
+  config.initial_partitioning.mode = Mode::direct_kway;
+  config.initial_partitioning.technique = InitialPartitioningTechnique::flat;
+  config.initial_partitioning.algo = InitialPartitionerAlgorithm::pool;
+  config.initial_partitioning.nruns = 20;
+  config.initial_partitioning.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+  config.initial_partitioning.local_search.iterations_per_level = std::numeric_limits<int>::max();
+  config.local_search.algorithm = RefinementAlgorithm::twoway_fm;
+  config.local_search.iterations_per_level = std::numeric_limits<int>::max();
+  config.local_search.fm.stopping_rule = RefinementStoppingRule::simple;
+  config.local_search.fm.max_number_of_fruitless_moves = 350;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cout << "Usage: VertexPairCoarsenerBenchmark <.hgr> <k> [repetitions]" << std::endl;
+    exit(0);
+  }
+  const std::string hgr_filename(argv[1]);
+  const PartitionID k = std::atoi(argv[2]);
+  const int repetitions = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 3;
+
+  for (const CoarseningAlgorithm algo : { CoarseningAlgorithm::heavy_full,
+                                          CoarseningAlgorithm::heavy_full_bucket,
+                                          CoarseningAlgorithm::heavy_lazy,
+                                          CoarseningAlgorithm::heavy_lazy_bucket }) {
+    double coarsening_time = 0.0;
+    double time = 0.0;
+    double cut = 0.0;
+    double imbalance = 0.0;
+    for (int seed = 1; seed <= repetitions; ++seed) {
+      Configuration config;
+      setupConfiguration(config, hgr_filename, k, seed);
+      config.coarsening.algorithm = algo;
+      Randomize::instance().setSeed(config.partition.seed);
+
+      Hypergraph hypergraph(io::createHypergraphFromFile(hgr_filename, k));
+
+      // The partitioner accumulates the coarsening time of all bisections.
+      const double coarsening_time_before = Stats::instance().get("Coarsening");
+      Partitioner partitioner;
+      const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+      partitioner.partition(hypergraph, config);
+      const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+
+      coarsening_time += Stats::instance().get("Coarsening") - coarsening_time_before;
+      time += std::chrono::duration<double>(end - start).count();
+      cut += metrics::hyperedgeCut(hypergraph);
+      imbalance += metrics::imbalance(hypergraph, config);
+    }
+
+    std::cout << "coarsener=" << toString(algo)
+              << " coarsening_time=" << coarsening_time / repetitions
+              << " time=" << time / repetitions
+              << " cut=" << cut / repetitions
+              << " imbalance=" << imbalance / repetitions << std::endl;
+  }
+  return 0;
+}